@@ -0,0 +1,408 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  ____  _                _                      
+// |  _ \| |              | |                     
+// | |_) | | ___ _ __   __| |     ___ _ __  _ __  
+// |  _ <| |/ _ \ '_ \ / _` |    / __| '_ \| '_ \ 
+// | |_) | |  __/ | | | (_| | _ | (__| |_) | |_) |
+// |____/|_|\___|_| |_|\__,_|(_) \___| .__/| .__/ 
+//                                   | |   | |    
+//                                   |_|   |_|    
+//
+// Frame buffer blend operations
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// Each blend mode has a scalar routine and (with USE_SSE2) a packed-byte routine that does four pixels at a time.  The scalar
+// routines handle whatever is left over at the end of a span, so they must produce exactly the same results as the SSE2 ones.
+//
+// The scalar routines work on two channels at once where they can (red & blue, then alpha & green) by spreading them into 16-bit
+// lanes of a 32-bit register.
+//
+// Shading is built from the same pieces: the interpolated colors for the span are expanded into pixels, multiplied into the texels
+// (BLEND_MULTIPLY) and the specular is added on top (BLEND_ADD_SATURATE.)
+//
+// Divides by 255 are done as (x + (x >> 8)) >> 8, with x rounded first (x + 128).  This is exact for the products of two bytes and
+// fits in 16 bits, so the SSE2 routines can use 16-bit lanes.
+//
+// The 16-bit (5-6-5) routines work the same way on eight pixels at a time, with each channel in its own 16-bit lane.  5-6-5 has no
+// alpha, so BLEND_ALPHA is a color key: source pixels of 0 are transparent, everything else is opaque.  Multiplies scale by
+// (s + 1) and shift, rather than dividing by 31 (or 63), which keeps full intensity exact.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Scalar routines
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	unsigned int	div255(unsigned int x)
+{
+	x += 0x80;
+	return (x + (x >> 8)) >> 8;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	unsigned int	addSaturate(const unsigned int d, const unsigned int s)
+{
+	// Red & blue, then alpha & green, each with a carry bit above it
+
+	unsigned int	rb = (d & 0x00ff00ff) + (s & 0x00ff00ff);
+	unsigned int	ag = ((d >> 8) & 0x00ff00ff) + ((s >> 8) & 0x00ff00ff);
+
+	// Any channel that carried becomes 0xff
+
+	unsigned int	rbCarry = rb & 0x01000100;
+	unsigned int	agCarry = ag & 0x01000100;
+	rb = (rb | (rbCarry - (rbCarry >> 8))) & 0x00ff00ff;
+	ag = (ag | (agCarry - (agCarry >> 8))) & 0x00ff00ff;
+
+	return rb | (ag << 8);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	unsigned int	alphaBlend(const unsigned int d, const unsigned int s)
+{
+	unsigned int	a = s >> 24;
+	unsigned int	ia = 255 - a;
+
+	unsigned int	rb = (s & 0x00ff00ff) * a + (d & 0x00ff00ff) * ia + 0x00800080;
+	unsigned int	ag = ((s >> 8) & 0x00ff00ff) * a + ((d >> 8) & 0x00ff00ff) * ia + 0x00800080;
+	rb = ((rb + ((rb >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+	ag = ((ag + ((ag >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+
+	return rb | (ag << 8);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	unsigned int	multiply(const unsigned int d, const unsigned int s)
+{
+	return	(div255((d >> 24)        * (s >> 24))        << 24) |
+		(div255(((d >> 16) & 0xff) * ((s >> 16) & 0xff)) << 16) |
+		(div255(((d >>  8) & 0xff) * ((s >>  8) & 0xff)) <<  8) |
+		(div255(( d        & 0xff) * ( s        & 0xff))      );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// SSE2 routines (four pixels at a time)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef USE_SSE2
+
+static	inline	__m128i	div255x8(__m128i x)
+{
+	x = _mm_add_epi16(x, _mm_set1_epi16(0x80));
+	return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	__m128i	alphaBlend2(const __m128i d, const __m128i s)
+{
+	// Two pixels, one channel per 16-bit lane; the alpha of each pixel is copied to all four of its lanes
+
+	__m128i	a  = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3,3,3,3)), _MM_SHUFFLE(3,3,3,3));
+	__m128i	ia = _mm_sub_epi16(_mm_set1_epi16(0xff), a);
+	__m128i	x  = _mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, ia));
+	return div255x8(x);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	blendSSE2(unsigned int *dst, const unsigned int *src, const int count, const BlendMode mode)
+{
+	__m128i		zero = _mm_setzero_si128();
+	__m128i		*d = (__m128i *) dst;
+	const	__m128i	*s = (const __m128i *) src;
+	int		i;
+
+	switch(mode)
+	{
+		case BLEND_ADD:
+			for (i = 0; i < count; i++, d++, s++)
+			{
+				_mm_storeu_si128(d, _mm_add_epi32(_mm_loadu_si128(d), _mm_loadu_si128(s)));
+			}
+			break;
+
+		case BLEND_ADD_SATURATE:
+			for (i = 0; i < count; i++, d++, s++)
+			{
+				_mm_storeu_si128(d, _mm_adds_epu8(_mm_loadu_si128(d), _mm_loadu_si128(s)));
+			}
+			break;
+
+		case BLEND_ALPHA:
+			for (i = 0; i < count; i++, d++, s++)
+			{
+				__m128i	dv = _mm_loadu_si128(d);
+				__m128i	sv = _mm_loadu_si128(s);
+				__m128i	lo = alphaBlend2(_mm_unpacklo_epi8(dv, zero), _mm_unpacklo_epi8(sv, zero));
+				__m128i	hi = alphaBlend2(_mm_unpackhi_epi8(dv, zero), _mm_unpackhi_epi8(sv, zero));
+				_mm_storeu_si128(d, _mm_packus_epi16(lo, hi));
+			}
+			break;
+
+		case BLEND_MULTIPLY:
+			for (i = 0; i < count; i++, d++, s++)
+			{
+				__m128i	dv = _mm_loadu_si128(d);
+				__m128i	sv = _mm_loadu_si128(s);
+				__m128i	lo = div255x8(_mm_mullo_epi16(_mm_unpacklo_epi8(dv, zero), _mm_unpacklo_epi8(sv, zero)));
+				__m128i	hi = div255x8(_mm_mullo_epi16(_mm_unpackhi_epi8(dv, zero), _mm_unpackhi_epi8(sv, zero)));
+				_mm_storeu_si128(d, _mm_packus_epi16(lo, hi));
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Blends 'len' source pixels into the destination
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	blendSpan(unsigned int *dst, const unsigned int *src, const int len, const BlendMode mode)
+{
+	if (mode == BLEND_REPLACE)
+	{
+		memcpy(dst, src, len * sizeof(unsigned int));
+		return;
+	}
+
+	int	i = 0;
+
+	#ifdef USE_SSE2
+	blendSSE2(dst, src, len >> 2, mode);
+	i = len & ~3;
+	#endif
+
+	switch(mode)
+	{
+		case BLEND_ADD:
+			for (; i < len; i++) dst[i] += src[i];
+			break;
+
+		case BLEND_ADD_SATURATE:
+			for (; i < len; i++) dst[i] = addSaturate(dst[i], src[i]);
+			break;
+
+		case BLEND_ALPHA:
+			for (; i < len; i++) dst[i] = alphaBlend(dst[i], src[i]);
+			break;
+
+		case BLEND_MULTIPLY:
+			for (; i < len; i++) dst[i] = multiply(dst[i], src[i]);
+			break;
+
+		default:
+			break;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// 16-bit (5-6-5) scalar routines
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	unsigned short	addSaturate565(const unsigned short d, const unsigned short s)
+{
+	unsigned int	r = (d >> 11) + (s >> 11);
+	unsigned int	g = ((d >> 5) & 0x3f) + ((s >> 5) & 0x3f);
+	unsigned int	b = (d & 0x1f) + (s & 0x1f);
+	if (r > 0x1f) r = 0x1f;
+	if (g > 0x3f) g = 0x3f;
+	if (b > 0x1f) b = 0x1f;
+	return (unsigned short) ((r << 11) | (g << 5) | b);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	unsigned short	multiply565(const unsigned short d, const unsigned short s)
+{
+	unsigned int	r = ((d >> 11) * ((s >> 11) + 1)) >> 5;
+	unsigned int	g = (((d >> 5) & 0x3f) * (((s >> 5) & 0x3f) + 1)) >> 6;
+	unsigned int	b = ((d & 0x1f) * ((s & 0x1f) + 1)) >> 5;
+	return (unsigned short) ((r << 11) | (g << 5) | b);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// 16-bit (5-6-5) SSE2 routines (eight pixels at a time)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef USE_SSE2
+
+static	void	blend16SSE2(unsigned short *dst, const unsigned short *src, const int count, const BlendMode mode)
+{
+	__m128i		zero = _mm_setzero_si128();
+	__m128i		mask5 = _mm_set1_epi16(0x1f);
+	__m128i		mask6 = _mm_set1_epi16(0x3f);
+	__m128i		one = _mm_set1_epi16(1);
+	__m128i		*d = (__m128i *) dst;
+	const	__m128i	*s = (const __m128i *) src;
+	int		i;
+
+	switch(mode)
+	{
+		case BLEND_ADD:
+			for (i = 0; i < count; i++, d++, s++)
+			{
+				_mm_storeu_si128(d, _mm_add_epi16(_mm_loadu_si128(d), _mm_loadu_si128(s)));
+			}
+			break;
+
+		case BLEND_ADD_SATURATE:
+			for (i = 0; i < count; i++, d++, s++)
+			{
+				__m128i	dv = _mm_loadu_si128(d);
+				__m128i	sv = _mm_loadu_si128(s);
+				__m128i	r = _mm_min_epi16(_mm_add_epi16(_mm_srli_epi16(dv, 11), _mm_srli_epi16(sv, 11)), mask5);
+				__m128i	g = _mm_min_epi16(_mm_add_epi16(_mm_and_si128(_mm_srli_epi16(dv, 5), mask6), _mm_and_si128(_mm_srli_epi16(sv, 5), mask6)), mask6);
+				__m128i	b = _mm_min_epi16(_mm_add_epi16(_mm_and_si128(dv, mask5), _mm_and_si128(sv, mask5)), mask5);
+				_mm_storeu_si128(d, _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b));
+			}
+			break;
+
+		case BLEND_ALPHA:
+			for (i = 0; i < count; i++, d++, s++)
+			{
+				__m128i	dv = _mm_loadu_si128(d);
+				__m128i	sv = _mm_loadu_si128(s);
+				__m128i	transparent = _mm_cmpeq_epi16(sv, zero);
+				_mm_storeu_si128(d, _mm_or_si128(_mm_and_si128(transparent, dv), sv));
+			}
+			break;
+
+		case BLEND_MULTIPLY:
+			for (i = 0; i < count; i++, d++, s++)
+			{
+				__m128i	dv = _mm_loadu_si128(d);
+				__m128i	sv = _mm_loadu_si128(s);
+				__m128i	r = _mm_srli_epi16(_mm_mullo_epi16(_mm_srli_epi16(dv, 11), _mm_add_epi16(_mm_srli_epi16(sv, 11), one)), 5);
+				__m128i	g = _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(dv, 5), mask6), _mm_add_epi16(_mm_and_si128(_mm_srli_epi16(sv, 5), mask6), one)), 6);
+				__m128i	b = _mm_srli_epi16(_mm_mullo_epi16(_mm_and_si128(dv, mask5), _mm_add_epi16(_mm_and_si128(sv, mask5), one)), 5);
+				_mm_storeu_si128(d, _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b));
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Blends 'len' 16-bit (5-6-5) source pixels into the destination
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	blendSpan16(unsigned short *dst, const unsigned short *src, const int len, const BlendMode mode)
+{
+	if (mode == BLEND_REPLACE)
+	{
+		memcpy(dst, src, len * sizeof(unsigned short));
+		return;
+	}
+
+	int	i = 0;
+
+	#ifdef USE_SSE2
+	blend16SSE2(dst, src, len >> 3, mode);
+	i = len & ~7;
+	#endif
+
+	switch(mode)
+	{
+		case BLEND_ADD:
+			for (; i < len; i++) dst[i] += src[i];
+			break;
+
+		case BLEND_ADD_SATURATE:
+			for (; i < len; i++) dst[i] = addSaturate565(dst[i], src[i]);
+			break;
+
+		case BLEND_ALPHA:
+			for (; i < len; i++) if (src[i] != rgb565Transparent) dst[i] = src[i];
+			break;
+
+		case BLEND_MULTIPLY:
+			for (; i < len; i++) dst[i] = multiply565(dst[i], src[i]);
+			break;
+
+		default:
+			break;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Modulates 'len' texels (up to blendChunk) by the interpolated color, then adds the specular.  The interpolants are stepped past
+// the span.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	unsigned int	clampShade(const int x)
+{
+	if (x < 0) return 0;
+	if (x > 0xff0000) return 0xff;
+	return x >> 16;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	shadeSpan(unsigned int *texels, const int len, sSHADE &shade)
+{
+	unsigned int	colors[blendChunk];
+	int		i;
+
+	for (i = 0; i < len; i++)
+	{
+		colors[i] = 0xff000000 | (clampShade(shade.r) << 16) | (clampShade(shade.g) << 8) | clampShade(shade.b);
+		shade.r += shade.dr;
+		shade.g += shade.dg;
+		shade.b += shade.db;
+	}
+
+	blendSpan(texels, colors, len, BLEND_MULTIPLY);
+
+	#ifdef USE_SPECULAR
+	for (i = 0; i < len; i++)
+	{
+		colors[i] = clampShade(shade.s) * 0x010101;
+		shade.s += shade.ds;
+	}
+
+	blendSpan(texels, colors, len, BLEND_ADD_SATURATE);
+	#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Blend.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
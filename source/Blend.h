@@ -0,0 +1,71 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  ____  _                _     _     
+// |  _ \| |              | |   | |    
+// | |_) | | ___ _ __   __| |   | |__  
+// |  _ <| |/ _ \ '_ \ / _` |   | '_ \ 
+// | |_) | |  __/ | | | (_| | _ | | | |
+// |____/|_|\___|_| |_|\__,_|(_)|_| |_|
+//                                     
+//                                     
+//
+// Frame buffer blend operations
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_BLEND
+#define	_H_BLEND
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Blend modes.  BLEND_ADD is the original behavior of the mappers: an unsaturated 32-bit add, which carries from one channel into
+// the next wherever polygons overlap (that's the point -- it makes overlaps easy to spot.)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+enum	BlendMode
+{
+	BLEND_ADD,				// dst += src (carries between channels)
+	BLEND_REPLACE,				// dst = src (never reads the frame buffer)
+	BLEND_ADD_SATURATE,			// dst = min(dst + src, 255) per channel
+	BLEND_ALPHA,				// dst = lerp(dst, src, src alpha)
+	BLEND_MULTIPLY				// dst = dst * src / 255 per channel
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The mappers gather texels into a buffer of (at most) this many pixels before blending them into the frame buffer
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned int	blendChunk = 64;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The shading interpolants for a span (16.16 fixed-point, 0-255)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	shade
+{
+	int	r, dr;
+	int	g, dg;
+	int	b, db;
+	int	s, ds;
+} sSHADE;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	blendSpan(unsigned int *dst, const unsigned int *src, const int len, const BlendMode mode);
+void	blendSpan16(unsigned short *dst, const unsigned short *src, const int len, const BlendMode mode);
+void	shadeSpan(unsigned int *texels, const int len, sSHADE &shade);
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Blend.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,250 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  ____         __  __          _____             _                      
+// |  _ \       / _|/ _|        |  __ \           | |                     
+// | |_) |_   _| |_| |_ ___ _ __| |__) |___   ___ | |     ___ _ __  _ __  
+// |  _ <| | | |  _|  _/ _ \ '__|  ___// _ \ / _ \| |    / __| '_ \| '_ \ 
+// | |_) | |_| | | | ||  __/ |  | |   | (_) | (_) | | _ | (__| |_) | |_) |
+// |____/ \__,_|_| |_| \___|_|  |_|    \___/ \___/|_|(_) \___| .__/| .__/ 
+//                                                           | |   | |    
+//                                                           |_|   |_|    
+//
+// Pooled, aligned frame buffer allocation
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// Frame buffers (and anything else big that gets thrown away & re-created on a resize) come from here.  Requests are rounded up
+// to a power-of-two size class (64K and up) so that a buffer has room to grow, and a freed buffer goes back into a small pool for
+// its class rather than back to the OS.  An interactive resize ends up bouncing between the same few buffers instead of hammering
+// the allocator.
+//
+// Buffers come straight from VirtualAlloc (so they're page aligned) with a poolAlignment-sized header in front, which keeps the
+// buffer itself on a poolAlignment boundary.
+//
+// With USE_LARGE_PAGES, buffers that are at least one large page in size are allocated on large pages, which cuts the TLB misses
+// from walking a big frame buffer.  This needs the "Lock pages in memory" privilege; without it, we quietly fall back to normal
+// pages.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Older SDKs don't know about large pages
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	MEM_LARGE_PAGES
+#define	MEM_LARGE_PAGES	0x20000000
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Size classes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	unsigned int	minClassShift = 16;		// Smallest class is 64K
+static	const	unsigned int	classCount = 15;		// Largest is 64K << 14 (1GB)
+static	const	unsigned int	maxPooledPerClass = 2;		// Idle buffers kept per class
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The header in front of every buffer (padded to poolAlignment)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	poolblock
+{
+	unsigned int	sizeClass;
+	unsigned int	bytes;			// Size of the whole allocation (including this header)
+	bool		largePages;
+	struct	poolblock *next;		// Next idle block in the same class
+} sPOOLBLOCK;
+
+static	const	unsigned int	headerSize = (sizeof(sPOOLBLOCK) + poolAlignment - 1) & ~(poolAlignment - 1);
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	sPOOLBLOCK	*idle[classCount];
+static	unsigned int	idleCount[classCount];
+static	sPOOLSTATS	stats;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Large page support (looked up at run-time, since it's not available on every version of Windows)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef USE_LARGE_PAGES
+static	unsigned int	largePageSize()
+{
+	static	bool		initialized = false;
+	static	unsigned int	size = 0;
+	if (initialized) return size;
+	initialized = true;
+
+	// How big is a large page?
+
+	typedef	SIZE_T	(WINAPI *GETLARGEPAGEMINIMUM)();
+	GETLARGEPAGEMINIMUM	getLargePageMinimum = (GETLARGEPAGEMINIMUM) GetProcAddress(GetModuleHandle("kernel32.dll"), "GetLargePageMinimum");
+	if (!getLargePageMinimum) return 0;
+
+	// We need the privilege to lock pages in memory
+
+	HANDLE	token;
+	if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) return 0;
+
+	TOKEN_PRIVILEGES	tp;
+	tp.PrivilegeCount = 1;
+	tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+	bool	enabled = LookupPrivilegeValue(NULL, "SeLockMemoryPrivilege", &tp.Privileges[0].Luid) &&
+			  AdjustTokenPrivileges(token, FALSE, &tp, 0, NULL, NULL) && GetLastError() == ERROR_SUCCESS;
+	CloseHandle(token);
+
+	if (enabled) size = (unsigned int) getLargePageMinimum();
+	return size;
+}
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	sPOOLBLOCK	*systemAlloc(const unsigned int sizeClass)
+{
+	unsigned int	bytes = 1 << (sizeClass + minClassShift);
+	void		*mem = NULL;
+	bool		large = false;
+
+	#ifdef USE_LARGE_PAGES
+	unsigned int	lps = largePageSize();
+	if (lps && bytes >= lps)
+	{
+		bytes = (bytes + lps - 1) & ~(lps - 1);
+		mem = VirtualAlloc(NULL, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+		large = mem != NULL;
+	}
+	#endif
+
+	if (!mem)
+	{
+		bytes = 1 << (sizeClass + minClassShift);
+		mem = VirtualAlloc(NULL, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	}
+
+	if (!mem) return NULL;
+
+	sPOOLBLOCK	*block = (sPOOLBLOCK *) mem;
+	block->sizeClass = sizeClass;
+	block->bytes = bytes;
+	block->largePages = large;
+	block->next = NULL;
+
+	stats.systemAllocations++;
+	if (large) stats.largePageAllocations++;
+	return block;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Allocates a buffer of at least 'bytes' bytes.  If 'capacity' is given, it receives the usable size of the buffer (which may be
+// larger than requested -- it's fine to use all of it.)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	*poolAlloc(const unsigned int bytes, unsigned int *capacity)
+{
+	// Find the size class
+
+	unsigned int	sizeClass = 0;
+	while(sizeClass < classCount && (1u << (sizeClass + minClassShift)) < bytes + headerSize) sizeClass++;
+	if (sizeClass == classCount) return NULL;
+
+	stats.allocations++;
+
+	// Reuse an idle one if we have it
+
+	sPOOLBLOCK	*block = idle[sizeClass];
+	if (block)
+	{
+		idle[sizeClass] = block->next;
+		idleCount[sizeClass]--;
+		stats.pooledBytes -= block->bytes;
+		stats.reused++;
+	}
+	else
+	{
+		block = systemAlloc(sizeClass);
+		if (!block) return NULL;
+	}
+
+	block->next = NULL;
+	stats.liveBytes += block->bytes;
+
+	if (capacity) *capacity = block->bytes - headerSize;
+	return (unsigned char *) block + headerSize;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns a buffer to the pool (or to the OS, if the pool for its size is full)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	poolFree(void *buffer)
+{
+	if (!buffer) return;
+
+	sPOOLBLOCK	*block = (sPOOLBLOCK *) ((unsigned char *) buffer - headerSize);
+	stats.liveBytes -= block->bytes;
+
+	if (idleCount[block->sizeClass] < maxPooledPerClass)
+	{
+		block->next = idle[block->sizeClass];
+		idle[block->sizeClass] = block;
+		idleCount[block->sizeClass]++;
+		stats.pooledBytes += block->bytes;
+		return;
+	}
+
+	VirtualFree(block, 0, MEM_RELEASE);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Releases every idle buffer back to the OS
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	poolTrim()
+{
+	for (unsigned int i = 0; i < classCount; i++)
+	{
+		while(idle[i])
+		{
+			sPOOLBLOCK	*block = idle[i];
+			idle[i] = block->next;
+			VirtualFree(block, 0, MEM_RELEASE);
+		}
+
+		idleCount[i] = 0;
+	}
+
+	stats.pooledBytes = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	sPOOLSTATS &poolStats()
+{
+	return stats;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// BufferPool.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
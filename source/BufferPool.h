@@ -0,0 +1,60 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  ____         __  __          _____             _     _     
+// |  _ \       / _|/ _|        |  __ \           | |   | |    
+// | |_) |_   _| |_| |_ ___ _ __| |__) |___   ___ | |   | |__  
+// |  _ <| | | |  _|  _/ _ \ '__|  ___// _ \ / _ \| |   | '_ \ 
+// | |_) | |_| | | | ||  __/ |  | |   | (_) | (_) | | _ | | | |
+// |____/ \__,_|_| |_| \___|_|  |_|    \___/ \___/|_|(_)|_| |_|
+//                                                             
+//                                                             
+//
+// Pooled, aligned frame buffer allocation
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_BUFFERPOOL
+#define	_H_BUFFERPOOL
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Every buffer from the pool starts on this boundary
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned int	poolAlignment = 64;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Pool statistics
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	poolstats
+{
+	unsigned int	allocations;		// Calls to poolAlloc()
+	unsigned int	reused;			// ...that were satisfied from the pool
+	unsigned int	systemAllocations;	// ...that went to the OS
+	unsigned int	largePageAllocations;	// ...of those, how many got large pages
+	unsigned int	pooledBytes;		// Bytes sitting idle in the pool
+	unsigned int	liveBytes;		// Bytes handed out and not yet freed
+} sPOOLSTATS;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		*poolAlloc(const unsigned int bytes, unsigned int *capacity = NULL);
+void		poolFree(void *buffer);
+void		poolTrim();
+const	sPOOLSTATS &poolStats();
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// BufferPool.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,364 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  ____        _                          
+// |  _ \      | |                         
+// | |_) |_   _| |__       ___ _ __  _ __  
+// |  _ <\ \ / / '_ \     / __| '_ \| '_ \ 
+// | |_) |\ V /| | | | _ | (__| |_) | |_) |
+// |____/  \_/ |_| |_|(_) \___| .__/| .__/ 
+//                            | |   | |    
+//                            |_|   |_|    
+//
+// Bounding volume hierarchies (for culling)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// The tree is built top-down over item boxes: each node's items are split in half at the median of their centers along the
+// longest axis (found with a quickselect, so there's no sorting), until a node has no more than 'leafItems' items.  Median splits
+// keep the tree balanced, so its depth is about log2 of the leaf count, and the nodes live in one array (children in pairs.)
+//
+// Culling walks the tree against a set of planes (a view frustum, usually.)  A node entirely outside any plane is dropped along
+// with everything under it.  A node entirely inside a plane doesn't test that plane again; its children inherit the set of planes
+// it straddles, so most of the tree below the edges of the view costs nothing but the walk.
+//
+// When an item moves, refit() updates its box and re-fits the boxes on the way up to the root, stopping at the first one that
+// doesn't change.  The shape of the tree stays as it was built, so if items move a long way, rebuilding gives tighter boxes.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	unsigned int	bvhMaxStack = 128;		// Twice the deepest a median-split tree of 4G items can get
+static	const	unsigned int	bvhMaxPlanes = 32;		// One bit each, in the culling masks
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Box helpers
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	void	emptyBox(sBVHBOX &box)
+{
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		box.minimum[axis] = 1e30f;
+		box.maximum[axis] = -1e30f;
+	}
+}
+
+static	inline	void	growBox(sBVHBOX &box, const sBVHBOX &other)
+{
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		if (other.minimum[axis] < box.minimum[axis]) box.minimum[axis] = other.minimum[axis];
+		if (other.maximum[axis] > box.maximum[axis]) box.maximum[axis] = other.maximum[axis];
+	}
+}
+
+static	inline	float	boxCenter(const sBVHBOX &box, const unsigned int axis)
+{
+	return box.minimum[axis] + box.maximum[axis];		// Twice the center (only ever compared)
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Tests a box against the planes whose bits are set in 'mask', clearing the bits of the planes it's entirely inside.  Returns false
+// if it's entirely outside any of them.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	bool	boxInside(const sBVHBOX &box, const sBVHPLANE *planes, unsigned int &mask)
+{
+	for (unsigned int i = 0; i < bvhMaxPlanes && (mask >> i); i++)
+	{
+		unsigned int	bit = 1u << i;
+		if (!(mask & bit)) continue;
+
+		// The corners furthest along the normal, and furthest against it
+
+		const	sBVHPLANE	&plane = planes[i];
+		float			furthest = plane.distance, nearest = plane.distance;
+
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			float	lo = plane.normal[axis] * box.minimum[axis];
+			float	hi = plane.normal[axis] * box.maximum[axis];
+			furthest += lo > hi ? lo : hi;
+			nearest  += lo > hi ? hi : lo;
+		}
+
+		if (furthest < 0) return false;
+		if (nearest >= 0) mask &= ~bit;
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		Bvh::Bvh()
+		:_nodes(NULL), _nodeCount(0), _boxes(NULL), _items(NULL), _leaves(NULL), _itemCount(0), _leafItems(1)
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		Bvh::~Bvh()
+{
+	destroy();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Builds the tree over 'count' items with the given boxes, with up to 'leafItems' items in each leaf
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		Bvh::build(const sBVHBOX *boxes, const unsigned int count, const unsigned int leafItems)
+{
+	destroy();
+
+	if (!count) return false;
+
+	_itemCount = count;
+	_leafItems = leafItems ? leafItems : 1;
+	_boxes = new sBVHBOX[count];
+	_items = new unsigned int[count];
+	_leaves = new unsigned int[count];
+	memcpy(_boxes, boxes, count * sizeof(sBVHBOX));
+	for (unsigned int i = 0; i < count; i++) _items[i] = i;
+
+	// A binary tree with N leaves has 2N-1 nodes, and there's never more than one leaf per item
+
+	_nodes = new sBVHNODE[count * 2 - 1];
+	_nodes[0].parent = 0;
+	_nodeCount = 1;
+	split(0, 0, count);
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Bvh::destroy()
+{
+	delete[] _nodes;
+	_nodes = NULL;
+	_nodeCount = 0;
+
+	delete[] _boxes;
+	_boxes = NULL;
+
+	delete[] _items;
+	_items = NULL;
+
+	delete[] _leaves;
+	_leaves = NULL;
+
+	_itemCount = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Gives an item a new box, and re-fits the nodes above it
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Bvh::refit(const unsigned int item, const sBVHBOX &box)
+{
+	_boxes[item] = box;
+
+	for (unsigned int node = _leaves[item];; node = _nodes[node].parent)
+	{
+		sBVHBOX	fitted;
+		fit(node, fitted);
+
+		// If this one didn't change, nothing above it will
+
+		if (!memcmp(&fitted, &_nodes[node].box, sizeof(sBVHBOX))) return;
+
+		_nodes[node].box = fitted;
+		if (!node) return;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Finds the items whose boxes aren't entirely outside any of the planes (there can be up to 32 of them, facing inwards.)  'visible'
+// gets their indices and must have room for every item.  Returns the number found.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int	Bvh::cull(const sBVHPLANE *planes, const unsigned int planeCount, unsigned int *visible) const
+{
+	if (!_nodes || planeCount > bvhMaxPlanes) return 0;
+
+	// Each node on the stack carries the planes its parent straddles
+
+	unsigned int	stackNode[bvhMaxStack];
+	unsigned int	stackMask[bvhMaxStack];
+	unsigned int	depth = 0;
+	unsigned int	count = 0;
+
+	stackNode[depth] = 0;
+	stackMask[depth++] = planeCount == bvhMaxPlanes ? 0xffffffff : (1u << planeCount) - 1;
+
+	while(depth)
+	{
+		depth--;
+		const	sBVHNODE	&node = _nodes[stackNode[depth]];
+		unsigned int		mask = stackMask[depth];
+
+		if (mask && !boxInside(node.box, planes, mask)) continue;
+
+		// A leaf's items are tested one by one (unless the leaf is entirely inside)
+
+		if (node.count)
+		{
+			for (unsigned int i = node.first; i < node.first + node.count; i++)
+			{
+				unsigned int	itemMask = mask;
+				if (!mask || boxInside(_boxes[_items[i]], planes, itemMask)) visible[count++] = _items[i];
+			}
+
+			continue;
+		}
+
+		// Visit the first child first
+
+		stackNode[depth] = node.first + 1;
+		stackMask[depth++] = mask;
+		stackNode[depth] = node.first;
+		stackMask[depth++] = mask;
+	}
+
+	return count;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Fills in a node over 'count' items (starting at 'first' in the item order), splitting it if there are too many for a leaf
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Bvh::split(const unsigned int node, const unsigned int first, const unsigned int count)
+{
+	sBVHNODE	&n = _nodes[node];
+	n.first = first;
+	n.count = count;
+	fit(node, n.box);
+
+	if (count <= _leafItems)
+	{
+		for (unsigned int i = first; i < first + count; i++) _leaves[_items[i]] = node;
+		return;
+	}
+
+	// Split along the axis the centers are most spread out on
+
+	sBVHBOX	centers;
+	emptyBox(centers);
+
+	for (unsigned int i = first; i < first + count; i++)
+	{
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			float	c = boxCenter(_boxes[_items[i]], axis);
+			if (c < centers.minimum[axis]) centers.minimum[axis] = c;
+			if (c > centers.maximum[axis]) centers.maximum[axis] = c;
+		}
+	}
+
+	unsigned int	axis = 0;
+	for (unsigned int a = 1; a < 3; a++)
+	{
+		if (centers.maximum[a] - centers.minimum[a] > centers.maximum[axis] - centers.minimum[axis]) axis = a;
+	}
+
+	// Half the items go each way
+
+	unsigned int	half = count / 2;
+	select(first, count, first + half, axis);
+
+	unsigned int	children = _nodeCount;
+	_nodeCount += 2;
+	_nodes[children].parent = node;
+	_nodes[children + 1].parent = node;
+	n.first = children;
+	n.count = 0;
+
+	split(children, first, half);
+	split(children + 1, first + half, count - half);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Partially orders 'count' items (starting at 'first') by their centers along 'axis', so that the 'nth' one is where it would be
+// if they were sorted, with none after it less than it, and none before it greater
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Bvh::select(const unsigned int first, const unsigned int count, const unsigned int nth, const unsigned int axis)
+{
+	int	lo = first;
+	int	hi = first + count - 1;
+
+	while(lo < hi)
+	{
+		float	pivot = boxCenter(_boxes[_items[lo + (hi - lo) / 2]], axis);
+		int	i = lo;
+		int	j = hi;
+
+		while(i <= j)
+		{
+			while(boxCenter(_boxes[_items[i]], axis) < pivot) i++;
+			while(boxCenter(_boxes[_items[j]], axis) > pivot) j--;
+
+			if (i <= j)
+			{
+				unsigned int	t = _items[i];
+				_items[i++] = _items[j];
+				_items[j--] = t;
+			}
+		}
+
+		// Everything up to j is no greater than the pivot, everything from i on is no less (and anything between is equal)
+
+		if ((int) nth <= j) hi = j;
+		else if ((int) nth >= i) lo = i;
+		else return;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns the box around a node's children (or, for a leaf, its items)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Bvh::fit(const unsigned int node, sBVHBOX &box) const
+{
+	const	sBVHNODE	&n = _nodes[node];
+	emptyBox(box);
+
+	if (n.count)
+	{
+		for (unsigned int i = n.first; i < n.first + n.count; i++) growBox(box, _boxes[_items[i]]);
+	}
+	else
+	{
+		growBox(box, _nodes[n.first].box);
+		growBox(box, _nodes[n.first + 1].box);
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Bvh.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
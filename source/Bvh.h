@@ -0,0 +1,101 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  ____        _         _     
+// |  _ \      | |       | |    
+// | |_) |_   _| |__     | |__  
+// |  _ <\ \ / / '_ \    | '_ \ 
+// | |_) |\ V /| | | | _ | | | |
+// |____/  \_/ |_| |_|(_)|_| |_|
+//                              
+//                              
+//
+// Bounding volume hierarchies (for culling)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_BVH
+#define	_H_BVH
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// An axis-aligned box, and a plane (a point is on the inside when normal . point + distance >= 0)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	bvhbox
+{
+	float		minimum[3];
+	float		maximum[3];
+} sBVHBOX;
+
+typedef	struct	bvhplane
+{
+	float		normal[3];
+	float		distance;
+} sBVHPLANE;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// A node.  Interior nodes have two children (at 'first' and 'first + 1'); leaves hold 'count' items, starting at 'first' in the
+// item order.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	bvhnode
+{
+	sBVHBOX		box;
+	unsigned int	parent;			// The root is its own parent
+	unsigned int	first;
+	unsigned int	count;			// Zero for interior nodes
+} sBVHNODE;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	Bvh
+{
+public:
+	// Construction/Destruction
+
+				Bvh();
+virtual				~Bvh();
+
+	// Accessors
+
+inline	const	bool		isBuilt() const {return _nodes != NULL;}
+inline	const	unsigned int	&nodeCount() const {return _nodeCount;}
+inline	const	sBVHNODE	&node(const unsigned int i) const {return _nodes[i];}
+inline	const	sBVHBOX		&bounds() const {return _nodes[0].box;}
+inline	const	unsigned int	&itemCount() const {return _itemCount;}
+inline	const	unsigned int	&item(const unsigned int i) const {return _items[i];}
+inline	const	sBVHBOX		&itemBox(const unsigned int item) const {return _boxes[item];}
+
+	// Utilitarian
+
+virtual		bool		build(const sBVHBOX *boxes, const unsigned int count, const unsigned int leafItems = 1);
+virtual		void		destroy();
+virtual		void		refit(const unsigned int item, const sBVHBOX &box);
+virtual		unsigned int	cull(const sBVHPLANE *planes, const unsigned int planeCount, unsigned int *visible) const;
+
+private:
+virtual		void		split(const unsigned int node, const unsigned int first, const unsigned int count);
+virtual		void		select(const unsigned int first, const unsigned int count, const unsigned int nth, const unsigned int axis);
+virtual		void		fit(const unsigned int node, sBVHBOX &box) const;
+
+		sBVHNODE	*_nodes;
+		unsigned int	_nodeCount;
+		sBVHBOX		*_boxes;		// Of each item (as given, or as last refit)
+		unsigned int	*_items;		// In leaf order
+		unsigned int	*_leaves;		// The leaf each item is in
+		unsigned int	_itemCount;
+		unsigned int	_leafItems;
+};
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Bvh.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
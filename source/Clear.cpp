@@ -0,0 +1,187 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//   _____ _                                      
+//  / ____| |                                     
+// | |    | | ___  __ _ _ __      ___ _ __  _ __  
+// | |    | |/ _ \/ _` | '__|    / __| '_ \| '_ \ 
+// | |____| |  __/ (_| | |    _ | (__| |_) | |_) |
+//  \_____|_|\___|\__,_|_|   (_) \___| .__/| .__/ 
+//                                   | |   | |    
+//                                   |_|   |_|    
+//
+// Frame buffer clearing (streaming & clear-on-first-write)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// A full-frame clear that uses normal stores reads every cache line of the frame buffer before it writes it (a read-for-ownership)
+// and leaves the cache full of pixels that won't be touched again until the mappers get to them -- by then, they've long since been
+// evicted.  Two fixes here:
+//
+// clearBuffer() uses streaming (non-temporal) stores, which write straight to memory without the read and without polluting the
+// cache.  This is the right thing for anything that won't be drawn over soon.
+//
+// The tiled clear waits until a mapper is about to draw into a tile, then clears that tile with normal stores so it's sitting in
+// cache when the mapper reads it back for blending.  Tiles nobody draws into are cleared with streaming stores at the end of the
+// frame.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Tiles are sized to fit comfortably in L2
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	unsigned int	tileBytes = 64 * 1024;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Clears with streaming stores (bypassing the cache)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	clearBuffer(unsigned int *dst, unsigned int count, const unsigned int color)
+{
+	#ifdef USE_SSE2
+
+	// Streaming stores need 16-byte alignment
+
+	while(count && ((size_t) dst & 15))
+	{
+		*(dst++) = color;
+		count--;
+	}
+
+	__m128i		c = _mm_set1_epi32(color);
+	__m128i		*d = (__m128i *) dst;
+
+	for (unsigned int i = count >> 4; i; i--, d += 4)
+	{
+		_mm_stream_si128(d + 0, c);
+		_mm_stream_si128(d + 1, c);
+		_mm_stream_si128(d + 2, c);
+		_mm_stream_si128(d + 3, c);
+	}
+
+	_mm_sfence();
+
+	dst = (unsigned int *) d;
+	count &= 15;
+	#endif
+
+	fillBuffer(dst, count, color);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Clears with normal stores (leaving the pixels in cache)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	fillBuffer(unsigned int *dst, unsigned int count, const unsigned int color)
+{
+	if (!color)
+	{
+		memset(dst, 0, count * sizeof(unsigned int));
+		return;
+	}
+
+	for (; count; count--)
+	{
+		*(dst++) = color;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Starts a frame: every tile is marked as needing a clear
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	beginTiledClear(sCLEARTILES &tiles, unsigned int *frameBuffer, const unsigned int pitch, const unsigned int height, const unsigned int color)
+{
+	// As many scanlines per tile as will fit in tileBytes (at least one)
+
+	unsigned int	shift = 0;
+	while(pitch * sizeof(unsigned int) << (shift + 1) <= tileBytes) shift++;
+
+	unsigned int	count = (height + (1 << shift) - 1) >> shift;
+
+	if (count != tiles.tileCount)
+	{
+		delete[] tiles.cleared;
+		tiles.cleared = new unsigned char[count];
+		tiles.tileCount = count;
+	}
+
+	tiles.frameBuffer = frameBuffer;
+	tiles.pitch = pitch;
+	tiles.height = height;
+	tiles.color = color;
+	tiles.tileShift = shift;
+	memset(tiles.cleared, 0, count);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	clearTile(sCLEARTILES &tiles, const unsigned int tile)
+{
+	unsigned int	top = tile << tiles.tileShift;
+	unsigned int	rows = 1 << tiles.tileShift;
+	if (top + rows > tiles.height) rows = tiles.height - top;
+
+	fillBuffer(tiles.frameBuffer + top * tiles.pitch, rows * tiles.pitch, tiles.color);
+	tiles.cleared[tile] = 1;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Ends a frame: anything that was never drawn into is cleared (with streaming stores, since nothing will read it back)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	endTiledClear(sCLEARTILES &tiles)
+{
+	for (unsigned int i = 0; i < tiles.tileCount; i++)
+	{
+		if (tiles.cleared[i]) continue;
+
+		// Clear the whole run of untouched tiles at once
+
+		unsigned int	first = i;
+		while(i < tiles.tileCount && !tiles.cleared[i]) tiles.cleared[i++] = 1;
+
+		unsigned int	top = first << tiles.tileShift;
+		unsigned int	bottom = i << tiles.tileShift;
+		if (bottom > tiles.height) bottom = tiles.height;
+
+		clearBuffer(tiles.frameBuffer + top * tiles.pitch, (bottom - top) * tiles.pitch, tiles.color);
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	freeTiledClear(sCLEARTILES &tiles)
+{
+	delete[] tiles.cleared;
+	memset(&tiles, 0, sizeof(tiles));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Clear.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,77 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//   _____ _                     _     
+//  / ____| |                   | |    
+// | |    | | ___  __ _ _ __    | |__  
+// | |    | |/ _ \/ _` | '__|   | '_ \ 
+// | |____| |  __/ (_| | |    _ | | | |
+//  \_____|_|\___|\__,_|_|   (_)|_| |_|
+//                                     
+//                                     
+//
+// Frame buffer clearing (streaming & clear-on-first-write)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_CLEAR
+#define	_H_CLEAR
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Tiled clearing.  The frame buffer is split into tiles (bands of full scanlines) which are cleared the first time anything is
+// drawn into them, so the clear happens in cache right before the mapper reads it back.  Whatever is never drawn into gets a
+// streaming clear at the end of the frame.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	cleartiles
+{
+	unsigned int	*frameBuffer;
+	unsigned int	pitch;			// Frame buffer pitch (in pixels)
+	unsigned int	height;			// Frame buffer height (in scanlines)
+	unsigned int	color;			// Clear color
+	unsigned int	tileShift;		// log2 of the scanlines per tile
+	unsigned int	tileCount;
+	unsigned char	*cleared;		// One per tile (non-zero once cleared)
+} sCLEARTILES;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	clearBuffer(unsigned int *dst, unsigned int count, const unsigned int color);
+void	fillBuffer(unsigned int *dst, unsigned int count, const unsigned int color);
+void	beginTiledClear(sCLEARTILES &tiles, unsigned int *frameBuffer, const unsigned int pitch, const unsigned int height, const unsigned int color);
+void	clearTile(sCLEARTILES &tiles, const unsigned int tile);
+void	endTiledClear(sCLEARTILES &tiles);
+void	freeTiledClear(sCLEARTILES &tiles);
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Makes sure the given scanlines have been cleared
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+inline	void	touchRows(sCLEARTILES &tiles, const int top, const int count)
+{
+	if (count <= 0) return;
+
+	unsigned int	first = top < 0 ? 0 : (unsigned int) top >> tiles.tileShift;
+	unsigned int	last = (unsigned int) (top + count - 1) >> tiles.tileShift;
+	if (last >= tiles.tileCount) last = tiles.tileCount - 1;
+
+	for (unsigned int i = first; i <= last; i++)
+	{
+		if (!tiles.cleared[i]) clearTile(tiles, i);
+	}
+}
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Clear.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
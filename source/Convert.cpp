@@ -0,0 +1,507 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//   _____                             _                        
+//  / ____|                           | |                       
+// | |      ___  _ __ __   __ ___ _ __| |_      ___ _ __  _ __  
+// | |     / _ \| '_ \\ \ / // _ \ '__| __|    / __| '_ \| '_ \ 
+// | |____| (_) | | | |\ V /|  __/ |  | |_  _ | (__| |_) | |_) |
+//  \_____|\___/|_| |_| \_/  \___|_|   \__|(_) \___| .__/| .__/ 
+//                                                 | |   | |    
+//                                                 |_|   |_|    
+//
+// Pixel format conversion (32-bit frame buffer to 8/15/16/24-bit output)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// Everything is rendered at 32 bits, and converted down (if the display or whoever else is receiving the frame wants it that way)
+// right before it's presented.
+//
+// 15 & 16-bit conversions are done 8 pixels at a time with SSE2: each channel is shifted into place and masked, then pairs of
+// 32-bit results are packed into 16-bit lanes.  SSE2 only has a signed pack, so the values are sign-extended from 16 bits first,
+// which makes the pack exact.
+//
+// The optional ordered dither adds a 4x4 Bayer threshold (scaled to the bits each channel is about to lose) to each pixel with
+// a saturating byte add, before the truncation.
+//
+// 8-bit output goes through the same 15-bit reduction, then a 32K-entry table gives the nearest palette index.
+//
+// 24-bit has no useful SSE2 form (there's no byte shuffle), so 4 pixels are packed into 3 dwords with shifts.
+//
+// Large conversions are split into bands of scanlines, one per processor.  The helper threads are created the first time they're
+// needed and sleep on an event between frames.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <process.h>
+
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// 4x4 ordered dither thresholds (0-15)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	unsigned int	bayer[4][4] =
+{
+	{ 0,  8,  2, 10},
+	{12,  4, 14,  6},
+	{ 3, 11,  1,  9},
+	{15,  7, 13,  5}
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// A conversion job (one band's worth)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	convertjob
+{
+	const	unsigned int	*src;
+	unsigned int		srcPitch;		// In pixels
+	unsigned char		*dst;
+	unsigned int		dstPitch;		// In bytes
+	CRect			rect;
+	WORD			depth;
+	bool			dither;
+	const	sCONVERTPALETTE	*palette;
+} sCONVERTJOB;
+
+typedef	struct	convertworker
+{
+	HANDLE		thread;
+	HANDLE		start;
+	sCONVERTJOB	job;
+} sCONVERTWORKER;
+
+static	sCONVERTWORKER	workers[convertMaxThreads];
+static	HANDLE		doneEvents[convertMaxThreads];
+static	unsigned int	workerCount;			// Helper threads (the calling thread always does a band, too)
+static	bool		threadsStarted;
+static	volatile bool	quitting;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Builds the dither words for a scanline: each one holds the thresholds to add to the red, green & blue bytes of a pixel
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	ditherRow(unsigned int words[4], const WORD depth, const int x, const int y, const bool dither)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		unsigned int	d = dither ? bayer[y & 3][(x + i) & 3] : 0;
+
+		// Red & blue lose 3 bits; green loses 2 in 5-6-5 and 3 otherwise
+
+		unsigned int	d5 = d >> 1;
+		unsigned int	dg = depth == 16 ? d >> 2 : d5;
+		words[i] = (d5 << 16) | (dg << 8) | d5;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Scalar routines
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	unsigned int	addSaturate(const unsigned int p, const unsigned int d)
+{
+	unsigned int	r = ((p >> 16) & 0xff) + ((d >> 16) & 0xff);
+	unsigned int	g = ((p >>  8) & 0xff) + ((d >>  8) & 0xff);
+	unsigned int	b = ( p        & 0xff) + ( d        & 0xff);
+	if (r > 0xff) r = 0xff;
+	if (g > 0xff) g = 0xff;
+	if (b > 0xff) b = 0xff;
+	return (r << 16) | (g << 8) | b;
+}
+
+static	inline	unsigned int	to565(const unsigned int p)
+{
+	return ((p >> 8) & 0xF800) | ((p >> 5) & 0x07E0) | ((p >> 3) & 0x001F);
+}
+
+static	inline	unsigned int	to555(const unsigned int p)
+{
+	return ((p >> 9) & 0x7C00) | ((p >> 6) & 0x03E0) | ((p >> 3) & 0x001F);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// SSE2 routines
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef USE_SSE2
+static	inline	__m128i	pack565(const __m128i p)
+{
+	__m128i	r = _mm_and_si128(_mm_srli_epi32(p, 8), _mm_set1_epi32(0xF800));
+	__m128i	g = _mm_and_si128(_mm_srli_epi32(p, 5), _mm_set1_epi32(0x07E0));
+	__m128i	b = _mm_and_si128(_mm_srli_epi32(p, 3), _mm_set1_epi32(0x001F));
+	__m128i	x = _mm_or_si128(_mm_or_si128(r, g), b);
+	return _mm_srai_epi32(_mm_slli_epi32(x, 16), 16);
+}
+
+static	inline	__m128i	pack555(const __m128i p)
+{
+	__m128i	r = _mm_and_si128(_mm_srli_epi32(p, 9), _mm_set1_epi32(0x7C00));
+	__m128i	g = _mm_and_si128(_mm_srli_epi32(p, 6), _mm_set1_epi32(0x03E0));
+	__m128i	b = _mm_and_si128(_mm_srli_epi32(p, 3), _mm_set1_epi32(0x001F));
+	return _mm_or_si128(_mm_or_si128(r, g), b);
+}
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Converts a scanline to 16 bits (5-6-5 or 5-5-5)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	rowTo16(const unsigned int *src, unsigned short *dst, const int count, const unsigned int dither[4], const bool is565)
+{
+	int	i = 0;
+
+	#ifdef USE_SSE2
+	__m128i	d = _mm_loadu_si128((const __m128i *) dither);
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i	a = _mm_adds_epu8(_mm_loadu_si128((const __m128i *) (src + i)), d);
+		__m128i	b = _mm_adds_epu8(_mm_loadu_si128((const __m128i *) (src + i + 4)), d);
+		__m128i	out = is565 ? _mm_packs_epi32(pack565(a), pack565(b)) : _mm_packs_epi32(pack555(a), pack555(b));
+		_mm_storeu_si128((__m128i *) (dst + i), out);
+	}
+	#endif
+
+	for (; i < count; i++)
+	{
+		unsigned int	p = addSaturate(src[i], dither[i & 3]);
+		dst[i] = (unsigned short) (is565 ? to565(p) : to555(p));
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Converts a scanline to 8 bits (palettized)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	rowTo8(const unsigned int *src, unsigned char *dst, const int count, const unsigned int dither[4], const sCONVERTPALETTE &palette)
+{
+	int	i = 0;
+
+	#ifdef USE_SSE2
+	__m128i	d = _mm_loadu_si128((const __m128i *) dither);
+	unsigned short	keys[8];
+
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i	a = _mm_adds_epu8(_mm_loadu_si128((const __m128i *) (src + i)), d);
+		__m128i	b = _mm_adds_epu8(_mm_loadu_si128((const __m128i *) (src + i + 4)), d);
+		_mm_storeu_si128((__m128i *) keys, _mm_packs_epi32(pack555(a), pack555(b)));
+
+		dst[i+0] = palette.lookup[keys[0]];
+		dst[i+1] = palette.lookup[keys[1]];
+		dst[i+2] = palette.lookup[keys[2]];
+		dst[i+3] = palette.lookup[keys[3]];
+		dst[i+4] = palette.lookup[keys[4]];
+		dst[i+5] = palette.lookup[keys[5]];
+		dst[i+6] = palette.lookup[keys[6]];
+		dst[i+7] = palette.lookup[keys[7]];
+	}
+	#endif
+
+	for (; i < count; i++)
+	{
+		dst[i] = palette.lookup[to555(addSaturate(src[i], dither[i & 3]))];
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Converts a scanline to 24 bits (B, G, R byte order, just like the low three bytes of each 32-bit pixel)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	rowTo24(const unsigned int *src, unsigned char *dst, const int count)
+{
+	int	i = 0;
+
+	for (; i + 4 <= count; i += 4, src += 4, dst += 12)
+	{
+		unsigned int	*out = (unsigned int *) dst;
+		out[0] = ( src[0]        & 0xffffff) | (src[1] << 24);
+		out[1] = ((src[1] >>  8) & 0x00ffff) | (src[2] << 16);
+		out[2] = ((src[2] >> 16) & 0x0000ff) | (src[3] <<  8);
+	}
+
+	for (; i < count; i++, src++, dst += 3)
+	{
+		dst[0] = (unsigned char) (*src);
+		dst[1] = (unsigned char) (*src >> 8);
+		dst[2] = (unsigned char) (*src >> 16);
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	runJob(const sCONVERTJOB &job)
+{
+	convertRows(job.src, job.srcPitch, job.dst, job.dstPitch, job.rect, job.depth, job.dither, job.palette);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	unsigned WINAPI	convertWorker(void *param)
+{
+	sCONVERTWORKER	&worker = *(sCONVERTWORKER *) param;
+	unsigned int	index = &worker - workers;
+
+	for(;;)
+	{
+		WaitForSingleObject(worker.start, INFINITE);
+		if (quitting) break;
+
+		runJob(worker.job);
+		SetEvent(doneEvents[index]);
+	}
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Builds the 5-5-5 lookup table for a palette.  This is a brute-force search (32K x 256) so it belongs at startup, not per-frame.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	buildConvertPalette(sCONVERTPALETTE &palette, const unsigned int *colors, const unsigned int count)
+{
+	palette.count = count > 256 ? 256 : count;
+	memset(palette.colors, 0, sizeof(palette.colors));
+	memcpy(palette.colors, colors, palette.count * sizeof(unsigned int));
+
+	for (unsigned int key = 0; key < 32768; key++)
+	{
+		// Center of the 5-5-5 cell (replicating the top bits, so 31 maps to 255)
+
+		int	r = (key >> 10) & 0x1f; r = (r << 3) | (r >> 2);
+		int	g = (key >>  5) & 0x1f; g = (g << 3) | (g >> 2);
+		int	b =  key        & 0x1f; b = (b << 3) | (b >> 2);
+
+		unsigned int	best = 0;
+		int		bestDist = 0x7fffffff;
+
+		for (unsigned int i = 0; i < palette.count; i++)
+		{
+			int	dr = r - (int) ((palette.colors[i] >> 16) & 0xff);
+			int	dg = g - (int) ((palette.colors[i] >>  8) & 0xff);
+			int	db = b - (int) ( palette.colors[i]        & 0xff);
+			int	dist = dr * dr + dg * dg + db * db;
+
+			if (dist < bestDist)
+			{
+				bestDist = dist;
+				best = i;
+			}
+		}
+
+		palette.lookup[key] = (unsigned char) best;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// A general purpose palette: a 6x6x6 color cube, with the rest filled in by a gray ramp
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	buildDefaultConvertPalette(sCONVERTPALETTE &palette)
+{
+	unsigned int	colors[256];
+	unsigned int	count = 0;
+
+	for (unsigned int r = 0; r < 6; r++)
+	{
+		for (unsigned int g = 0; g < 6; g++)
+		{
+			for (unsigned int b = 0; b < 6; b++)
+			{
+				colors[count++] = 0xff000000 | ((r * 51) << 16) | ((g * 51) << 8) | (b * 51);
+			}
+		}
+	}
+
+	unsigned int	grays = 256 - count;
+
+	for (unsigned int i = 0; i < grays; i++)
+	{
+		unsigned int	v = (i + 1) * 255 / (grays + 1);
+		colors[count++] = 0xff000000 | (v << 16) | (v << 8) | v;
+	}
+
+	buildConvertPalette(palette, colors, count);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Converts a rectangle of the source on the calling thread.  'rect' is in pixels and applies to both the source & destination.
+// 8-bit output requires a palette.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	convertRows(const unsigned int *src, const unsigned int srcPitch, unsigned char *dst, const unsigned int dstPitch,
+		    const CRect &rect, const WORD depth, const bool dither, const sCONVERTPALETTE *palette)
+{
+	int	count = rect.Width();
+	if (count <= 0) return;
+
+	unsigned int	bytesPerPixel = depth == 15 ? 2 : depth / 8;
+	if (depth == 8 && !palette) return;
+
+	const	unsigned int	*s = src + rect.top * srcPitch + rect.left;
+	unsigned char		*d = dst + rect.top * dstPitch + rect.left * bytesPerPixel;
+	unsigned int		dw[4];
+
+	for (int y = rect.top; y < rect.bottom; y++, s += srcPitch, d += dstPitch)
+	{
+		switch(depth)
+		{
+			case 8:
+				ditherRow(dw, depth, rect.left, y, dither);
+				rowTo8(s, d, count, dw, *palette);
+				break;
+
+			case 15:
+			case 16:
+				ditherRow(dw, depth, rect.left, y, dither);
+				rowTo16(s, (unsigned short *) d, count, dw, depth == 16);
+				break;
+
+			case 24:
+				rowTo24(s, d, count);
+				break;
+
+			case 32:
+				memcpy(d, s, count * sizeof(unsigned int));
+				break;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Same as convertRows, but large rectangles are split into bands and converted in parallel
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	convertBuffer(const unsigned int *src, const unsigned int srcPitch, unsigned char *dst, const unsigned int dstPitch,
+		      const CRect &rect, const WORD depth, const bool dither, const sCONVERTPALETTE *palette)
+{
+	if (!threadsStarted) convertThreads(0);
+
+	// Small jobs aren't worth waking anybody up for
+
+	if (!workerCount || (unsigned int) (rect.Width() * rect.Height()) < convertBandMinimum)
+	{
+		convertRows(src, srcPitch, dst, dstPitch, rect, depth, dither, palette);
+		return;
+	}
+
+	// Split it up -- the helpers get the bottom bands, we take the top one
+
+	unsigned int	bands = workerCount + 1;
+	int		rowsPerBand = (rect.Height() + bands - 1) / bands;
+	unsigned int	used = 0;
+
+	for (unsigned int i = 0; i < workerCount; i++)
+	{
+		int	top = rect.top + rowsPerBand * (i + 1);
+		if (top >= rect.bottom) break;
+
+		sCONVERTJOB	&job = workers[i].job;
+		job.src = src;
+		job.srcPitch = srcPitch;
+		job.dst = dst;
+		job.dstPitch = dstPitch;
+		int	bottom = top + rowsPerBand < rect.bottom ? top + rowsPerBand : rect.bottom;
+		job.rect = CRect(rect.left, top, rect.right, bottom);
+		job.depth = depth;
+		job.dither = dither;
+		job.palette = palette;
+
+		SetEvent(workers[i].start);
+		used++;
+	}
+
+	int	bottom = rect.top + rowsPerBand < rect.bottom ? rect.top + rowsPerBand : rect.bottom;
+	convertRows(src, srcPitch, dst, dstPitch, CRect(rect.left, rect.top, rect.right, bottom), depth, dither, palette);
+
+	if (used) WaitForMultipleObjects(used, doneEvents, TRUE, INFINITE);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Sets the number of bands that large conversions are split into (including the calling thread's.)  Zero means one per processor.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	convertThreads(const unsigned int count)
+{
+	convertShutdown();
+	threadsStarted = true;
+
+	unsigned int	bands = count;
+
+	if (!bands)
+	{
+		SYSTEM_INFO	si;
+		GetSystemInfo(&si);
+		bands = si.dwNumberOfProcessors;
+	}
+
+	if (bands > convertMaxThreads) bands = convertMaxThreads;
+
+	for (unsigned int i = 0; i + 1 < bands; i++)
+	{
+		sCONVERTWORKER	&worker = workers[workerCount];
+		worker.start = CreateEvent(NULL, FALSE, FALSE, NULL);
+		doneEvents[workerCount] = CreateEvent(NULL, FALSE, FALSE, NULL);
+
+		unsigned int	id;
+		worker.thread = (HANDLE) _beginthreadex(NULL, 0, convertWorker, &worker, 0, &id);
+
+		if (!worker.thread)
+		{
+			CloseHandle(worker.start);
+			CloseHandle(doneEvents[workerCount]);
+			break;
+		}
+
+		workerCount++;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Stops the helper threads
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	convertShutdown()
+{
+	quitting = true;
+
+	for (unsigned int i = 0; i < workerCount; i++)
+	{
+		SetEvent(workers[i].start);
+		WaitForSingleObject(workers[i].thread, INFINITE);
+		CloseHandle(workers[i].thread);
+		CloseHandle(workers[i].start);
+		CloseHandle(doneEvents[i]);
+	}
+
+	workerCount = 0;
+	threadsStarted = false;
+	quitting = false;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Convert.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
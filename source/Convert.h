@@ -0,0 +1,63 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//   _____                             _       _     
+//  / ____|                           | |     | |    
+// | |      ___  _ __ __   __ ___ _ __| |_    | |__  
+// | |     / _ \| '_ \\ \ / // _ \ '__| __|   | '_ \ 
+// | |____| (_) | | | |\ V /|  __/ |  | |_  _ | | | |
+//  \_____|\___/|_| |_| \_/  \___|_|   \__|(_)|_| |_|
+//                                                   
+//                                                   
+//
+// Pixel format conversion (32-bit frame buffer to 8/15/16/24-bit output)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_CONVERT
+#define	_H_CONVERT
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Output palette for 8-bit conversion.  Pixels are reduced to 15 bits (5-5-5) and looked up in 'lookup' for the nearest of the
+// palette's colors.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	convertpalette
+{
+	unsigned int	colors[256];		// ARGB
+	unsigned int	count;
+	unsigned char	lookup[32768];		// 5-5-5 color -> nearest palette index
+} sCONVERTPALETTE;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Rectangles smaller than this (in pixels) are converted on the calling thread rather than split into bands
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned int	convertBandMinimum = 16384;
+const	unsigned int	convertMaxThreads = 8;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	buildConvertPalette(sCONVERTPALETTE &palette, const unsigned int *colors, const unsigned int count);
+void	buildDefaultConvertPalette(sCONVERTPALETTE &palette);
+void	convertRows(const unsigned int *src, const unsigned int srcPitch, unsigned char *dst, const unsigned int dstPitch,
+		    const CRect &rect, const WORD depth, const bool dither = false, const sCONVERTPALETTE *palette = NULL);
+void	convertBuffer(const unsigned int *src, const unsigned int srcPitch, unsigned char *dst, const unsigned int dstPitch,
+		      const CRect &rect, const WORD depth, const bool dither = false, const sCONVERTPALETTE *palette = NULL);
+void	convertThreads(const unsigned int count);
+void	convertShutdown();
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Convert.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
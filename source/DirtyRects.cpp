@@ -0,0 +1,179 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____  _      _         _____            _                            
+// |  __ \(_)    | |       |  __ \          | |                           
+// | |  | |_ _ __| |_ _   _| |__) | ___  ___| |_ ___      ___ _ __  _ __  
+// | |  | | | '__| __| | | |  _  / / _ \/ __| __/ __|    / __| '_ \| '_ \ 
+// | |__| | | |  | |_| |_| | | \ \|  __/ (__| |_\__ \ _ | (__| |_) | |_) |
+// |_____/|_|_|   \__|\__, |_|  \_\\___|\___|\__|___/(_) \___| .__/| .__/ 
+//                     __/ |                                 | |   | |    
+//                    |___/                                  |_|   |_|    
+//
+// Dirty rectangle tracking
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	bool	overlaps(const CRect &a, const CRect &b)
+{
+	return a.left < b.right && b.left < a.right && a.top < b.bottom && b.top < a.bottom;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	int	rectArea(const CRect &r)
+{
+	return r.Width() * r.Height();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	CRect	unionOf(const CRect &a, const CRect &b)
+{
+	return CRect(a.left < b.left ? a.left : b.left, a.top < b.top ? a.top : b.top,
+		     a.right > b.right ? a.right : b.right, a.bottom > b.bottom ? a.bottom : b.bottom);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		DirtyRects::DirtyRects()
+		:_count(0)
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		DirtyRects::~DirtyRects()
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		DirtyRects::reset()
+{
+	_count = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		DirtyRects::add(const CRect &rect)
+{
+	if (rect.IsRectEmpty()) return;
+
+	// If it overlaps one we already have, grow that one (and keep merging until nothing overlaps)
+
+	for (unsigned int i = 0; i < _count; i++)
+	{
+		if (overlaps(_rects[i], rect))
+		{
+			_rects[i] = unionOf(_rects[i], rect);
+			merge(i);
+			return;
+		}
+	}
+
+	// Room for a new one?
+
+	if (_count < maxDirtyRects)
+	{
+		_rects[_count++] = rect;
+		return;
+	}
+
+	// Full -- merge it into whichever rect grows the least
+
+	unsigned int	best = 0;
+	int		bestGrowth = 0x7fffffff;
+
+	for (unsigned int j = 0; j < _count; j++)
+	{
+		int	growth = rectArea(unionOf(_rects[j], rect)) - rectArea(_rects[j]);
+		if (growth < bestGrowth)
+		{
+			bestGrowth = growth;
+			best = j;
+		}
+	}
+
+	_rects[best] = unionOf(_rects[best], rect);
+	merge(best);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		DirtyRects::add(const DirtyRects &rects)
+{
+	for (unsigned int i = 0; i < rects.count(); i++)
+	{
+		add(rects[i]);
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Total area covered (the rects never overlap)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int	DirtyRects::area() const
+{
+	unsigned int	total = 0;
+	for (unsigned int i = 0; i < _count; i++)
+	{
+		total += rectArea(_rects[i]);
+	}
+	return total;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Merges everything that overlaps the given rect into it (growing it as it goes)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		DirtyRects::merge(unsigned int index)
+{
+	CRect		r = _rects[index];
+	bool		merged = true;
+
+	while(merged)
+	{
+		merged = false;
+
+		for (unsigned int i = 0; i < _count; i++)
+		{
+			if (i == index || !overlaps(_rects[i], r)) continue;
+
+			r = unionOf(r, _rects[i]);
+
+			// Remove rect i (the last one takes its place)
+
+			_rects[i] = _rects[--_count];
+			if (index == _count) index = i;
+			merged = true;
+			break;
+		}
+	}
+
+	_rects[index] = r;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// DirtyRects.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
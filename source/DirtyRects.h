@@ -0,0 +1,68 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____  _      _         _____            _           _     
+// |  __ \(_)    | |       |  __ \          | |         | |    
+// | |  | |_ _ __| |_ _   _| |__) | ___  ___| |_ ___    | |__  
+// | |  | | | '__| __| | | |  _  / / _ \/ __| __/ __|   | '_ \ 
+// | |__| | | |  | |_| |_| | | \ \|  __/ (__| |_\__ \ _ | | | |
+// |_____/|_|_|   \__|\__, |_|  \_\\___|\___|\__|___/(_)|_| |_|
+//                     __/ |                                   
+//                    |___/                                    
+//
+// Dirty rectangle tracking
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_DIRTYRECTS
+#define	_H_DIRTYRECTS
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// A small set of non-overlapping rectangles.  Overlapping rectangles are merged as they're added, and once the set is full, new
+// rectangles are merged into whichever existing one grows the least.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned int	maxDirtyRects = 16;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	DirtyRects
+{
+public:
+	// Construction/Destruction
+
+				DirtyRects();
+virtual				~DirtyRects();
+
+	// Accessors
+
+inline	const	unsigned int	&count() const {return _count;}
+inline	const	CRect		&operator[](const unsigned int index) const {return _rects[index];}
+inline	const	bool		isEmpty() const {return _count == 0;}
+
+	// Utilitarian
+
+virtual		void		reset();
+virtual		void		add(const CRect &rect);
+virtual		void		add(const DirtyRects &rects);
+virtual		unsigned int	area() const;
+
+private:
+virtual		void		merge(unsigned int index);
+
+		CRect		_rects[maxDirtyRects];
+		unsigned int	_count;
+};
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// DirtyRects.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
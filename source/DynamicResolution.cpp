@@ -0,0 +1,177 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____                              _      _____                  _       _   _                                  
+// |  __ \                            (_)    |  __ \                | |     | | (_)                                 
+// | |  | |_   _ _ __   __ _ _ __ ___  _  ___| |__) | ___  ___  ___ | |_   _| |_ _  ___  _ __       ___ _ __  _ __  
+// | |  | | | | | '_ \ / _` | '_ ` _ \| |/ __|  _  / / _ \/ __|/ _ \| | | | | __| |/ _ \| '_ \     / __| '_ \| '_ \ 
+// | |__| | |_| | | | | (_| | | | | | | | (__| | \ \|  __/\__ \ (_) | | |_| | |_| | (_) | | | | _ | (__| |_) | |_) |
+// |_____/ \__, |_| |_|\__,_|_| |_| |_|_|\___|_|  \_\\___||___/\___/|_|\__,_|\__|_|\___/|_| |_|(_) \___| .__/| .__/ 
+//          __/ |                                                                                      | |   | |    
+//         |___/                                                                                       |_|   |_|    
+//
+// Dynamic resolution (trading resolution for frame time)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// The cost of a frame is mostly fill, so it goes with the number of pixels drawn: the square of the scale.  When a frame goes
+// over budget, the scale drops at once to where the frame should fit (with a little to spare), working from the worse of that
+// frame's time and the running average.  A single slow frame is enough; on a busy machine, a blurrier frame is far better than
+// a late one.
+//
+// Going back up is cautious: only when the average is well under budget, a small step at a time, and not until a while after
+// the last change, so the scale doesn't oscillate around the budget.
+//
+// Frame times are wall-clock times, so time spent waiting for the processor counts, which is the point.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <math.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Tuning
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	double		smoothing = 0.1;		// Weight of each new frame in the average
+static	const	double		aim = 0.9;			// Scale to fit in this fraction of the budget
+static	const	double		headroom = 0.75;		// Only scale up when the average is under this fraction of it
+static	const	double		increaseStep = 1.05;
+static	const	unsigned int	settleFrames = 30;		// Frames to wait after a change before scaling up
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		DynamicResolution::DynamicResolution()
+		:_budget(1.0 / 60.0), _minScale(0.25), _maxScale(1.0), _scale(1.0), _start(0), _cooldown(0)
+{
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		DynamicResolution::~DynamicResolution()
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Sets the frame time to aim for (in seconds) and the range the scale can move in
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		DynamicResolution::setup(const double budget, const double minScale, const double maxScale)
+{
+	_budget = budget;
+	_minScale = minScale;
+	_maxScale = maxScale < minScale ? minScale : maxScale;
+	_scale = _maxScale;
+	_cooldown = 0;
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		DynamicResolution::beginFrame()
+{
+	_start = seconds();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Measures the frame and picks the scale for the next one
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		DynamicResolution::endFrame()
+{
+	double	elapsed = seconds() - _start;
+
+	_stats.frames++;
+	_stats.lastFrameTime = elapsed;
+	if (_stats.frames == 1) _stats.averageFrameTime = elapsed;
+	else _stats.averageFrameTime += (elapsed - _stats.averageFrameTime) * smoothing;
+
+	// Over budget: drop straight to where it should fit
+
+	double	worst = elapsed > _stats.averageFrameTime ? elapsed : _stats.averageFrameTime;
+
+	if (worst > _budget)
+	{
+		_stats.overBudget++;
+
+		double	scale = _scale * sqrt(_budget * aim / worst);
+		if (scale < _minScale) scale = _minScale;
+
+		if (scale < _scale)
+		{
+			rescale(scale);
+			_stats.decreases++;
+		}
+
+		_cooldown = settleFrames;
+		return;
+	}
+
+	// Well under budget: creep back up (no further than where it should still fit)
+
+	if (_cooldown)
+	{
+		_cooldown--;
+		return;
+	}
+
+	if (_scale < _maxScale && _stats.averageFrameTime < _budget * headroom)
+	{
+		double	fit = _scale * sqrt(_budget * aim / _stats.averageFrameTime);
+		double	scale = _scale * increaseStep;
+		if (scale > fit) scale = fit;
+		if (scale > _maxScale) scale = _maxScale;
+
+		if (scale > _scale)
+		{
+			rescale(scale);
+			_stats.increases++;
+			_cooldown = settleFrames / 3;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Changes the scale.  The average frame time is carried over to what it should be at the new scale, or the next few frames would
+// be judged by how long frames took at the old one.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		DynamicResolution::rescale(const double scale)
+{
+	_stats.averageFrameTime *= (scale * scale) / (_scale * _scale);
+	_scale = scale;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns a dimension at the current scale (never less than 2 pixels)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int	DynamicResolution::scaled(const unsigned int size) const
+{
+	unsigned int	result = (unsigned int) (size * _scale + 0.5);
+	if (result > size) result = size;
+	return result < 2 ? 2 : result;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// DynamicResolution.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
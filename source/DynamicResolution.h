@@ -0,0 +1,82 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____                              _      _____                  _       _   _                 _     
+// |  __ \                            (_)    |  __ \                | |     | | (_)               | |    
+// | |  | |_   _ _ __   __ _ _ __ ___  _  ___| |__) | ___  ___  ___ | |_   _| |_ _  ___  _ __     | |__  
+// | |  | | | | | '_ \ / _` | '_ ` _ \| |/ __|  _  / / _ \/ __|/ _ \| | | | | __| |/ _ \| '_ \    | '_ \ 
+// | |__| | |_| | | | | (_| | | | | | | | (__| | \ \|  __/\__ \ (_) | | |_| | |_| | (_) | | | | _ | | | |
+// |_____/ \__, |_| |_|\__,_|_| |_| |_|_|\___|_|  \_\\___||___/\___/|_|\__,_|\__|_|\___/|_| |_|(_)|_| |_|
+//          __/ |                                                                                        
+//         |___/                                                                                         
+//
+// Dynamic resolution (trading resolution for frame time)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_DYNAMICRESOLUTION
+#define	_H_DYNAMICRESOLUTION
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Statistics
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	resolutionstats
+{
+	unsigned int	frames;
+	unsigned int	overBudget;		// Frames that took longer than the budget
+	unsigned int	decreases;		// Times the scale was lowered
+	unsigned int	increases;		// ...and raised
+	double		lastFrameTime;		// In seconds
+	double		averageFrameTime;	// Smoothed
+} sRESOLUTIONSTATS;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The controller.  Bracket each frame's work with beginFrame() and endFrame(); scale() is the fraction of the output resolution
+// (in each direction) to render the next frame at.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	DynamicResolution
+{
+public:
+	// Construction/Destruction
+
+				DynamicResolution();
+virtual				~DynamicResolution();
+
+	// Accessors
+
+inline	const	double		&budget() const {return _budget;}
+inline	const	double		&scale() const {return _scale;}
+inline	const	sRESOLUTIONSTATS &stats() const {return _stats;}
+
+	// Utilitarian
+
+virtual		void		setup(const double budget, const double minScale = 0.25, const double maxScale = 1.0);
+virtual		void		beginFrame();
+virtual		void		endFrame();
+virtual		unsigned int	scaled(const unsigned int size) const;
+
+private:
+		void		rescale(const double scale);
+
+		double		_budget;		// Target frame time (in seconds)
+		double		_minScale, _maxScale;
+		double		_scale;
+		double		_start;
+		unsigned int	_cooldown;		// Frames to wait before the next increase
+		sRESOLUTIONSTATS _stats;
+};
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// DynamicResolution.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
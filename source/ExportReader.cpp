@@ -0,0 +1,198 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  ______                       _   _____                 _                                
+// |  ____|                     | | |  __ \               | |                               
+// | |__  __  ___ __   ___  _ __| |_| |__) | ___  __ _  __| | ___ _ __      ___ _ __  _ __  
+// |  __| \ \/ / '_ \ / _ \| '__| __|  _  / / _ \/ _` |/ _` |/ _ \ '__|    / __| '_ \| '_ \ 
+// | |____ >  <| |_) | (_) | |  | |_| | \ \|  __/ (_| | (_| |  __/ |    _ | (__| |_) | |_) |
+// |______/_/\_\ .__/ \___/|_|   \__|_|  \_\\___|\__,_|\__,_|\___|_|   (_) \___| .__/| .__/ 
+//             | |                                                             | |   | |    
+//             |_|                                                             |_|   |_|    
+//
+// Reads the frames the viewer exports (a test client for FrameExport)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// Usage: ExportReader [name] [seconds]
+//
+// Attaches to the frames a viewer built with USE_FRAME_EXPORT is publishing ('name' is the mapping's name, TMapViewerFrames by
+// default), and reads them as another process would: it takes the latest frame, copies its pixels out, and then validates it.  It
+// runs for 'seconds' (10 by default) and prints a line a second:
+//
+//   read    - frames copied out intact
+//   torn    - frames that were overwritten while they were being copied (validate() failed)
+//   dropped - frames that were published but never seen (the writer got more than one ahead between reads)
+//
+// A frame the reader has already seen isn't read again; it waits (spinning, with a Sleep(0)) for the next one.  If the viewer goes
+// away or is resized, the reader closes the mapping and attaches again (the frame count starts over, so no frames are counted as
+// dropped across it.)
+//
+// A reader that copies each frame out should see no torn frames at all (it has 'count' - 1 frames' time to do it); one that's
+// slower than the writer shows up as dropped frames.  The exit code is 1 if any frame was torn.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Counts
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	readerstats
+{
+	unsigned int	read;			// Frames copied out intact
+	unsigned int	torn;			// Frames overwritten as they were copied
+	unsigned int	dropped;		// Frames never seen
+	unsigned int	reopened;		// Times the writer went away (or resized) and we attached again
+} sREADERSTATS;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	printStats(const char *label, const sREADERSTATS &stats)
+{
+	unsigned int	seen = stats.read + stats.torn;
+	unsigned int	published = seen + stats.dropped;
+
+	printf("%-8s read %6u  torn %6u  dropped %6u  (%.2f%% torn, %.2f%% dropped)  reopened %u\n", label, stats.read, stats.torn,
+		stats.dropped, seen ? stats.torn * 100.0 / seen : 0.0, published ? stats.dropped * 100.0 / published : 0.0,
+		stats.reopened);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+int	main(int argc, char *argv[])
+{
+	if (!AfxWinInit(::GetModuleHandle(NULL), NULL, ::GetCommandLine(), 0)) return 1;
+
+	const	char	*name = argc > 1 ? argv[1] : "TMapViewerFrames";
+	double		duration = argc > 2 ? atof(argv[2]) : 10.0;
+	if (duration <= 0) duration = 10.0;
+
+	FrameExportReader	reader;
+	sREADERSTATS		total = {0, 0, 0, 0};
+	sREADERSTATS		second = {0, 0, 0, 0};
+	unsigned char		*copy = NULL;
+	unsigned int		copyBytes = 0;
+	LONG			lastSequence = 0;
+	bool			waiting = false;
+	double			start = seconds();
+	double			nextReport = start + 1.0;
+
+	printf("ExportReader: reading '%s' for %.0f seconds\n", name, duration);
+
+	for (;;)
+	{
+		double	now = seconds();
+		if (now - start >= duration) break;
+
+		if (now >= nextReport)
+		{
+			char	label[32];
+			sprintf(label, "%5.0fs", now - start);
+			printStats(label, second);
+
+			memset(&second, 0, sizeof(second));
+			nextReport += 1.0;
+		}
+
+		// Attach (again, if the writer went away or resized)
+
+		if (!reader.isOpen() || reader.header()->magic != frameExportMagic)
+		{
+			if (reader.isOpen())
+			{
+				reader.close();
+				total.reopened++;
+				second.reopened++;
+			}
+
+			if (!reader.open(name))
+			{
+				if (!waiting) printf("waiting for '%s'...\n", name);
+				waiting = true;
+				Sleep(100);
+				continue;
+			}
+
+			const	sFRAMEEXPORTHEADER	&header = *reader.header();
+			printf("attached: %ux%u, pitch %u, %s, %u buffers\n", header.width, header.height, header.pitch,
+				header.format == FRAME_EXPORT_RGB565 ? "5-6-5" : "XRGB 8888", header.count);
+
+			waiting = false;
+			lastSequence = 0;
+
+			if (header.bufferBytes > copyBytes)
+			{
+				delete[] copy;
+				copyBytes = header.bufferBytes;
+				copy = new unsigned char[copyBytes];
+			}
+		}
+
+		// The latest frame (if it's one we haven't seen)
+
+		LONG			sequence = 0;
+		unsigned int		index = 0;
+		const	unsigned char	*frame = reader.latest(sequence, index);
+
+		if (!frame || sequence == lastSequence)
+		{
+			Sleep(0);
+			continue;
+		}
+
+		// Copy it out, then make sure it wasn't overwritten while we did
+
+		const	sFRAMEEXPORTHEADER	&header = *reader.header();
+		memcpy(copy, frame, header.pitch * header.height);
+
+		if (reader.validate(index, sequence))
+		{
+			total.read++;
+			second.read++;
+		}
+		else
+		{
+			total.torn++;
+			second.torn++;
+		}
+
+		if (lastSequence && sequence > lastSequence + 1)
+		{
+			total.dropped += sequence - lastSequence - 1;
+			second.dropped += sequence - lastSequence - 1;
+		}
+
+		lastSequence = sequence;
+	}
+
+	printStats("total", total);
+
+	delete[] copy;
+	return total.torn != 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// ExportReader.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
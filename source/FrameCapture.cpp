@@ -0,0 +1,528 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  ______                          _____             _                                       
+// |  ____|                        / ____|           | |                                      
+// | |__  _ __ __ _ _ __ ___   ___| |      __ _ _ __ | |_ _   _ _ __ ___      ___ _ __  _ __  
+// |  __|| '__/ _` | '_ ` _ \ / _ \ |     / _` | '_ \| __| | | | '__/ _ \    / __| '_ \| '_ \ 
+// | |   | | | (_| | | | | | |  __/ |____| (_| | |_) | |_| |_| | | |  __/ _ | (__| |_) | |_) |
+// |_|   |_|  \__,_|_| |_| |_|\___|\_____|\__,_| .__/ \__|\__,_|_|  \___|(_) \___| .__/| .__/ 
+//                                             | |                               | |   | |    
+//                                             |_|                               |_|   |_|    
+//
+// Frame capture (recording frames to disk on a background thread)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// Capturing 1080p60 means writing ~500MB/s of 32-bit pixels (or ~190MB/s of Y4M), so the render loop must never wait on the
+// disk, or on the conversion.  submit() just copies the frame into a free slot of a bounded queue (a few milliseconds for a
+// 1080p frame) and returns; the capture thread does the rest.  If the disk can't keep up and the queue fills, submit() waits for
+// a slot rather than dropping the frame (a recording with holes in it is no use for regression review), and counts the stall.
+//
+// Files are opened with FILE_FLAG_NO_BUFFERING (the Win32 counterpart of O_DIRECT), so frames go straight from our buffers to
+// the disk, rather than through the file cache, where they'd push everything else out.  Unbuffered writes must be whole
+// sectors from sector-aligned memory, so output is staged into a page-aligned chunk, and only whole chunks are written until
+// the file is closed.  The file is extended a second's worth of frames ahead of the writes (extending it on every write
+// serializes them), then trimmed to the real length when it's closed.
+//
+// Y4M output is 4:2:0 with full-range BT.601 (the 'C420jpeg' tag): luma per pixel, chroma from the average of each 2x2 block.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <stdio.h>
+#include <process.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		FrameCapture::FrameCapture()
+		:_format(CAPTURE_RAW), _width(0), _height(0), _depth(32), _rate(60), _frameBytes(0), _slotCount(0), _head(0), _free(NULL),
+		 _queued(NULL), _thread(NULL), _quit(NULL), _converted(NULL), _file(INVALID_HANDLE_VALUE), _chunk(NULL), _chunkBytes(0),
+		 _length(0), _reserved(0)
+{
+	_filename[0] = 0;
+	_streamName[0] = 0;
+	memset(_slots, 0, sizeof(_slots));
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		FrameCapture::~FrameCapture()
+{
+	stop();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Picks the format from the file's extension (.y4m or .ppm, anything else is raw)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+CaptureFormat	FrameCapture::formatFromName(const char *filename)
+{
+	const	char	*ext = filename ? strrchr(filename, '.') : NULL;
+	if (!ext) return CAPTURE_RAW;
+	if (!stricmp(ext, ".y4m")) return CAPTURE_Y4M;
+	if (!stricmp(ext, ".ppm")) return CAPTURE_PPM;
+	return CAPTURE_RAW;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Starts capturing frames of 'width' x 'height' at 'depth' bits (32, or 16 for 5-6-5.)  For a PPM sequence, 'filename' is the
+// name of the first frame without its number (capture.ppm is written as capture_000001.ppm, capture_000002.ppm...)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		FrameCapture::start(const char *filename, const CaptureFormat format, const unsigned int width, const unsigned int height,
+				    const unsigned int depth, const unsigned int rate, const unsigned int queueDepth)
+{
+	stop();
+
+	if (!filename || strlen(filename) + 16 > MAX_PATH) return false;
+	if (!width || !height || (depth != 32 && depth != 16) || queueDepth < 2 || queueDepth > captureMaxQueue) return false;
+
+	_format = format;
+	_width = width;
+	_height = height;
+	_depth = depth;
+	_rate = rate ? rate : 60;
+	_frameBytes = width * height * (depth / 8);
+	_head = 0;
+	memset(&_stats, 0, sizeof(_stats));
+
+	// The name (without the extension, for a PPM sequence)
+
+	strcpy(_filename, filename);
+	if (format == CAPTURE_PPM)
+	{
+		char	*ext = strrchr(_filename, '.');
+		if (ext) *ext = 0;
+	}
+
+	// The queue, and the capture thread's buffers
+
+	bool	ok = true;
+	_slotCount = queueDepth;
+	for (unsigned int i = 0; i < _slotCount; i++)
+	{
+		// Touch each one now, so the render loop doesn't take the page faults
+
+		_slots[i] = (unsigned char *) poolAlloc(_frameBytes);
+		if (_slots[i]) memset(_slots[i], 0, _frameBytes);
+		else ok = false;
+	}
+
+	unsigned int	cw = (width + 1) / 2, ch = (height + 1) / 2;
+	if (format == CAPTURE_Y4M) _converted = (unsigned char *) poolAlloc(width * height + cw * ch * 2);
+	if (format == CAPTURE_PPM) _converted = (unsigned char *) poolAlloc(width * height * 3);
+	if (format != CAPTURE_RAW && !_converted) ok = false;
+
+	_chunk = (unsigned char *) VirtualAlloc(NULL, captureChunkBytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	if (!_chunk) ok = false;
+
+	// One file for the whole stream (a PPM sequence opens one per frame)
+
+	if (ok && format != CAPTURE_PPM)
+	{
+		ok = openStream(_filename);
+
+		if (ok && format == CAPTURE_Y4M)
+		{
+			char	header[128];
+			sprintf(header, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C420jpeg\n", width, height, _rate);
+			write(header, strlen(header));
+		}
+	}
+
+	// Start up
+
+	if (ok)
+	{
+		_free = CreateSemaphore(NULL, _slotCount, _slotCount, NULL);
+		_queued = CreateSemaphore(NULL, 0, _slotCount, NULL);
+		_quit = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+		unsigned int	id;
+		if (_free && _queued && _quit) _thread = (HANDLE) _beginthreadex(NULL, 0, captureThread, this, 0, &id);
+	}
+
+	if (!_thread)
+	{
+		stop();
+		return false;
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Writes whatever's still queued, then closes everything down
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		FrameCapture::stop()
+{
+	if (_thread)
+	{
+		SetEvent(_quit);
+		WaitForSingleObject(_thread, INFINITE);
+		CloseHandle(_thread);
+		_thread = NULL;
+	}
+
+	closeStream();
+
+	if (_free) CloseHandle(_free);
+	if (_queued) CloseHandle(_queued);
+	if (_quit) CloseHandle(_quit);
+	_free = NULL;
+	_queued = NULL;
+	_quit = NULL;
+
+	for (unsigned int i = 0; i < captureMaxQueue; i++)
+	{
+		poolFree(_slots[i]);
+		_slots[i] = NULL;
+	}
+
+	poolFree(_converted);
+	_converted = NULL;
+
+	if (_chunk) VirtualFree(_chunk, 0, MEM_RELEASE);
+	_chunk = NULL;
+	_slotCount = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Queues a frame ('pitch' is in pixels.)  This only waits if the queue is full.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		FrameCapture::submit(const void *frame, const unsigned int width, const unsigned int height, const unsigned int pitch)
+{
+	if (!_thread || !frame) return false;
+
+	// A stream can't change size part way through
+
+	if (width != _width || height != _height)
+	{
+		_stats.skipped++;
+		return false;
+	}
+
+	// Wait for a free slot (only when the disk is falling behind)
+
+	if (WaitForSingleObject(_free, 0) == WAIT_TIMEOUT)
+	{
+		_stats.stalls++;
+		WaitForSingleObject(_free, INFINITE);
+	}
+
+	// Copy the frame in (without the padding at the ends of the scanlines)
+
+	unsigned int		rowBytes = _width * (_depth / 8);
+	unsigned int		srcPitch = pitch * (_depth / 8);
+	const	unsigned char	*src = (const unsigned char *) frame;
+	unsigned char		*dst = _slots[_head];
+
+	for (unsigned int y = 0; y < _height; y++, src += srcPitch, dst += rowBytes)
+	{
+		memcpy(dst, src, rowBytes);
+	}
+
+	_head = (_head + 1) % _slotCount;
+	_stats.frames++;
+	ReleaseSemaphore(_queued, 1, NULL);
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned WINAPI	FrameCapture::captureThread(void *param)
+{
+	FrameCapture	&capture = *(FrameCapture *) param;
+	unsigned int	tail = 0;
+
+	#ifdef USE_TRACE
+	traceThreadName("capture");
+	#endif
+
+	// The quit event can't be a post to '_queued' (with every slot full, that's one more than it can count), so we wait on both.
+	// When both are signalled, WaitForMultipleObjects() takes the first, so everything that was queued gets written before we quit.
+
+	HANDLE		waits[2] = {capture._queued, capture._quit};
+
+	for(;;)
+	{
+		if (WaitForMultipleObjects(2, waits, FALSE, INFINITE) != WAIT_OBJECT_0) break;
+
+		capture.writeFrame(capture._slots[tail], capture._stats.written);
+		capture._stats.written++;
+
+		ReleaseSemaphore(capture._free, 1, NULL);
+		tail = (tail + 1) % capture._slotCount;
+	}
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Converts and writes a frame (on the capture thread)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		FrameCapture::writeFrame(const unsigned char *frame, const unsigned int index)
+{
+	TRACE_SCOPE("capture frame");
+
+	switch(_format)
+	{
+		case CAPTURE_RAW:
+			write(frame, _frameBytes);
+			break;
+
+		case CAPTURE_Y4M:
+		{
+			unsigned int	cw = (_width + 1) / 2, ch = (_height + 1) / 2;
+			convertY4M(frame);
+			write("FRAME\n", 6);
+			write(_converted, _width * _height + cw * ch * 2);
+			break;
+		}
+
+		case CAPTURE_PPM:
+		{
+			char	name[MAX_PATH];
+			sprintf(name, "%s_%06u.ppm", _filename, index + 1);
+			if (!openStream(name)) break;
+
+			char	header[64];
+			sprintf(header, "P6\n%u %u\n255\n", _width, _height);
+			convertPPM(frame);
+			write(header, strlen(header));
+			write(_converted, _width * _height * 3);
+			closeStream();
+			break;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns pixel 'x' of a scanline as ARGB
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+inline	unsigned int	FrameCapture::pixel(const unsigned char *row, const unsigned int x) const
+{
+	if (_depth == 16) return argbFrom565(((const unsigned short *) row)[x]);
+	return ((const unsigned int *) row)[x];
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	unsigned char	luma(const unsigned int c)
+{
+	return (unsigned char) ((((c >> 16) & 0xff) * 77 + ((c >> 8) & 0xff) * 150 + (c & 0xff) * 29 + 128) >> 8);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Converts a frame to planar 4:2:0 YCbCr (full-range BT.601, in 8.8 fixed point)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		FrameCapture::convertY4M(const unsigned char *frame)
+{
+	unsigned int	rowBytes = _width * (_depth / 8);
+	unsigned int	cw = (_width + 1) / 2, ch = (_height + 1) / 2;
+	unsigned char	*yPlane = _converted;
+	unsigned char	*uPlane = yPlane + _width * _height;
+	unsigned char	*vPlane = uPlane + cw * ch;
+
+	for (unsigned int cy = 0; cy < ch; cy++)
+	{
+		// The two scanlines this row of chroma covers (the last one twice, for an odd height)
+
+		unsigned int		y0 = cy * 2;
+		unsigned int		y1 = y0 + 1 < _height ? y0 + 1 : y0;
+		const	unsigned char	*row0 = frame + y0 * rowBytes;
+		const	unsigned char	*row1 = frame + y1 * rowBytes;
+
+		for (unsigned int cx = 0; cx < cw; cx++)
+		{
+			unsigned int	x0 = cx * 2;
+			unsigned int	x1 = x0 + 1 < _width ? x0 + 1 : x0;
+			unsigned int	quad[4];
+			quad[0] = pixel(row0, x0);
+			quad[1] = pixel(row0, x1);
+			quad[2] = pixel(row1, x0);
+			quad[3] = pixel(row1, x1);
+
+			// Luma for each pixel (rewriting the same one is harmless at the odd edges)
+
+			yPlane[y0 * _width + x0] = luma(quad[0]);
+			yPlane[y0 * _width + x1] = luma(quad[1]);
+			yPlane[y1 * _width + x0] = luma(quad[2]);
+			yPlane[y1 * _width + x1] = luma(quad[3]);
+
+			// Chroma from the block's average
+
+			int	r = 2, g = 2, b = 2;
+			for (unsigned int i = 0; i < 4; i++)
+			{
+				r += (quad[i] >> 16) & 0xff;
+				g += (quad[i] >> 8) & 0xff;
+				b += quad[i] & 0xff;
+			}
+
+			r >>= 2;
+			g >>= 2;
+			b >>= 2;
+
+			// Pure blue (or red) rounds up to 256
+
+			int	u = (-43 * r - 85 * g + 128 * b + 32768 + 128) >> 8;
+			int	v = (128 * r - 107 * g - 21 * b + 32768 + 128) >> 8;
+			uPlane[cy * cw + cx] = (unsigned char) (u > 255 ? 255 : u);
+			vPlane[cy * cw + cx] = (unsigned char) (v > 255 ? 255 : v);
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Converts a frame to packed 24-bit RGB
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		FrameCapture::convertPPM(const unsigned char *frame)
+{
+	unsigned int	rowBytes = _width * (_depth / 8);
+	unsigned char	*dst = _converted;
+
+	for (unsigned int y = 0; y < _height; y++, frame += rowBytes)
+	{
+		for (unsigned int x = 0; x < _width; x++, dst += 3)
+		{
+			unsigned int	c = pixel(frame, x);
+			dst[0] = (unsigned char) (c >> 16);
+			dst[1] = (unsigned char) (c >> 8);
+			dst[2] = (unsigned char) c;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		FrameCapture::openStream(const char *filename)
+{
+	closeStream();
+
+	_file = CreateFile(filename, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (_file == INVALID_HANDLE_VALUE)
+	{
+		_stats.errors++;
+		return false;
+	}
+
+	strcpy(_streamName, filename);
+	_chunkBytes = 0;
+	_length = 0;
+	_reserved = 0;
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Writes out the last (partial) chunk and trims the file to what was actually written
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		FrameCapture::closeStream()
+{
+	if (_file == INVALID_HANDLE_VALUE) return;
+
+	if (_chunkBytes) writeChunk();
+	CloseHandle(_file);
+	_file = INVALID_HANDLE_VALUE;
+
+	// An unbuffered handle can only be positioned on a sector, so trim it through a buffered one
+
+	HANDLE	file = CreateFile(_streamName, GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		_stats.errors++;
+		return;
+	}
+
+	LONG	high = (LONG) (_length >> 32);
+	SetFilePointer(file, (LONG) _length, &high, FILE_BEGIN);
+	SetEndOfFile(file);
+	CloseHandle(file);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Stages data for the current file
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		FrameCapture::write(const void *data, unsigned int bytes)
+{
+	if (_file == INVALID_HANDLE_VALUE) return;
+
+	const	unsigned char	*src = (const unsigned char *) data;
+
+	while(bytes)
+	{
+		unsigned int	count = captureChunkBytes - _chunkBytes;
+		if (count > bytes) count = bytes;
+
+		memcpy(_chunk + _chunkBytes, src, count);
+		_chunkBytes += count;
+		src += count;
+		bytes -= count;
+
+		if (_chunkBytes == captureChunkBytes) writeChunk();
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Writes the staged chunk.  Only the last chunk of a file is partial; it's padded out to a sector (and trimmed by closeStream())
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		FrameCapture::writeChunk()
+{
+	unsigned int	padded = (_chunkBytes + captureSectorBytes - 1) & ~(captureSectorBytes - 1);
+	memset(_chunk + _chunkBytes, 0, padded - _chunkBytes);
+
+	// Extend the file ahead of us (a second of frames for a stream, the rest of the frame for a PPM)
+
+	if (_length + padded > _reserved)
+	{
+		DWORDLONG	ahead = _format == CAPTURE_PPM ? (DWORDLONG) _width * _height * 3 + 64 : (DWORDLONG) _frameBytes * _rate;
+		_reserved = (_length + padded + ahead + captureChunkBytes - 1) / captureChunkBytes * captureChunkBytes;
+
+		LONG	high = (LONG) (_reserved >> 32);
+		SetFilePointer(_file, (LONG) _reserved, &high, FILE_BEGIN);
+		SetEndOfFile(_file);
+
+		high = (LONG) (_length >> 32);
+		SetFilePointer(_file, (LONG) _length, &high, FILE_BEGIN);
+	}
+
+	DWORD	written;
+	if (!WriteFile(_file, _chunk, padded, &written, NULL) || written != padded) _stats.errors++;
+
+	_length += _chunkBytes;
+	_stats.bytes += _chunkBytes;
+	_chunkBytes = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// FrameCapture.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,127 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  ______                          _____             _                      _     
+// |  ____|                        / ____|           | |                    | |    
+// | |__  _ __ __ _ _ __ ___   ___| |      __ _ _ __ | |_ _   _ _ __ ___    | |__  
+// |  __|| '__/ _` | '_ ` _ \ / _ \ |     / _` | '_ \| __| | | | '__/ _ \   | '_ \ 
+// | |   | | | (_| | | | | | |  __/ |____| (_| | |_) | |_| |_| | | |  __/ _ | | | |
+// |_|   |_|  \__,_|_| |_| |_|\___|\_____|\__,_| .__/ \__|\__,_|_|  \___|(_)|_| |_|
+//                                             | |                                 
+//                                             |_|                                 
+//
+// Frame capture (recording frames to disk on a background thread)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_FRAMECAPTURE
+#define	_H_FRAMECAPTURE
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned int	captureMaxQueue = 16;			// Most frames that can be waiting to be written
+const	unsigned int	captureSectorBytes = 4096;		// Unbuffered writes are multiples of this, at multiples of this
+const	unsigned int	captureChunkBytes = 4 * 1024 * 1024;	// ...and go out in chunks of this
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Output formats
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+enum	CaptureFormat
+{
+	CAPTURE_RAW,				// One file, the frames' pixels as they are, back to back
+	CAPTURE_Y4M,				// One file, YUV4MPEG2 (4:2:0, full range), for encoders
+	CAPTURE_PPM				// A file per frame (name_000001.ppm...), for looking at
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Capture statistics
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	capturestats
+{
+	unsigned int	frames;			// Frames submitted
+	unsigned int	written;		// ...of those, written out
+	unsigned int	stalls;			// Submits that had to wait for the disk (a full queue)
+	unsigned int	skipped;		// Frames that weren't the size the capture was started with
+	unsigned int	errors;			// Failed writes
+	DWORDLONG	bytes;			// Bytes written
+} sCAPTURESTATS;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The capture sink.  submit() copies the frame into a free slot and returns; the capture thread converts and writes it.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	FrameCapture
+{
+public:
+	// Construction/Destruction
+
+				FrameCapture();
+virtual				~FrameCapture();
+
+	// Accessors
+
+inline	const	bool		isCapturing() const {return _thread != NULL;}
+inline	const	sCAPTURESTATS	&stats() const {return _stats;}
+
+	// Utilitarian
+
+static		CaptureFormat	formatFromName(const char *filename);
+virtual		bool		start(const char *filename, const CaptureFormat format, const unsigned int width, const unsigned int height,
+				      const unsigned int depth, const unsigned int rate, const unsigned int queueDepth = 8);
+virtual		void		stop();
+virtual		bool		submit(const void *frame, const unsigned int width, const unsigned int height, const unsigned int pitch);
+
+private:
+static		unsigned WINAPI	captureThread(void *param);
+		void		writeFrame(const unsigned char *frame, const unsigned int index);
+		void		convertY4M(const unsigned char *frame);
+		void		convertPPM(const unsigned char *frame);
+		unsigned int	pixel(const unsigned char *row, const unsigned int x) const;
+		bool		openStream(const char *filename);
+		void		closeStream();
+		void		write(const void *data, unsigned int bytes);
+		void		writeChunk();
+
+		CaptureFormat	_format;
+		unsigned int	_width, _height;
+		unsigned int	_depth;			// Of the frames we're given (32, or 16 for 5-6-5)
+		unsigned int	_rate;			// Frames per second (for the Y4M header)
+		char		_filename[MAX_PATH];
+		unsigned int	_frameBytes;		// A frame in a slot (tightly packed scanlines)
+
+		unsigned char	*_slots[captureMaxQueue];
+		unsigned int	_slotCount;
+		unsigned int	_head;			// The next slot submit() fills
+		HANDLE		_free;			// Counts empty slots
+		HANDLE		_queued;		// Counts full ones
+		HANDLE		_thread;
+		HANDLE		_quit;			// Set by stop() (once the last frame's queued)
+
+		// The capture thread's
+
+		unsigned char	*_converted;		// A frame, converted to the output format
+		HANDLE		_file;
+		char		_streamName[MAX_PATH];
+		unsigned char	*_chunk;		// Sector-aligned staging for unbuffered writes
+		unsigned int	_chunkBytes;		// Bytes in it
+		DWORDLONG	_length;		// Bytes written to the current file
+		DWORDLONG	_reserved;		// How far the file has been extended ahead of us
+		sCAPTURESTATS	_stats;
+};
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// FrameCapture.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
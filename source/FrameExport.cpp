@@ -0,0 +1,262 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  ______                         ______                       _                        
+// |  ____|                       |  ____|                     | |                       
+// | |__  _ __ __ _ _ __ ___   ___| |__  __  ___ __   ___  _ __| |_      ___ _ __  _ __  
+// |  __|| '__/ _` | '_ ` _ \ / _ \  __| \ \/ / '_ \ / _ \| '__| __|    / __| '_ \| '_ \ 
+// | |   | | | (_| | | | | | |  __/ |____ >  <| |_) | (_) | |  | |_  _ | (__| |_) | |_) |
+// |_|   |_|  \__,_|_| |_| |_|\___|______/_/\_\ .__/ \___/|_|   \__|(_) \___| .__/| .__/ 
+//                                            | |                           | |   | |    
+//                                            |_|                           |_|   |_|    
+//
+// Frame export (finished frames in shared memory, for other processes to read in place)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// An encoder or compositor running in another process would otherwise have to read the frames back from the screen.  Instead,
+// the frame buffers themselves live in a named, pagefile-backed file mapping (the Win32 counterpart of shm_open + mmap), so the
+// renderer draws into memory that other processes map, and nothing is copied on either side.
+//
+// The mapping starts with a page-sized header (sFRAMEEXPORTHEADER) followed by the buffers, each starting on a page.  There are
+// no locks: the writer never waits for readers, and a reader detects a frame that was overwritten while it read it (see
+// FrameExportReader::validate()), so a reader that needs a frame intact copies it out (or finishes with it) within 'count' - 1
+// frames.  On x86, stores aren't reordered with other stores, so the flags are written with InterlockedExchange (a full
+// barrier) only where the order against the pixels matters.
+//
+// When the writer goes away (or the window is resized), it zeroes 'magic' first; readers should close and reopen.  A reader
+// that still has the old mapping open keeps it alive, so if it's too small for the new size, create() fails and the renderer
+// falls back to an ordinary frame buffer.
+//
+// The ExportReader tool is a reader to try it with: it attaches by name and reports the frames it read whole, tore and missed.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	unsigned int	alignUp(const unsigned int bytes)
+{
+	return (bytes + frameExportAlignment - 1) & ~(frameExportAlignment - 1);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// FrameExport
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		FrameExport::FrameExport()
+		:_mapping(NULL), _header(NULL), _current(0xffffffff), _next(0)
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		FrameExport::~FrameExport()
+{
+	destroy();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Creates (or re-creates) the named mapping with 'count' buffers of 'height' scanlines of 'pitch' bytes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		FrameExport::create(const char *name, const unsigned int width, const unsigned int height, const unsigned int pitch,
+				    const FrameExportFormat format, const unsigned int count)
+{
+	destroy();
+
+	if (!name || !width || !height || count < 2 || count > frameExportMaxBuffers) return false;
+
+	unsigned int	headerBytes = alignUp(sizeof(sFRAMEEXPORTHEADER));
+	unsigned int	bufferBytes = alignUp(pitch * height);
+	unsigned int	total = headerBytes + bufferBytes * count;
+
+	_mapping = CreateFileMapping(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, total, name);
+	if (!_mapping) return false;
+
+	// If a reader still holds an older (smaller) mapping by this name, we get that one back, and this fails
+
+	_header = (sFRAMEEXPORTHEADER *) MapViewOfFile(_mapping, FILE_MAP_ALL_ACCESS, 0, 0, total);
+	if (!_header)
+	{
+		destroy();
+		return false;
+	}
+
+	// Fill in the header (the magic goes last, so readers don't see a half-built one)
+
+	memset(_header, 0, headerBytes);
+	_header->version = frameExportVersion;
+	_header->headerBytes = headerBytes;
+	_header->width = width;
+	_header->height = height;
+	_header->pitch = pitch;
+	_header->format = format;
+	_header->count = count;
+	_header->bufferBytes = bufferBytes;
+	_header->latest = -1;
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		_header->buffers[i].offset = headerBytes + bufferBytes * i;
+	}
+
+	InterlockedExchange((LONG *) &_header->magic, frameExportMagic);
+
+	_current = 0xffffffff;
+	_next = 0;
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		FrameExport::destroy()
+{
+	if (_header)
+	{
+		// Tell readers we're gone
+
+		InterlockedExchange((LONG *) &_header->magic, 0);
+		UnmapViewOfFile(_header);
+	}
+
+	if (_mapping) CloseHandle(_mapping);
+
+	_mapping = NULL;
+	_header = NULL;
+	_current = 0xffffffff;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns the next buffer to draw into (it's no longer readable until it's published)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int	*FrameExport::acquire()
+{
+	if (!_header) return NULL;
+
+	_current = _next;
+	_next = (_next + 1) % _header->count;
+
+	sFRAMEEXPORTBUFFER	&buffer = _header->buffers[_current];
+	InterlockedExchange((LONG *) &buffer.ready, 0);
+	return (unsigned int *) ((unsigned char *) _header + buffer.offset);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Marks the acquired buffer as a finished frame
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		FrameExport::publish()
+{
+	if (!_header || _current == 0xffffffff) return;
+
+	sFRAMEEXPORTBUFFER	&buffer = _header->buffers[_current];
+	buffer.sequence = _header->frames + 1;
+	InterlockedExchange((LONG *) &buffer.ready, 1);
+
+	_header->frames = buffer.sequence;
+	_header->latest = _current;
+	_current = 0xffffffff;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// FrameExportReader
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		FrameExportReader::FrameExportReader()
+		:_mapping(NULL), _header(NULL)
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		FrameExportReader::~FrameExportReader()
+{
+	close();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		FrameExportReader::open(const char *name)
+{
+	close();
+
+	_mapping = OpenFileMapping(FILE_MAP_READ, FALSE, name);
+	if (!_mapping) return false;
+
+	// Map all of it (the size is whatever the writer made it)
+
+	_header = (sFRAMEEXPORTHEADER *) MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!_header || _header->magic != frameExportMagic || _header->version != frameExportVersion)
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		FrameExportReader::close()
+{
+	if (_header) UnmapViewOfFile(_header);
+	if (_mapping) CloseHandle(_mapping);
+
+	_mapping = NULL;
+	_header = NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns the most recent frame (in place), or NULL if there isn't one yet (or the writer has gone away.)  Once done with the
+// pixels, call validate() with the returned index and sequence to find out whether they were overwritten in the meantime.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned char	*FrameExportReader::latest(LONG &sequence, unsigned int &index) const
+{
+	if (!_header || _header->magic != frameExportMagic) return NULL;
+
+	LONG	latest = _header->latest;
+	if (latest < 0 || latest >= (LONG) _header->count) return NULL;
+
+	const	sFRAMEEXPORTBUFFER	&buffer = _header->buffers[latest];
+	sequence = buffer.sequence;
+	if (!buffer.ready) return NULL;
+
+	index = latest;
+	return (const unsigned char *) _header + buffer.offset;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		FrameExportReader::validate(const unsigned int index, const LONG sequence) const
+{
+	if (!_header || _header->magic != frameExportMagic || index >= _header->count) return false;
+
+	const	sFRAMEEXPORTBUFFER	&buffer = _header->buffers[index];
+	return buffer.ready && buffer.sequence == sequence;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// FrameExport.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,143 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  ______                         ______                       _       _     
+// |  ____|                       |  ____|                     | |     | |    
+// | |__  _ __ __ _ _ __ ___   ___| |__  __  ___ __   ___  _ __| |_    | |__  
+// |  __|| '__/ _` | '_ ` _ \ / _ \  __| \ \/ / '_ \ / _ \| '__| __|   | '_ \ 
+// | |   | | | (_| | | | | | |  __/ |____ >  <| |_) | (_) | |  | |_  _ | | | |
+// |_|   |_|  \__,_|_| |_| |_|\___|______/_/\_\ .__/ \___/|_|   \__|(_)|_| |_|
+//                                            | |                             
+//                                            |_|                             
+//
+// Frame export (finished frames in shared memory, for other processes to read in place)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_FRAMEEXPORT
+#define	_H_FRAMEEXPORT
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned int	frameExportMagic = 0x58455246;		// 'FREX'
+const	unsigned int	frameExportVersion = 1;
+const	unsigned int	frameExportMaxBuffers = 4;
+const	unsigned int	frameExportAlignment = 4096;		// The header and each buffer start on a page
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Pixel formats
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+enum	FrameExportFormat
+{
+	FRAME_EXPORT_XRGB8888,			// 32 bits per pixel, 0x00RRGGBB
+	FRAME_EXPORT_RGB565			// 16 bits per pixel
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The shared header (at the start of the mapping.)  Everything here is written by the renderer only.
+//
+// A buffer is stable while its 'ready' flag is set.  The writer clears it before drawing, sets 'sequence' and then sets it
+// again, so a reader that sees the same sequence, with 'ready' set, before and after reading the pixels knows that it read a
+// whole frame (see FrameExportReader::validate().)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	frameexportbuffer
+{
+	volatile LONG	ready;			// Non-zero when the buffer holds a finished frame
+	volatile LONG	sequence;		// The frame number it holds (1, 2, 3...)
+	unsigned int	offset;			// From the start of the mapping
+	unsigned int	reserved;
+} sFRAMEEXPORTBUFFER;
+
+typedef	struct	frameexportheader
+{
+	unsigned int	magic;
+	unsigned int	version;
+	unsigned int	headerBytes;
+	unsigned int	width, height;
+	unsigned int	pitch;			// In bytes
+	unsigned int	format;			// FrameExportFormat
+	unsigned int	count;			// Buffers in the ring
+	unsigned int	bufferBytes;
+	volatile LONG	latest;			// Index of the most recently finished buffer (-1 until the first frame)
+	volatile LONG	frames;			// Frames published
+	sFRAMEEXPORTBUFFER buffers[frameExportMaxBuffers];
+} sFRAMEEXPORTHEADER;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The writer side.  The renderer draws straight into the buffer from acquire() and publish()es it when done; buffers are used
+// round-robin, so a frame stays readable for 'count' - 1 frames after it's published.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	FrameExport
+{
+public:
+	// Construction/Destruction
+
+				FrameExport();
+virtual				~FrameExport();
+
+	// Accessors
+
+inline	const	bool		isValid() const {return _header != NULL;}
+inline	const	sFRAMEEXPORTHEADER *header() const {return _header;}
+
+	// Utilitarian
+
+virtual		bool		create(const char *name, const unsigned int width, const unsigned int height, const unsigned int pitch,
+					const FrameExportFormat format, const unsigned int count);
+virtual		void		destroy();
+virtual		unsigned int	*acquire();
+virtual		void		publish();
+
+private:
+		HANDLE			_mapping;
+		sFRAMEEXPORTHEADER	*_header;
+		unsigned int		_current;	// The buffer being drawn (or -1)
+		unsigned int		_next;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The reader side (for the process on the other end)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	FrameExportReader
+{
+public:
+	// Construction/Destruction
+
+				FrameExportReader();
+virtual				~FrameExportReader();
+
+	// Accessors
+
+inline	const	bool		isOpen() const {return _header != NULL;}
+inline	const	sFRAMEEXPORTHEADER *header() const {return _header;}
+
+	// Utilitarian
+
+virtual		bool		open(const char *name);
+virtual		void		close();
+virtual	const	unsigned char	*latest(LONG &sequence, unsigned int &index) const;
+virtual		bool		validate(const unsigned int index, const LONG sequence) const;
+
+private:
+		HANDLE			_mapping;
+		sFRAMEEXPORTHEADER	*_header;
+};
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// FrameExport.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
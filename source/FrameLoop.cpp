@@ -0,0 +1,220 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  ______                         _                                             
+// |  ____|                       | |                                            
+// | |__  _ __ __ _ _ __ ___   ___| |      ___   ___  _ __       ___ _ __  _ __  
+// |  __|| '__/ _` | '_ ` _ \ / _ \ |     / _ \ / _ \| '_ \     / __| '_ \| '_ \ 
+// | |   | | | (_| | | | | | |  __/ |____| (_) | (_) | |_) | _ | (__| |_) | |_) |
+// |_|   |_|  \__,_|_| |_| |_|\___|______|\___/ \___/| .__/ (_) \___| .__/| .__/ 
+//                                                   | |            | |   | |    
+//                                                   |_|            |_|   |_|    
+//
+// Fixed-timestep frame loop
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// The simulation advances in fixed steps, however fast (or slow) frames are drawn, so the animation runs at the same speed on
+// every machine and its results don't depend on the frame rate.  Time that isn't a whole step yet is carried over to the next
+// frame; the draw is given that remainder as a fraction of a step, to interpolate between the last two simulated states (so a
+// frame rate that isn't a multiple of the step rate doesn't judder.)  After a long stall (a breakpoint, a dragged window) the
+// loop takes a few steps and drops the rest, rather than spending the next several frames catching up.
+//
+// With a frame limit, tick() returns how long to wait until the next frame is due, and the host sleeps (Windows' sleeps are
+// only as fine as the timer resolution, so the host should raise it with timeBeginPeriod.)  Deadlines advance by whole
+// intervals, so sleeping late on one frame doesn't push back the ones after it; a frame that's later than a whole interval
+// starts the schedule over.  With vsync, the wait for the vertical blank does the pacing instead.
+//
+// Frame times are measured from the start of one frame to the start of the next, so they include the idle time, and are what the
+// user sees.  The percentiles are worked out when they're asked for, from a sorted copy of the history.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <stdlib.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The clock (in seconds, from an arbitrary start)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+double	seconds()
+{
+	static	double	scale = 0;
+	LARGE_INTEGER	t;
+
+	if (!scale)
+	{
+		QueryPerformanceFrequency(&t);
+		scale = 1.0 / (double) t.QuadPart;
+	}
+
+	QueryPerformanceCounter(&t);
+	return (double) t.QuadPart * scale;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	int	compareTimes(const void *a, const void *b)
+{
+	double	ta = *(const double *) a;
+	double	tb = *(const double *) b;
+	return ta < tb ? -1 : (ta > tb ? 1 : 0);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		FrameLoop::FrameLoop()
+		:_step(1.0 / 60.0), _interval(0), _simulate(NULL), _draw(NULL), _vsync(NULL), _context(NULL), _running(false),
+		_primed(false), _last(0), _next(0), _accumulator(0), _frames(0), _steps(0), _droppedSteps(0), _historyCount(0)
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		FrameLoop::~FrameLoop()
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Sets the simulation step (in seconds), the callbacks, and optionally a frame limit (in frames per second) or a vsync wait
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		FrameLoop::setup(const double step, SIMULATEPROC simulate, DRAWPROC draw, void *context, const double frameLimit,
+				 VSYNCPROC vsync)
+{
+	_step = step;
+	_simulate = simulate;
+	_draw = draw;
+	_context = context;
+	_interval = frameLimit > 0 ? 1.0 / frameLimit : 0;
+	_vsync = vsync;
+
+	_frames = 0;
+	_steps = 0;
+	_droppedSteps = 0;
+	_historyCount = 0;
+	reset();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Restarts the clock, so time spent not ticking (minimized, say) isn't simulated
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		FrameLoop::reset()
+{
+	_running = false;
+	_primed = false;
+	_accumulator = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Runs a frame, if one is due.  Returns how long the host can idle before the next one.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+double		FrameLoop::tick()
+{
+	double	now = seconds();
+
+	if (!_running)
+	{
+		_running = true;
+		_last = now;
+		_next = now;
+	}
+
+	if (_interval && now < _next) return _next - now;
+
+	// Time since the last frame
+
+	double	elapsed = now - _last;
+	_last = now;
+
+	// The first frame after a (re)start has nothing to be timed from
+
+	if (_primed)
+	{
+		_history[(_frames - 1) % HISTORY] = elapsed;
+		if (_historyCount < HISTORY) _historyCount++;
+	}
+
+	_primed = true;
+	_frames++;
+
+	// Simulate
+
+	_accumulator += elapsed;
+
+	if (_accumulator > _step * MAX_STEPS)
+	{
+		_droppedSteps += (unsigned int) (_accumulator / _step) - MAX_STEPS;
+		_accumulator = _step * MAX_STEPS;
+	}
+
+	while (_accumulator >= _step)
+	{
+		if (_simulate) _simulate(_context, _step);
+		_accumulator -= _step;
+		_steps++;
+	}
+
+	// Draw
+
+	if (_draw) _draw(_context, _accumulator / _step);
+	if (_vsync) _vsync(_context);
+
+	// Schedule the next one
+
+	if (!_interval) return 0;
+
+	_next += _interval;
+	double	after = seconds();
+	if (_next + _interval < after) _next = after;
+	return _next > after ? _next - after : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+sFRAMELOOPSTATS	FrameLoop::stats() const
+{
+	sFRAMELOOPSTATS	result;
+	memset(&result, 0, sizeof(result));
+
+	result.frames = _frames;
+	result.steps = _steps;
+	result.droppedSteps = _droppedSteps;
+	if (!_historyCount) return result;
+
+	double	sorted[HISTORY];
+	memcpy(sorted, _history, _historyCount * sizeof(double));
+	qsort(sorted, _historyCount, sizeof(double), compareTimes);
+
+	for (unsigned int i = 0; i < _historyCount; i++) result.average += sorted[i];
+	result.average /= _historyCount;
+
+	result.p50 = sorted[(unsigned int) ((_historyCount - 1) * 0.50 + 0.5)];
+	result.p99 = sorted[(unsigned int) ((_historyCount - 1) * 0.99 + 0.5)];
+	result.max = sorted[_historyCount - 1];
+	return result;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// FrameLoop.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
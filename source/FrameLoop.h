@@ -0,0 +1,127 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  ______                         _                            _     
+// |  ____|                       | |                          | |    
+// | |__  _ __ __ _ _ __ ___   ___| |      ___   ___  _ __     | |__  
+// |  __|| '__/ _` | '_ ` _ \ / _ \ |     / _ \ / _ \| '_ \    | '_ \ 
+// | |   | | | (_| | | | | | |  __/ |____| (_) | (_) | |_) | _ | | | |
+// |_|   |_|  \__,_|_| |_| |_|\___|______|\___/ \___/| .__/ (_)|_| |_|
+//                                                   | |              
+//                                                   |_|              
+//
+// Fixed-timestep frame loop
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_FRAMELOOP
+#define	_H_FRAMELOOP
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Callbacks: advance the simulation by one step (in seconds), draw a frame (alpha is how far we are between the last two steps,
+// from 0 to 1), and wait for the vertical blank
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	void	(*SIMULATEPROC)(void *context, const double step);
+typedef	void	(*DRAWPROC)(void *context, const double alpha);
+typedef	void	(*VSYNCPROC)(void *context);
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Statistics (frame times are in seconds, and cover the last few hundred frames)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	frameloopstats
+{
+	unsigned int	frames;
+	unsigned int	steps;			// Simulation steps taken
+	unsigned int	droppedSteps;		// ...and skipped, when the loop fell too far behind to catch up
+	double		average;
+	double		p50;
+	double		p99;
+	double		max;
+} sFRAMELOOPSTATS;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The loop.  The host calls tick() whenever it's free, and idles for as long as it returns (in seconds) before calling it again.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	FrameLoop
+{
+public:
+	// Construction/Destruction
+
+				FrameLoop();
+virtual				~FrameLoop();
+
+	// Accessors
+
+inline	const	double		&step() const {return _step;}
+inline	const	double		&interval() const {return _interval;}
+
+	// Utilitarian
+
+virtual		void		setup(const double step, SIMULATEPROC simulate, DRAWPROC draw, void *context,
+				      const double frameLimit = 0, VSYNCPROC vsync = NULL);
+virtual		void		reset();
+virtual		double		tick();
+virtual		sFRAMELOOPSTATS	stats() const;
+
+private:
+	enum	{HISTORY = 512};		// Frame times kept for the percentiles
+	enum	{MAX_STEPS = 8};		// Steps per frame before the loop gives up catching up
+
+		double		_step;
+		double		_interval;		// Minimum time between frames (0 if there's no limit)
+		SIMULATEPROC	_simulate;
+		DRAWPROC	_draw;
+		VSYNCPROC	_vsync;
+		void		*_context;
+		bool		_running;
+		bool		_primed;		// There's been a frame since the clock (re)started, so the next one can be timed
+		double		_last;			// When the last frame started
+		double		_next;			// When the next one is due (with a limit)
+		double		_accumulator;		// Time not yet simulated
+		unsigned int	_frames;
+		unsigned int	_steps;
+		unsigned int	_droppedSteps;
+		double		_history[HISTORY];
+		unsigned int	_historyCount;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+double	seconds();
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The processor's time stamp counter (cheaper to read than seconds(), but at an unknown rate; see Profile.cpp)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef	_MSC_VER
+#pragma warning(disable:4035)			// No return value (it's left in edx:eax)
+inline	unsigned __int64	readTicks()
+{
+	__asm	_emit	0x0f			// rdtsc
+	__asm	_emit	0x31
+}
+#pragma warning(default:4035)
+#else
+inline	unsigned __int64	readTicks()
+{
+	return __builtin_ia32_rdtsc();
+}
+#endif
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// FrameLoop.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,486 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//   _____       _     _                                 
+//  / ____|     | |   | |                                
+// | |  __  ___ | | __| | ___ _ __       ___ _ __  _ __  
+// | | |_ |/ _ \| |/ _` |/ _ \ '_ \     / __| '_ \| '_ \ 
+// | |__| | (_) | | (_| |  __/ | | | _ | (__| |_) | |_) |
+//  \_____|\___/|_|\__,_|\___|_| |_|(_) \___| .__/| .__/ 
+//                                          | |   | |    
+//                                          |_|   |_|    
+//
+// Golden-image and speed regression checks
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// Usage: Golden [directory] [record | percent]
+//
+// Draws the viewer's scene (see Scene.cpp) without a window, at a few fixed angles, with every mapper and texture format this build
+// has, and compares each frame with a golden image in 'directory' ("golden" by default.)  Then it times each scene and compares the
+// speed with a baseline kept in the same directory.  It fails (the exit code is 1) if any frame differs from its golden image by a
+// single bit, or if the scenes together draw more than 'percent' (10 by default) fewer frames per second than the baseline.
+//
+// 'record' writes new golden images and a new baseline.  Without it, a missing golden image fails (so a check can't pass by
+// recording what it was meant to check), and a missing baseline means the speed isn't compared.  The golden images for the default
+// configuration are checked in, in source\golden; the baseline isn't (see below.)
+//
+// The images are BMPs (32-bit, or 5-6-5 for the 16-bit mapper) holding every bit of the frame buffer, including the top byte that
+// BLEND_ADD carries into.  When a frame doesn't match, the frame that was drawn is written next to the golden image, with -actual
+// added to its name.
+//
+// The golden images belong to a build configuration (they're drawn with this project's TMap.h), so keep a directory for each
+// configuration that's checked.  The baseline belongs to a machine: it names the processor it was timed on, and a baseline from
+// another kind of machine isn't compared against (record one for this machine.)  Each scene is timed over a number of passes, and
+// the best pass counts, which keeps the noise down to a few percent on an idle machine.
+//
+// The Golden project runs this after every Release build, so a change that alters what the mappers draw, or slows them down, fails
+// the build.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	unsigned int	goldenWidth = 640;
+static	const	unsigned int	goldenHeight = 480;
+static	const	unsigned int	goldenFrames = 50;		// Per scene, per timing pass (cycling through the angles)
+static	const	unsigned int	goldenPasses = 20;		// The best one counts
+static	const	double		goldenSlowdown = 10.0;		// Percent (unless one is given)
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The scenes: each mapper the build has, and the sub-affine mapper with each texture format
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+enum	GoldenMapper
+{
+	GOLDEN_AFFINE,
+	GOLDEN_PERSPECTIVE,
+	GOLDEN_SUB_AFFINE,
+	GOLDEN_SUB_AFFINE_16			// Into a 16-bit (5-6-5) frame
+};
+
+typedef	struct	goldenscene
+{
+	const	char		*name;
+	GoldenMapper		mapper;
+	TextureFormat		format;
+} sGOLDENSCENE;
+
+static	const	sGOLDENSCENE	scenes[] =
+{
+	#ifdef USE_AFFINE
+	{"affine",		GOLDEN_AFFINE,		TF_ARGB32}
+	#else
+	{"perspective",		GOLDEN_PERSPECTIVE,	TF_ARGB32},
+	{"sub-affine",		GOLDEN_SUB_AFFINE,	TF_ARGB32},
+	{"sub-affine-pal8",	GOLDEN_SUB_AFFINE,	TF_PAL8},
+	{"sub-affine-bc1",	GOLDEN_SUB_AFFINE,	TF_BC1},
+	{"sub-affine-565",	GOLDEN_SUB_AFFINE,	TF_RGB565},
+	{"sub-affine-16",	GOLDEN_SUB_AFFINE_16,	TF_RGB565}
+	#endif
+};
+
+static	const	unsigned int	sceneCount = sizeof(scenes) / sizeof(scenes[0]);
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The angles the scene is drawn at (in radians; chosen so that edges cross the pixel grid at a few different slopes)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	double		angles[] = {0.0, 0.35, 1.2, 2.5};
+static	const	unsigned int	angleCount = sizeof(angles) / sizeof(angles[0]);
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The scene's vertices, and a texture in each format
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	sVERT		vertices[sceneVertices];
+static	sTEXTURE	textures[sceneCount];
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Draws a scene at an angle into a cleared frame (of goldenWidth x goldenHeight pixels, with no padding)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	drawGolden(const unsigned int scene, unsigned int *frame, const double angle)
+{
+	const	sGOLDENSCENE	&s = scenes[scene];
+
+	if (s.mapper == GOLDEN_SUB_AFFINE_16)	memset(frame, 0, goldenWidth * goldenHeight * sizeof(unsigned short));
+	else					clearBuffer(frame, goldenWidth * goldenHeight, 0);
+
+	bindTexture(s.format == TF_ARGB32 ? NULL : &textures[scene]);
+
+	sSCENETRANSFORM	transform;
+	sVERT		transformed[sceneVertices];
+	setupSceneTransform(transform, goldenWidth, goldenHeight, angle, angle, (float) textureWidth, (float) textureHeight);
+	transformSceneVertices(transform, vertices, transformed, sceneVertices);
+
+	for (unsigned int i = 0; i < scenePolygons; i++)
+	{
+		sVERT	poly[sceneVerts];
+		indexScenePolygon(transformed, sceneIndices[i], sceneVerts, poly);
+
+		switch(s.mapper)
+		{
+			case GOLDEN_AFFINE:		drawAffineTexturedPolygon(poly, frame, goldenWidth); break;
+			case GOLDEN_PERSPECTIVE:	drawPerspectiveTexturedPolygon(poly, frame, goldenWidth); break;
+			case GOLDEN_SUB_AFFINE:		drawSubPerspectiveTexturedPolygon(poly, frame, goldenWidth); break;
+			case GOLDEN_SUB_AFFINE_16:	drawSubPerspectiveTexturedPolygon16(poly, (unsigned short *) frame, goldenWidth); break;
+		}
+	}
+
+	bindTexture(NULL);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Golden images (top-down BMPs; the 16-bit ones use bit fields to say they're 5-6-5)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	DWORD	masks565[3] = {0xf800, 0x07e0, 0x001f};
+
+static	unsigned int	bitmapBytes(const unsigned int depth)
+{
+	return goldenWidth * goldenHeight * depth / 8;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	bitmapHeaders(BITMAPFILEHEADER &file, BITMAPINFOHEADER &info, const unsigned int depth)
+{
+	unsigned int	headerBytes = sizeof(BITMAPFILEHEADER) + sizeof(BITMAPINFOHEADER) + (depth == 16 ? sizeof(masks565) : 0);
+
+	memset(&file, 0, sizeof(file));
+	file.bfType = 0x4d42;			// "BM"
+	file.bfSize = headerBytes + bitmapBytes(depth);
+	file.bfOffBits = headerBytes;
+
+	memset(&info, 0, sizeof(info));
+	info.biSize = sizeof(BITMAPINFOHEADER);
+	info.biWidth = goldenWidth;
+	info.biHeight = -(LONG) goldenHeight;	// Top-down
+	info.biPlanes = 1;
+	info.biBitCount = (WORD) depth;
+	info.biCompression = depth == 16 ? BI_BITFIELDS : BI_RGB;
+	info.biSizeImage = bitmapBytes(depth);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	bool	writeBitmap(const char *filename, const unsigned int *frame, const unsigned int depth)
+{
+	BITMAPFILEHEADER	file;
+	BITMAPINFOHEADER	info;
+	bitmapHeaders(file, info, depth);
+
+	FILE	*fp = fopen(filename, "wb");
+	if (!fp) return false;
+
+	bool	ok = fwrite(&file, sizeof(file), 1, fp) == 1 && fwrite(&info, sizeof(info), 1, fp) == 1;
+	if (ok && depth == 16) ok = fwrite(masks565, sizeof(masks565), 1, fp) == 1;
+	if (ok) ok = fwrite(frame, bitmapBytes(depth), 1, fp) == 1;
+
+	fclose(fp);
+	return ok;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Reads a golden image written by writeBitmap (false if it's missing, or isn't one)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	bool	readBitmap(const char *filename, unsigned int *frame, const unsigned int depth)
+{
+	BITMAPFILEHEADER	file, expectedFile;
+	BITMAPINFOHEADER	info, expectedInfo;
+	DWORD			masks[3];
+	bitmapHeaders(expectedFile, expectedInfo, depth);
+
+	FILE	*fp = fopen(filename, "rb");
+	if (!fp) return false;
+
+	bool	ok = fread(&file, sizeof(file), 1, fp) == 1 && fread(&info, sizeof(info), 1, fp) == 1 &&
+		     !memcmp(&file, &expectedFile, sizeof(file)) && !memcmp(&info, &expectedInfo, sizeof(info));
+	if (ok && depth == 16) ok = fread(masks, sizeof(masks), 1, fp) == 1 && !memcmp(masks, masks565, sizeof(masks));
+	if (ok) ok = fread(frame, bitmapBytes(depth), 1, fp) == 1;
+
+	fclose(fp);
+	return ok;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The machine the baseline was timed on
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	machineName(char *name, const unsigned int size)
+{
+	SYSTEM_INFO	si;
+	GetSystemInfo(&si);
+
+	const	char	*processor = getenv("PROCESSOR_IDENTIFIER");
+	if (!processor) processor = "unknown processor";
+
+	_snprintf(name, size - 1, "%s, %u processors", processor, (unsigned int) si.dwNumberOfProcessors);
+	name[size - 1] = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The baseline is text: the machine on the first line, then a scene's name and its time (milliseconds per frame) on each line
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	bool	readBaseline(const char *filename, char *machine, const unsigned int size, double *times)
+{
+	FILE	*fp = fopen(filename, "r");
+	if (!fp) return false;
+
+	char	line[256];
+	bool	ok = fgets(line, sizeof(line), fp) && !strncmp(line, "machine ", 8);
+
+	if (ok)
+	{
+		strncpy(machine, line + 8, size - 1);
+		machine[size - 1] = 0;
+		char	*end = strchr(machine, '\n');
+		if (end) *end = 0;
+	}
+
+	for (unsigned int i = 0; i < sceneCount; i++) times[i] = 0;
+
+	while(ok && fgets(line, sizeof(line), fp))
+	{
+		char	name[64];
+		double	time;
+		if (sscanf(line, "%63s %lf", name, &time) != 2) continue;
+
+		for (unsigned int j = 0; j < sceneCount; j++)
+		{
+			if (!strcmp(name, scenes[j].name)) times[j] = time;
+		}
+	}
+
+	fclose(fp);
+	return ok;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	bool	writeBaseline(const char *filename, const char *machine, const double *times)
+{
+	FILE	*fp = fopen(filename, "w");
+	if (!fp) return false;
+
+	fprintf(fp, "machine %s\n", machine);
+	for (unsigned int i = 0; i < sceneCount; i++) fprintf(fp, "%s %.6f\n", scenes[i].name, times[i]);
+
+	return fclose(fp) == 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+int	main(int argc, char *argv[])
+{
+	if (!AfxWinInit(::GetModuleHandle(NULL), NULL, ::GetCommandLine(), 0)) return 1;
+
+	const	char	*directory = argc > 1 ? argv[1] : "golden";
+	bool		record = argc > 2 && !stricmp(argv[2], "record");
+	double		slowdown = argc > 2 && !record ? atof(argv[2]) : goldenSlowdown;
+
+	if (slowdown <= 0 || slowdown >= 100)
+	{
+		fprintf(stderr, "Usage: Golden [directory] [record | percent]\n");
+		return 1;
+	}
+
+	if (record) CreateDirectory(directory, NULL);
+
+	// The scene, and the texture in each format
+
+	drawTexture();
+	buildScene(vertices);
+
+	unsigned int	i, j;
+
+	for (i = 0; i < sceneCount; i++)
+	{
+		if (scenes[i].format != TF_ARGB32)
+		{
+			createTexture(textures[i], scenes[i].format, defaultTexture().argb, textureWidth, textureHeight);
+		}
+	}
+
+	unsigned int	*frame = new unsigned int[goldenWidth * goldenHeight];
+	unsigned int	*golden = new unsigned int[goldenWidth * goldenHeight];
+	unsigned int	failed = 0;
+	char		filename[_MAX_PATH];
+
+	// The images
+
+	for (i = 0; i < sceneCount; i++)
+	{
+		unsigned int	depth = scenes[i].mapper == GOLDEN_SUB_AFFINE_16 ? 16 : 32;
+
+		for (j = 0; j < angleCount; j++)
+		{
+			drawGolden(i, frame, angles[j]);
+
+			_snprintf(filename, sizeof(filename) - 1, "%s\\%s-%.2f.bmp", directory, scenes[i].name, angles[j]);
+			filename[sizeof(filename) - 1] = 0;
+			printf("%-20s %.2f  ", scenes[i].name, angles[j]);
+
+			if (record)
+			{
+				bool	written = writeBitmap(filename, frame, depth);
+				printf("%s\n", written ? "recorded" : "can't write the golden image");
+				if (!written) failed++;
+				continue;
+			}
+
+			if (!readBitmap(filename, golden, depth))
+			{
+				printf("FAILED: no golden image (run with 'record' to record one)\n");
+				failed++;
+				continue;
+			}
+
+			// Count the pixels that differ (and find the first)
+
+			unsigned int	differ = 0, first = 0;
+
+			if (depth == 16)
+			{
+				const	unsigned short	*a = (const unsigned short *) frame;
+				const	unsigned short	*b = (const unsigned short *) golden;
+				for (unsigned int p = 0; p < goldenWidth * goldenHeight; p++) if (a[p] != b[p] && !differ++) first = p;
+			}
+			else
+			{
+				for (unsigned int p = 0; p < goldenWidth * goldenHeight; p++) if (frame[p] != golden[p] && !differ++) first = p;
+			}
+
+			if (!differ)
+			{
+				printf("ok\n");
+				continue;
+			}
+
+			printf("FAILED: %u pixels differ, the first at (%u, %u)\n", differ, first % goldenWidth, first / goldenWidth);
+			failed++;
+
+			_snprintf(filename, sizeof(filename) - 1, "%s\\%s-%.2f-actual.bmp", directory, scenes[i].name, angles[j]);
+			filename[sizeof(filename) - 1] = 0;
+			writeBitmap(filename, frame, depth);
+		}
+	}
+
+	// The speed (milliseconds per frame, the best of a few passes).  The scenes take turns within each pass, so a busy moment on the
+	// machine doesn't land on one scene's every pass.
+
+	double	times[sceneCount], baseline[sceneCount];
+	double	baselineTotal = 0;
+	char	machine[256], baselineMachine[256];
+
+	machineName(machine, sizeof(machine));
+
+	for (unsigned int pass = 0; pass < goldenPasses; pass++)
+	{
+		for (i = 0; i < sceneCount; i++)
+		{
+			double	start = seconds();
+			for (j = 0; j < goldenFrames; j++) drawGolden(i, frame, angles[j % angleCount]);
+			double	elapsed = (seconds() - start) * 1000.0 / goldenFrames;
+
+			if (!pass || elapsed < times[i]) times[i] = elapsed;
+		}
+	}
+
+	_snprintf(filename, sizeof(filename) - 1, "%s\\baseline.txt", directory);
+	filename[sizeof(filename) - 1] = 0;
+
+	bool	compare = !record && readBaseline(filename, baselineMachine, sizeof(baselineMachine), baseline);
+
+	if (!record && !compare)
+	{
+		printf("\nThere's no baseline (run with 'record' to time one on this machine), so the speed isn't compared\n");
+		for (i = 0; i < sceneCount; i++) printf("%-20s %8.4fms per frame\n", scenes[i].name, times[i]);
+	}
+	else if (compare && strcmp(machine, baselineMachine))
+	{
+		printf("\nThe baseline was timed on a different machine (%s), so the speed isn't compared\n", baselineMachine);
+	}
+	else if (!compare)
+	{
+		bool	written = writeBaseline(filename, machine, times);
+		printf("\n%s (%s)\n", written ? "Recorded the baseline" : "Can't write the baseline", machine);
+		if (!written) failed++;
+
+		for (i = 0; i < sceneCount; i++) printf("%-20s %8.4fms per frame\n", scenes[i].name, times[i]);
+	}
+	else
+	{
+		printf("\n");
+
+		for (i = 0; i < sceneCount; i++)
+		{
+			if (baseline[i] <= 0)
+			{
+				printf("%-20s %8.4fms per frame (not in the baseline)\n", scenes[i].name, times[i]);
+				continue;
+			}
+
+			baselineTotal += baseline[i];
+			printf("%-20s %8.4fms per frame (baseline %.4fms, %+.1f%%)\n", scenes[i].name, times[i], baseline[i],
+				(times[i] / baseline[i] - 1.0) * 100.0);
+		}
+
+		// Throughput (frames per second, over every scene in the baseline)
+
+		double	measured = 0;
+		for (i = 0; i < sceneCount; i++) if (baseline[i] > 0) measured += times[i];
+
+		if (baselineTotal > 0 && measured > 0)
+		{
+			double	change = (baselineTotal / measured - 1.0) * 100.0;
+			bool	slow = change < -slowdown;
+
+			printf("throughput %+.1f%% against the baseline (the limit is -%.1f%%): %s\n", change, slowdown, slow ? "FAILED" : "ok");
+			if (slow) failed++;
+		}
+	}
+
+	for (i = 0; i < sceneCount; i++)
+	{
+		if (scenes[i].format != TF_ARGB32) destroyTexture(textures[i]);
+	}
+
+	delete[] frame;
+	delete[] golden;
+
+	printf("\n%s\n", failed ? "FAILED" : "passed");
+	return failed ? 1 : 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Golden.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
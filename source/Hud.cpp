@@ -0,0 +1,295 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _    _           _                      
+// | |  | |         | |                     
+// | |__| |_   _  __| |     ___ _ __  _ __  
+// |  __  | | | |/ _` |    / __| '_ \| '_ \ 
+// | |  | | |_| | (_| | _ | (__| |_) | |_) |
+// |_|  |_|\__,_|\__,_|(_) \___| .__/| .__/ 
+//                             | |   | |    
+//                             |_|   |_|    
+//
+// On-screen performance HUD
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// The HUD is drawn into the frame buffer after the scene (and after any scaling), so it's in whatever gets presented, captured or
+// exported.  It's meant to be cheap enough to leave on: the panel is darkened and the bars are filled four pixels at a time with
+// SSE2, and the text is a 3x5 bitmap font (drawn at double size) with one 16-bit word per glyph.
+//
+// The frame time is measured from one draw to the next, so it's the frame time the user sees (idle time included), not just the
+// time spent rendering.  The counts come from the profile counters (see Profile.cpp), so they're only shown with USE_PROFILE, and
+// they're the previous frame's (this one isn't finished yet.)
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <stdio.h>
+
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The font: 3x5 glyphs for ' ' through 'Z' (lower case is drawn as upper case.)  Each glyph's rows are 3 bits each, top row in
+// the high bits, left column in the high bit of each row.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	unsigned short	font[] =
+{
+	0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x52a5, 0x0000, 0x0000,		// space - '
+	0x2922, 0x224a, 0x0000, 0x05d0, 0x0014, 0x01c0, 0x0002, 0x12a4,		// ( - /
+	0x7b6f, 0x2c97, 0x73e7, 0x72cf, 0x5bc9, 0x79cf, 0x79ef, 0x7292,		// 0 - 7
+	0x7bef, 0x7bcf, 0x0410, 0x0000, 0x0000, 0x0e38, 0x0000, 0x0000,		// 8 - ?
+	0x0000, 0x2bed, 0x6bae, 0x3923, 0x6b6e, 0x79a7, 0x79a4, 0x396b,		// @ - G
+	0x5bed, 0x7497, 0x126a, 0x5bad, 0x4927, 0x5fed, 0x6b6d, 0x2b6a,		// H - O
+	0x6ba4, 0x2b73, 0x6bad, 0x388e, 0x7492, 0x5b6f, 0x5b6a, 0x5bfd,		// P - W
+	0x5aad, 0x5a92, 0x72a7,		// X - Z
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Layout (in pixels)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	int		glyphScale = 2;
+static	const	int		cellWidth = 4 * glyphScale;
+static	const	int		lineHeight = 6 * glyphScale;
+static	const	int		margin = 4;
+static	const	int		barWidth = 2;
+static	const	int		graphHeight = 40;
+static	const	double		graphRange = 0.050;		// Frame time at the top of the graph (in seconds)
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Colors
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	unsigned int	textColor = 0xffffff;
+static	const	unsigned int	gridColor = 0x808080;
+static	const	unsigned int	fastColor = 0x40ff40;		// Within 60 fps
+static	const	unsigned int	slowColor = 0xffff40;		// Within 30
+static	const	unsigned int	lateColor = 0xff4040;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	fillRect(unsigned int *buffer, const unsigned int pitch, const int x, const int y, const int w, const int h,
+			 const unsigned int color)
+{
+	unsigned int	*row = buffer + y * pitch + x;
+
+	#ifdef USE_SSE2
+	__m128i		c = _mm_set1_epi32(color);
+	#endif
+
+	for (int j = 0; j < h; j++, row += pitch)
+	{
+		int	i = 0;
+
+		#ifdef USE_SSE2
+		for (; i + 4 <= w; i += 4) _mm_storeu_si128((__m128i *) (row + i), c);
+		#endif
+
+		for (; i < w; i++) row[i] = color;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Halves the brightness of a rectangle (the HUD's background)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	dimRect(unsigned int *buffer, const unsigned int pitch, const CRect &rect)
+{
+	unsigned int	*row = buffer + rect.top * pitch + rect.left;
+	int		w = rect.Width();
+
+	#ifdef USE_SSE2
+	__m128i		mask = _mm_set1_epi32(0x7f7f7f7f);
+	#endif
+
+	for (int j = rect.top; j < rect.bottom; j++, row += pitch)
+	{
+		int	i = 0;
+
+		#ifdef USE_SSE2
+		for (; i + 4 <= w; i += 4)
+		{
+			__m128i	p = _mm_loadu_si128((const __m128i *) (row + i));
+			_mm_storeu_si128((__m128i *) (row + i), _mm_and_si128(_mm_srli_epi32(p, 1), mask));
+		}
+		#endif
+
+		for (; i < w; i++) row[i] = (row[i] >> 1) & 0x7f7f7f7f;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Draws a string, stopping at 'right'
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	drawText(unsigned int *buffer, const unsigned int pitch, int x, const int y, const int right, const char *text,
+			 const unsigned int color)
+{
+	for (; *text && x + cellWidth <= right; text++, x += cellWidth)
+	{
+		int	c = *text;
+		if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+		if (c < ' ' || c > 'Z') continue;
+
+		unsigned short	glyph = font[c - ' '];
+		unsigned int	*dst = buffer + y * pitch + x;
+
+		for (int row = 0; row < 5; row++, dst += pitch * glyphScale)
+		{
+			unsigned int	bits = (glyph >> (12 - row * 3)) & 7;
+
+			for (int col = 0; col < 3; col++)
+			{
+				if (!(bits & (4 >> col))) continue;
+
+				unsigned int	*p = dst + col * glyphScale;
+				for (int sy = 0; sy < glyphScale; sy++, p += pitch)
+				{
+					for (int sx = 0; sx < glyphScale; sx++) p[sx] = color;
+				}
+			}
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		Hud::Hud()
+		:_count(0), _last(0)
+{
+	memset(_history, 0, sizeof(_history));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		Hud::~Hud()
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Draws the HUD in the upper-left of a 32-bit buffer (pitch is in pixels.)  Returns where it drew (empty if it didn't fit.)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+CRect		Hud::draw(unsigned int *buffer, const unsigned int width, const unsigned int height, const unsigned int pitch,
+			  const char *mapper)
+{
+	// Time since the last frame
+
+	double	now = seconds();
+
+	if (_last)
+	{
+		_history[_count % HISTORY] = now - _last;
+		_count++;
+	}
+
+	_last = now;
+
+	// The panel
+
+	#ifdef USE_PROFILE
+	const	int	lines = 6;
+	#else
+	const	int	lines = 3;
+	#endif
+
+	CRect	panel(8, 8, 8 + HISTORY * barWidth + margin * 2, 8 + lines * lineHeight + graphHeight + margin * 3);
+	if (!buffer || panel.right > (int) width || panel.bottom > (int) height) return CRect(0, 0, 0, 0);
+
+	dimRect(buffer, pitch, panel);
+
+	// Frame times over the graph
+
+	unsigned int	count = _count < HISTORY ? _count : HISTORY;
+	double		latest = count ? _history[(_count - 1) % HISTORY] : 0;
+	double		average = 0, longest = 0;
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		average += _history[i];
+		if (_history[i] > longest) longest = _history[i];
+	}
+
+	if (count) average /= count;
+
+	// The text
+
+	int	x = panel.left + margin;
+	int	y = panel.top + margin;
+	int	right = panel.right - margin;
+	char	line[64];
+
+	sprintf(line, "FRAME %.2f MS  %.1f FPS", latest * 1000.0, latest > 0 ? 1.0 / latest : 0.0);
+	drawText(buffer, pitch, x, y, right, line, textColor);
+	y += lineHeight;
+
+	sprintf(line, "AVG %.2f  MAX %.2f MS", average * 1000.0, longest * 1000.0);
+	drawText(buffer, pitch, x, y, right, line, textColor);
+	y += lineHeight;
+
+	#ifdef USE_PROFILE
+	const	sFRAMECOUNTERS	&counters = profileLastFrame();
+
+	sprintf(line, "POLYS %u/%u  CULLED %u", counters.polygonsDrawn, counters.polygonsSubmitted, counters.polygonsCulled);
+	drawText(buffer, pitch, x, y, right, line, textColor);
+	y += lineHeight;
+
+	sprintf(line, "VERTS %u", counters.verticesTransformed);
+	drawText(buffer, pitch, x, y, right, line, textColor);
+	y += lineHeight;
+
+	sprintf(line, "PIXELS %u  SPANS %u", counters.pixels, counters.spans);
+	drawText(buffer, pitch, x, y, right, line, textColor);
+	y += lineHeight;
+	#endif
+
+	sprintf(line, "MAPPER %.23s", mapper ? mapper : "");
+	drawText(buffer, pitch, x, y, right, line, textColor);
+	y += lineHeight + margin;
+
+	// The graph (oldest frame on the left), with lines at 60 and 30 fps
+
+	int	bottom = y + graphHeight;
+
+	fillRect(buffer, pitch, x, bottom - (int) (graphHeight / 60.0 / graphRange), HISTORY * barWidth, 1, gridColor);
+	fillRect(buffer, pitch, x, bottom - (int) (graphHeight / 30.0 / graphRange), HISTORY * barWidth, 1, gridColor);
+
+	for (unsigned int bar = 0; bar < count; bar++)
+	{
+		double	t = _history[(_count - count + bar) % HISTORY];
+		int	h = (int) (t / graphRange * graphHeight);
+		if (h < 1) h = 1;
+		if (h > graphHeight) h = graphHeight;
+
+		unsigned int	color = t <= 1.0 / 60.0 ? fastColor : (t <= 1.0 / 30.0 ? slowColor : lateColor);
+		fillRect(buffer, pitch, x + (HISTORY - count + bar) * barWidth, bottom - h, barWidth, h, color);
+	}
+
+	return panel;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Hud.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
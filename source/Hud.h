@@ -0,0 +1,56 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _    _           _     _     
+// | |  | |         | |   | |    
+// | |__| |_   _  __| |   | |__  
+// |  __  | | | |/ _` |   | '_ \ 
+// | |  | | |_| | (_| | _ | | | |
+// |_|  |_|\__,_|\__,_|(_)|_| |_|
+//                               
+//                               
+//
+// On-screen performance HUD
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_HUD
+#define	_H_HUD
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The HUD: frame times (with a graph of the last few seconds), what was drawn, and which mapper drew it
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	Hud
+{
+public:
+	// Construction/Destruction
+
+				Hud();
+virtual				~Hud();
+
+	// Utilitarian
+
+virtual		CRect		draw(unsigned int *buffer, const unsigned int width, const unsigned int height, const unsigned int pitch,
+				     const char *mapper);
+
+private:
+	enum	{HISTORY = 120};		// Frames in the graph
+
+		double		_history[HISTORY];	// Frame times (in seconds)
+		unsigned int	_count;			// Frames recorded
+		double		_last;			// When the last frame was drawn
+};
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Hud.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
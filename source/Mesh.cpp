@@ -0,0 +1,924 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  __  __           _                          
+// |  \/  |         | |                         
+// | \  / | ___  ___| |__       ___ _ __  _ __  
+// | |\/| |/ _ \/ __| '_ \     / __| '_ \| '_ \ 
+// | |  | |  __/\__ \ | | | _ | (__| |_) | |_) |
+// |_|  |_|\___||___/_| |_|(_) \___| .__/| .__/ 
+//                                 | |   | |    
+//                                 |_|   |_|    
+//
+// Meshes (Wavefront OBJ conversion & memory-mapped binary meshes)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// Parsing text is slow, so an OBJ file is only parsed once: it's converted to a binary mesh (a .tmsh next to it) which is simply
+// mapped on every later load.  Nothing in the binary file is parsed or copied; the vertex & index arrays point straight into the
+// view, and the pages come in from the disk (or the file cache) as they're first touched.
+//
+// The conversion maps the OBJ file and splits it into one part per processor (on line boundaries), then makes two passes over the
+// parts in parallel.  The first pass only counts each part's vertices, polygons and indices; the running totals tell every part
+// exactly where its data goes in the mesh (and how many vertices precede it, for OBJ's relative indices), so the second pass
+// parses straight into place with no merging.
+//
+// Before it's written, the polygons are grouped into chunks of up to meshChunkPolygons neighbors, each with a bounding box, so a
+// scene can cull them a chunk at a time (see MeshScene.cpp.)  This costs a tree build at conversion, but nothing at load time.
+//
+// Optionally, the polygons in each chunk are then reordered so that each one shares as many vertices as it can with the ones just
+// before it, and the vertices are renumbered in the order they're first used.  A vertex is transformed once a frame, the first
+// time it's used (see Render::drawMesh), so this doesn't change how many are transformed; it keeps the ones that are used together
+// together in memory, so the transformed vertices a polygon reads are still in the cache from the polygons before it.  The reorder
+// is Tipsify (Sander, Nehab & Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"), run on polygons rather
+// than triangles: it fans out around one vertex at a time, emitting every polygon that uses it, then moves on to a vertex of those
+// polygons that's still in the cache (modeled as a FIFO of meshCacheSize vertices) and has the most polygons left.  It's linear in
+// the size of the chunk, so it adds little to the conversion.
+//
+// Only positions ('v') and faces ('f') are used.  The mappers need a texture coordinate that stays inside the texture, so they're
+// generated from the position (as they are for the built-in scene) rather than taken from the file.
+//
+// OBJ is y-up and counter-clockwise, looking down -z.  Meshes are turned around the x axis (y & z are negated) to face the viewer
+// with y down the screen, and each polygon's winding is reversed so it's clockwise on the screen, the way the mappers want it.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <process.h>
+#include <math.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	unsigned int	meshMaxThreads = 16;
+static	const	unsigned int	meshMinPart = 0x10000;		// Bytes of OBJ text per thread (smaller files get fewer threads)
+static	const	unsigned int	meshCacheSize = 32;		// Vertices, in the cache the reorder models
+static	const	unsigned int	meshChunkCorners = meshChunkPolygons * meshMaxVerts;
+static	const	unsigned int	meshNone = 0xffffffff;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// A thread's share of the OBJ file
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	objpart
+{
+	const	char		*begin;
+	const	char		*end;
+	bool			parse;			// False for the counting pass
+	bool			valid;
+
+	// From the counting pass
+
+	unsigned int		vertexCount;
+	unsigned int		polygonCount;
+	unsigned int		indexCount;
+
+	// For the parsing pass: where this part's data starts in the mesh arrays
+
+	unsigned int		firstVertex;
+	unsigned int		firstPolygon;
+	unsigned int		firstIndex;
+	unsigned int		totalVertices;
+	sMESHVERTEX		*vertices;
+	unsigned int		*starts;
+	unsigned int		*indices;
+	float			minimum[3];
+	float			maximum[3];
+} sOBJPART;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Text scanning
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	bool	isBlank(const char c)
+{
+	return c == ' ' || c == '\t';
+}
+
+static	inline	bool	isLineEnd(const char *p, const char *end)
+{
+	return p >= end || *p == '\n' || *p == '\r';
+}
+
+static	inline	const	char	*skipBlanks(const char *p, const char *end)
+{
+	while(p < end && isBlank(*p)) p++;
+	return p;
+}
+
+static	inline	const	char	*skipToken(const char *p, const char *end)
+{
+	while(!isLineEnd(p, end) && !isBlank(*p)) p++;
+	return p;
+}
+
+static	inline	const	char	*nextLine(const char *p, const char *end)
+{
+	while(p < end && *p != '\n') p++;
+	return p < end ? p + 1 : end;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns the number of blank-separated tokens left on the line
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	unsigned int	countTokens(const char *p, const char *end)
+{
+	unsigned int	count = 0;
+
+	for(;;)
+	{
+		p = skipBlanks(p, end);
+		if (isLineEnd(p, end)) return count;
+		p = skipToken(p, end);
+		count++;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Number parsing (much quicker than the CRT's, which has to deal with locales)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	bool	parseInt(const char *&p, const char *end, int &result)
+{
+	p = skipBlanks(p, end);
+
+	bool	negative = false;
+	if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+
+	const	char	*digits = p;
+	int	value = 0;
+	while(p < end && *p >= '0' && *p <= '9') value = value * 10 + (*p++ - '0');
+
+	result = negative ? -value : value;
+	return p != digits;
+}
+
+static	bool	parseFloat(const char *&p, const char *end, float &result)
+{
+	p = skipBlanks(p, end);
+
+	bool	negative = false;
+	if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+
+	const	char	*digits = p;
+	double	value = 0.0;
+	while(p < end && *p >= '0' && *p <= '9') value = value * 10.0 + (*p++ - '0');
+
+	if (p < end && *p == '.')
+	{
+		p++;
+		double	scale = 1.0;
+		while(p < end && *p >= '0' && *p <= '9')
+		{
+			value = value * 10.0 + (*p++ - '0');
+			scale *= 10.0;
+		}
+		value /= scale;
+		if (p == digits + 1) return false;
+	}
+	else if (p == digits)
+	{
+		return false;
+	}
+
+	int	exponent;
+	if (p < end && (*p == 'e' || *p == 'E') && parseInt(++p, end, exponent)) value *= pow(10.0, exponent);
+
+	result = (float) (negative ? -value : value);
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Faces with more than meshMaxVerts vertices are split into a fan of polygons, each sharing the first vertex and an edge with the
+// one before it.  Returns the number of polygons a face with 'count' vertices becomes.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	unsigned int	facePieces(const unsigned int count)
+{
+	return (count - 2 + meshMaxVerts - 3) / (meshMaxVerts - 2);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The counting pass
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	countPart(sOBJPART &part)
+{
+	const	char	*end = part.end;
+
+	for (const char *p = part.begin; p < end; p = nextLine(p, end))
+	{
+		p = skipBlanks(p, end);
+		if (p + 1 >= end || !isBlank(p[1])) continue;
+
+		if (*p == 'v')
+		{
+			part.vertexCount++;
+		}
+		else if (*p == 'f')
+		{
+			unsigned int	count = countTokens(p + 1, end);
+			if (count < 3) continue;
+
+			unsigned int	pieces = facePieces(count);
+			part.polygonCount += pieces;
+			part.indexCount += count + (pieces - 1) * 2;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Reverses a run of indices (to turn a polygon from counter-clockwise to clockwise)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	void	reverseIndices(unsigned int *first, unsigned int *last)
+{
+	while(first < last)
+	{
+		unsigned int	t = *first;
+		*first++ = *last;
+		*last-- = t;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The parsing pass
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	parsePart(sOBJPART &part)
+{
+	const	char	*end = part.end;
+	sMESHVERTEX	*vertex = part.vertices + part.firstVertex;
+	unsigned int	*start = part.starts + part.firstPolygon;
+	unsigned int	*index = part.indices + part.firstIndex;
+	unsigned int	seen = part.firstVertex;		// Vertices before this line (for relative indices)
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		part.minimum[axis] = 1e30f;
+		part.maximum[axis] = -1e30f;
+	}
+
+	for (const char *p = part.begin; p < end; p = nextLine(p, end))
+	{
+		p = skipBlanks(p, end);
+		if (p + 1 >= end || !isBlank(p[1])) continue;
+
+		if (*p == 'v')
+		{
+			float	xyz[3];
+			p++;
+			if (!parseFloat(p, end, xyz[0]) || !parseFloat(p, end, xyz[1]) || !parseFloat(p, end, xyz[2]))
+			{
+				part.valid = false;
+				return;
+			}
+
+			// Turn it to face the viewer
+
+			xyz[1] = -xyz[1];
+			xyz[2] = -xyz[2];
+
+			for (unsigned int axis = 0; axis < 3; axis++)
+			{
+				if (xyz[axis] < part.minimum[axis]) part.minimum[axis] = xyz[axis];
+				if (xyz[axis] > part.maximum[axis]) part.maximum[axis] = xyz[axis];
+			}
+
+			vertex->x = xyz[0];
+			vertex->y = xyz[1];
+			vertex->z = xyz[2];
+			vertex++;
+			seen++;
+		}
+		else if (*p == 'f')
+		{
+			unsigned int	count = countTokens(p + 1, end);
+			if (count < 3) continue;
+
+			p++;
+			unsigned int	*piece = index;
+			unsigned int	first = 0, previous = 0;
+			unsigned int	size = 0;
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+				// Just the position index (of "v", "v/vt", "v//vn" or "v/vt/vn"); negative indices count back from here
+
+				int	n;
+				if (!parseInt(p, end, n) || !n || (n < 0 && (unsigned int) -n > seen) ||
+				    (n > 0 && (unsigned int) n > part.totalVertices))
+				{
+					part.valid = false;
+					return;
+				}
+
+				p = skipToken(p, end);
+				unsigned int	v = n < 0 ? seen + n : n - 1;
+
+				// Start a polygon (or, once this one is full, the next piece of the fan)
+
+				if (!size)
+				{
+					first = v;
+					*start++ = index - part.indices;
+				}
+				else if (size == meshMaxVerts)
+				{
+					reverseIndices(piece + 1, index - 1);
+					piece = index;
+					*start++ = index - part.indices;
+					*index++ = first;
+					*index++ = previous;
+					size = 2;
+				}
+
+				*index++ = v;
+				previous = v;
+				size++;
+			}
+
+			reverseIndices(piece + 1, index - 1);
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	unsigned WINAPI	objWorker(void *param)
+{
+	sOBJPART	&part = *(sOBJPART *) param;
+	if (part.parse) parsePart(part);
+	else countPart(part);
+	return 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Runs a pass over every part -- the helpers take the later parts, we take the first one
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	runParts(sOBJPART *parts, const unsigned int count)
+{
+	HANDLE		threads[meshMaxThreads];
+	unsigned int	started = 0;
+
+	for (unsigned int i = 1; i < count; i++)
+	{
+		unsigned int	id;
+		HANDLE		thread = (HANDLE) _beginthreadex(NULL, 0, objWorker, &parts[i], 0, &id);
+
+		// If we can't get a thread, do it ourselves
+
+		if (thread) threads[started++] = thread;
+		else objWorker(&parts[i]);
+	}
+
+	objWorker(&parts[0]);
+
+	if (started) WaitForMultipleObjects(started, threads, TRUE, INFINITE);
+	for (unsigned int j = 0; j < started; j++) CloseHandle(threads[j]);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Reorders a chunk's polygons for vertex locality (see NOTES), in place.  'local' has an entry for every vertex in the mesh, all of
+// them meshNone, and they're left that way.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	reorderChunk(unsigned int *starts, unsigned int *indices, const sMESHCHUNK &chunk, unsigned int *local)
+{
+	const	unsigned int	first = chunk.firstPolygon;
+	const	unsigned int	count = chunk.polygonCount;
+	const	unsigned int	base = starts[first];
+	const	unsigned int	cornerCount = starts[first + count] - base;
+
+	// Number the chunk's vertices locally, and count the polygons that use each one
+
+	unsigned int	vertexOf[meshChunkCorners];
+	unsigned int	corners[meshChunkCorners];
+	unsigned int	live[meshChunkCorners];
+	unsigned int	vertexCount = 0;
+	unsigned int	c, v, p;
+
+	for (c = 0; c < cornerCount; c++)
+	{
+		unsigned int	&l = local[indices[base + c]];
+
+		if (l == meshNone)
+		{
+			l = vertexCount;
+			vertexOf[vertexCount] = indices[base + c];
+			live[vertexCount++] = 0;
+		}
+
+		corners[c] = l;
+		live[l]++;
+	}
+
+	// The polygons around each vertex
+
+	unsigned int	adjacencyStart[meshChunkCorners + 1];
+	unsigned int	adjacency[meshChunkCorners];
+	unsigned int	fill[meshChunkCorners];
+
+	adjacencyStart[0] = 0;
+	for (v = 0; v < vertexCount; v++)
+	{
+		adjacencyStart[v + 1] = adjacencyStart[v] + live[v];
+		fill[v] = adjacencyStart[v];
+	}
+
+	for (p = 0; p < count; p++)
+	{
+		for (c = starts[first + p] - base; c < starts[first + p + 1] - base; c++) adjacency[fill[corners[c]]++] = p;
+	}
+
+	// Fan out around one vertex after another
+
+	unsigned int	cacheTime[meshChunkCorners];
+	unsigned int	deadEnd[meshChunkCorners];
+	unsigned int	candidates[meshChunkCorners];
+	unsigned int	order[meshChunkPolygons];
+	bool		emitted[meshChunkPolygons];
+	unsigned int	deadEnds = 0, emittedCount = 0, cursor = 0;
+	unsigned int	time = meshCacheSize + 1;
+
+	memset(cacheTime, 0, vertexCount * sizeof(unsigned int));
+	memset(emitted, 0, count * sizeof(bool));
+
+	for (unsigned int fan = 0; fan != meshNone;)
+	{
+		unsigned int	candidateCount = 0;
+
+		for (unsigned int a = adjacencyStart[fan]; a < adjacencyStart[fan + 1]; a++)
+		{
+			p = adjacency[a];
+			if (emitted[p]) continue;
+
+			emitted[p] = true;
+			order[emittedCount++] = p;
+
+			for (c = starts[first + p] - base; c < starts[first + p + 1] - base; c++)
+			{
+				v = corners[c];
+				deadEnd[deadEnds++] = v;
+				candidates[candidateCount++] = v;
+				live[v]--;
+
+				if (time - cacheTime[v] > meshCacheSize) cacheTime[v] = time++;
+			}
+		}
+
+		// The next fan: the candidate that's been in the cache longest, if it'll still be there once its polygons are emitted
+
+		unsigned int	best = meshNone;
+		int		bestPriority = -1;
+
+		for (c = 0; c < candidateCount; c++)
+		{
+			v = candidates[c];
+			if (!live[v]) continue;
+
+			int	priority = time - cacheTime[v] + 2 * live[v] <= meshCacheSize ? time - cacheTime[v] : 0;
+
+			if (priority > bestPriority)
+			{
+				best = v;
+				bestPriority = priority;
+			}
+		}
+
+		// Or the most recent vertex with polygons left, or failing that, the next one in the chunk
+
+		while(best == meshNone && deadEnds)
+		{
+			v = deadEnd[--deadEnds];
+			if (live[v]) best = v;
+		}
+
+		while(best == meshNone && cursor < vertexCount)
+		{
+			if (live[cursor]) best = cursor;
+			cursor++;
+		}
+
+		fan = best;
+	}
+
+	// Write the polygons back in their new order
+
+	unsigned int	newStarts[meshChunkPolygons];
+	unsigned int	newIndices[meshChunkCorners];
+	unsigned int	index = 0;
+
+	for (p = 0; p < count; p++)
+	{
+		newStarts[p] = base + index;
+		for (c = starts[first + order[p]] - base; c < starts[first + order[p] + 1] - base; c++) newIndices[index++] = vertexOf[corners[c]];
+	}
+
+	memcpy(starts + first, newStarts, count * sizeof(unsigned int));
+	memcpy(indices + base, newIndices, cornerCount * sizeof(unsigned int));
+
+	for (v = 0; v < vertexCount; v++) local[vertexOf[v]] = meshNone;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Groups the polygons into chunks and writes the mesh file.  The chunks are the leaves of a tree built over the polygons, so each is
+// a compact group of neighbors; the polygons are written out chunk by chunk, so each chunk is a run of them.  With 'reorder', they're
+// reordered for vertex locality (see NOTES.)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	bool	writeMesh(const char *filename, const sMESHVERTEX *vertices, const unsigned int vertexCount, const unsigned int *starts,
+			  const unsigned int *indices, const unsigned int polygonCount, const sBVHBOX &bounds, const bool reorder)
+{
+	sBVHBOX	*boxes = new sBVHBOX[polygonCount];
+
+	for (unsigned int i = 0; i < polygonCount; i++)
+	{
+		sBVHBOX	&box = boxes[i];
+		const	sMESHVERTEX	&first = vertices[indices[starts[i]]];
+		box.minimum[0] = box.maximum[0] = first.x;
+		box.minimum[1] = box.maximum[1] = first.y;
+		box.minimum[2] = box.maximum[2] = first.z;
+
+		for (unsigned int j = starts[i] + 1; j < starts[i + 1]; j++)
+		{
+			const	sMESHVERTEX	&v = vertices[indices[j]];
+			if (v.x < box.minimum[0]) box.minimum[0] = v.x;
+			if (v.x > box.maximum[0]) box.maximum[0] = v.x;
+			if (v.y < box.minimum[1]) box.minimum[1] = v.y;
+			if (v.y > box.maximum[1]) box.maximum[1] = v.y;
+			if (v.z < box.minimum[2]) box.minimum[2] = v.z;
+			if (v.z > box.maximum[2]) box.maximum[2] = v.z;
+		}
+	}
+
+	Bvh	tree;
+	tree.build(boxes, polygonCount, meshChunkPolygons);
+	delete[] boxes;
+
+	// Lay the polygons out leaf by leaf
+
+	sMESHHEADER	header;
+	memset(&header, 0, sizeof(header));
+	header.magic = meshMagic;
+	header.version = meshVersion;
+	header.vertexCount = vertexCount;
+	header.polygonCount = polygonCount;
+	header.indexCount = starts[polygonCount];
+	header.flags = reorder ? meshReordered : 0;
+	header.bounds = bounds;
+
+	unsigned int	*chunkStarts = new unsigned int[polygonCount + 1];
+	unsigned int	*chunkIndices = new unsigned int[header.indexCount];
+	sMESHCHUNK	*chunks = new sMESHCHUNK[tree.nodeCount()];
+	unsigned int	polygon = 0, index = 0;
+
+	for (unsigned int n = 0; n < tree.nodeCount(); n++)
+	{
+		const	sBVHNODE	&node = tree.node(n);
+		if (!node.count) continue;
+
+		sMESHCHUNK	&chunk = chunks[header.chunkCount++];
+		chunk.firstPolygon = polygon;
+		chunk.polygonCount = node.count;
+		chunk.bounds = node.box;
+
+		for (unsigned int k = node.first; k < node.first + node.count; k++)
+		{
+			unsigned int	p = tree.item(k);
+			chunkStarts[polygon++] = index;
+			for (unsigned int l = starts[p]; l < starts[p + 1]; l++) chunkIndices[index++] = indices[l];
+		}
+	}
+
+	chunkStarts[polygon] = index;
+
+	// Reorder each chunk's polygons, then number the vertices in the order they're first used (the unused ones go at the end)
+
+	sMESHVERTEX	*ordered = NULL;
+
+	if (reorder)
+	{
+		unsigned int	*remap = new unsigned int[vertexCount];
+		memset(remap, 0xff, vertexCount * sizeof(unsigned int));
+
+		for (unsigned int c = 0; c < header.chunkCount; c++) reorderChunk(chunkStarts, chunkIndices, chunks[c], remap);
+
+		ordered = new sMESHVERTEX[vertexCount];
+		unsigned int	used = 0;
+		unsigned int	i;
+
+		for (i = 0; i < header.indexCount; i++)
+		{
+			unsigned int	&r = remap[chunkIndices[i]];
+
+			if (r == meshNone)
+			{
+				ordered[used] = vertices[chunkIndices[i]];
+				r = used++;
+			}
+
+			chunkIndices[i] = r;
+		}
+
+		for (i = 0; i < vertexCount; i++)
+		{
+			if (remap[i] == meshNone) ordered[used++] = vertices[i];
+		}
+
+		vertices = ordered;
+		delete[] remap;
+	}
+
+	// Write it out (and don't leave half a mesh behind)
+
+	FILE	*fp = fopen(filename, "wb");
+	bool	result = fp && fwrite(&header, sizeof(header), 1, fp) == 1 &&
+			 fwrite(vertices, sizeof(sMESHVERTEX), vertexCount, fp) == vertexCount &&
+			 fwrite(chunkStarts, sizeof(unsigned int), polygonCount + 1, fp) == polygonCount + 1 &&
+			 fwrite(chunkIndices, sizeof(unsigned int), header.indexCount, fp) == header.indexCount &&
+			 fwrite(chunks, sizeof(sMESHCHUNK), header.chunkCount, fp) == header.chunkCount;
+	if (fp && fclose(fp)) result = false;
+	if (fp && !result) remove(filename);
+
+	delete[] ordered;
+	delete[] chunkStarts;
+	delete[] chunkIndices;
+	delete[] chunks;
+	return result;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		Mesh::Mesh()
+		:_file(INVALID_HANDLE_VALUE), _mapping(NULL), _header(NULL), _vertices(NULL), _starts(NULL), _indices(NULL), _chunks(NULL)
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		Mesh::~Mesh()
+{
+	close();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Opens a binary mesh, or an OBJ file (which is converted to a binary mesh with the same name and a .tmsh extension the first time
+// through, and again whenever the OBJ file is newer.)  'threads' & 'reorder' are used for the conversion (see convert.)  A binary
+// mesh that's up to date is used as it is, reordered or not (see isReordered.)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		Mesh::open(const char *filename, const unsigned int threads, const bool reorder)
+{
+	close();
+
+	char		meshFilename[_MAX_PATH];
+	const	char	*extension = strrchr(filename, '.');
+
+	if (extension && !stricmp(extension, ".obj") && strlen(filename) + 2 < _MAX_PATH)
+	{
+		strcpy(meshFilename, filename);
+		strcpy(meshFilename + (extension - filename), ".tmsh");
+
+		// Without the OBJ file, we'll take whatever was converted last
+
+		WIN32_FILE_ATTRIBUTE_DATA	obj, mesh;
+
+		if (GetFileAttributesEx(filename, GetFileExInfoStandard, &obj) &&
+		    (!GetFileAttributesEx(meshFilename, GetFileExInfoStandard, &mesh) ||
+		     CompareFileTime(&mesh.ftLastWriteTime, &obj.ftLastWriteTime) < 0))
+		{
+			if (!convert(filename, meshFilename, threads, reorder)) return false;
+		}
+
+		filename = meshFilename;
+	}
+
+	// Open the file & map it
+
+	_file = CreateFile(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (_file == INVALID_HANDLE_VALUE) return false;
+
+	DWORD	sizeHigh;
+	DWORD	size = GetFileSize(_file, &sizeHigh);
+
+	if (sizeHigh || size < sizeof(sMESHHEADER))
+	{
+		close();
+		return false;
+	}
+
+	_mapping = CreateFileMapping(_file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (_mapping) _header = (const sMESHHEADER *) MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+
+	if (!_header)
+	{
+		close();
+		return false;
+	}
+
+	// Make sure the arrays fit the file (their contents are used as-is -- we wrote them)
+
+	unsigned __int64	expected = sizeof(sMESHHEADER) + (unsigned __int64) _header->vertexCount * sizeof(sMESHVERTEX) +
+					   ((unsigned __int64) _header->polygonCount + 1 + _header->indexCount) * sizeof(unsigned int) +
+					   (unsigned __int64) _header->chunkCount * sizeof(sMESHCHUNK);
+
+	if (_header->magic != meshMagic || _header->version != meshVersion || !_header->vertexCount || !_header->polygonCount ||
+	    !_header->chunkCount || expected != size)
+	{
+		close();
+		return false;
+	}
+
+	_vertices = (const sMESHVERTEX *) (_header + 1);
+	_starts = (const unsigned int *) (_vertices + _header->vertexCount);
+	_indices = _starts + _header->polygonCount + 1;
+	_chunks = (const sMESHCHUNK *) (_indices + _header->indexCount);
+
+	if (_starts[0] || _starts[_header->polygonCount] != _header->indexCount)
+	{
+		close();
+		return false;
+	}
+
+	// Done
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Mesh::close()
+{
+	if (_header) UnmapViewOfFile(_header);
+	_header = NULL;
+	_vertices = NULL;
+	_starts = NULL;
+	_indices = NULL;
+	_chunks = NULL;
+
+	if (_mapping) CloseHandle(_mapping);
+	_mapping = NULL;
+
+	if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+	_file = INVALID_HANDLE_VALUE;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Converts an OBJ file to a binary mesh.  'threads' is the number of threads to parse with; zero means one per processor.  With
+// 'reorder', the polygons & vertices are reordered for vertex locality (see NOTES.)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		Mesh::convert(const char *objFilename, const char *meshFilename, const unsigned int threads, const bool reorder)
+{
+	// Map the OBJ file
+
+	HANDLE	file = CreateFile(objFilename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	DWORD		sizeHigh;
+	DWORD		size = GetFileSize(file, &sizeHigh);
+	HANDLE		mapping = size && !sizeHigh ? CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+	const	char	*text = mapping ? (const char *) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+
+	if (!text)
+	{
+		if (mapping) CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	// Split it into parts on line boundaries
+
+	unsigned int	count = threads;
+
+	if (!count)
+	{
+		SYSTEM_INFO	si;
+		GetSystemInfo(&si);
+		count = si.dwNumberOfProcessors;
+	}
+
+	if (count > meshMaxThreads) count = meshMaxThreads;
+	if (count > size / meshMinPart + 1) count = size / meshMinPart + 1;
+	if (!count) count = 1;
+
+	sOBJPART	parts[meshMaxThreads];
+	memset(parts, 0, sizeof(parts));
+
+	const	char	*end = text + size;
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		const	char	*p = text + (unsigned int) ((unsigned __int64) size * i / count);
+		if (i) while(p < end && p[-1] != '\n') p++;
+
+		parts[i].begin = p;
+		parts[i].end = end;
+		parts[i].valid = true;
+		if (i) parts[i - 1].end = p;
+	}
+
+	// Count everything, then work out where each part's share goes
+
+	runParts(parts, count);
+
+	unsigned int		vertexCount = 0, polygonCount = 0, indexCount = 0;
+	unsigned __int64	bytes = sizeof(sMESHHEADER);
+
+	for (unsigned int j = 0; j < count; j++)
+	{
+		parts[j].firstVertex = vertexCount;
+		parts[j].firstPolygon = polygonCount;
+		parts[j].firstIndex = indexCount;
+		bytes += (unsigned __int64) parts[j].vertexCount * sizeof(sMESHVERTEX) +
+			 ((unsigned __int64) parts[j].polygonCount + parts[j].indexCount) * sizeof(unsigned int);
+		vertexCount += parts[j].vertexCount;
+		polygonCount += parts[j].polygonCount;
+		indexCount += parts[j].indexCount;
+	}
+
+	bytes += sizeof(unsigned int);
+
+	bool		result = false;
+	sMESHVERTEX	*vertices = NULL;
+	unsigned int	*starts = NULL;
+	unsigned int	*indices = NULL;
+	sBVHBOX		bounds;
+
+	if (vertexCount && polygonCount && bytes < 0x80000000)
+	{
+		vertices = new sMESHVERTEX[vertexCount];
+		starts = new unsigned int[polygonCount + 1];
+		indices = new unsigned int[indexCount];
+
+		for (unsigned int k = 0; k < count; k++)
+		{
+			parts[k].parse = true;
+			parts[k].totalVertices = vertexCount;
+			parts[k].vertices = vertices;
+			parts[k].starts = starts;
+			parts[k].indices = indices;
+		}
+
+		runParts(parts, count);
+		starts[polygonCount] = indexCount;
+
+		// Put the pieces together
+
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			bounds.minimum[axis] = 1e30f;
+			bounds.maximum[axis] = -1e30f;
+		}
+
+		result = true;
+
+		for (unsigned int l = 0; l < count; l++)
+		{
+			result = result && parts[l].valid;
+
+			for (unsigned int axis = 0; axis < 3; axis++)
+			{
+				if (parts[l].minimum[axis] < bounds.minimum[axis]) bounds.minimum[axis] = parts[l].minimum[axis];
+				if (parts[l].maximum[axis] > bounds.maximum[axis]) bounds.maximum[axis] = parts[l].maximum[axis];
+			}
+		}
+	}
+
+	UnmapViewOfFile(text);
+	CloseHandle(mapping);
+	CloseHandle(file);
+
+	if (result) result = writeMesh(meshFilename, vertices, vertexCount, starts, indices, polygonCount, bounds, reorder);
+
+	delete[] vertices;
+	delete[] starts;
+	delete[] indices;
+	return result;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Mesh.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,116 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  __  __           _         _     
+// |  \/  |         | |       | |    
+// | \  / | ___  ___| |__     | |__  
+// | |\/| |/ _ \/ __| '_ \    | '_ \ 
+// | |  | |  __/\__ \ | | | _ | | | |
+// |_|  |_|\___||___/_| |_|(_)|_| |_|
+//                                   
+//                                   
+//
+// Meshes (Wavefront OBJ conversion & memory-mapped binary meshes)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_MESH
+#define	_H_MESH
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned int	meshMagic = 0x48534d54;			// "TMSH"
+const	unsigned int	meshVersion = 3;
+const	unsigned int	meshMaxVerts = 16;			// Per polygon (larger OBJ faces are split into fans)
+const	unsigned int	meshChunkPolygons = 64;			// At most, per chunk
+const	unsigned int	meshReordered = 1;			// A header flag (see Mesh.cpp)
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The binary mesh file.  It's the mesh exactly as it's used in memory, so loading one is just a matter of mapping it:
+//
+//   [header] [vertexCount vertices] [polygonCount + 1 polygon starts] [indexCount indices] [chunkCount chunks]
+//
+// Polygon 'i' is made of the vertices indices[starts[i]] through indices[starts[i + 1] - 1], wound clockwise (as seen on the
+// screen) so they go straight to the mappers.  The polygons are grouped into chunks of nearby polygons, each a run of polygons with
+// a bounding box, for culling.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	meshheader
+{
+	unsigned int	magic;
+	unsigned int	version;
+	unsigned int	vertexCount;
+	unsigned int	polygonCount;
+	unsigned int	indexCount;
+	unsigned int	chunkCount;
+	unsigned int	flags;
+	sBVHBOX		bounds;
+} sMESHHEADER;
+
+typedef	struct	meshvertex
+{
+	float		x, y, z;
+} sMESHVERTEX;
+
+typedef	struct	meshchunk
+{
+	unsigned int	firstPolygon;
+	unsigned int	polygonCount;
+	sBVHBOX		bounds;
+} sMESHCHUNK;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	Mesh
+{
+public:
+	// Construction/Destruction
+
+				Mesh();
+virtual				~Mesh();
+
+	// Accessors
+
+inline	const	bool		isOpen() const {return _header != NULL;}
+inline	const	unsigned int	&vertexCount() const {return _header->vertexCount;}
+inline	const	unsigned int	&polygonCount() const {return _header->polygonCount;}
+inline	const	unsigned int	&indexCount() const {return _header->indexCount;}
+inline	const	unsigned int	&chunkCount() const {return _header->chunkCount;}
+inline	const	sBVHBOX		&bounds() const {return _header->bounds;}
+inline	const	bool		isReordered() const {return (_header->flags & meshReordered) != 0;}
+inline	const	sMESHVERTEX	*vertices() const {return _vertices;}
+inline	const	unsigned int	*polygon(const unsigned int i) const {return _indices + _starts[i];}
+inline	const	unsigned int	polygonSize(const unsigned int i) const {return _starts[i + 1] - _starts[i];}
+inline	const	sMESHCHUNK	&chunk(const unsigned int i) const {return _chunks[i];}
+
+	// Utilitarian
+
+virtual		bool		open(const char *filename, const unsigned int threads = 0, const bool reorder = true);
+virtual		void		close();
+static		bool		convert(const char *objFilename, const char *meshFilename, const unsigned int threads = 0,
+					const bool reorder = true);
+
+private:
+		HANDLE		_file;
+		HANDLE		_mapping;
+	const	sMESHHEADER	*_header;		// The start of the view
+	const	sMESHVERTEX	*_vertices;
+	const	unsigned int	*_starts;
+	const	unsigned int	*_indices;
+	const	sMESHCHUNK	*_chunks;
+};
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Mesh.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,187 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  __  __           _      _____                                           
+// |  \/  |         | |    / ____|                                          
+// | \  / | ___  ___| |__ | (___   ___  ___ _ __   ___      ___ _ __  _ __  
+// | |\/| |/ _ \/ __| '_ \ \___ \ / __|/ _ \ '_ \ / _ \    / __| '_ \| '_ \ 
+// | |  | |  __/\__ \ | | |____) | (__|  __/ | | |  __/ _ | (__| |_) | |_) |
+// |_|  |_|\___||___/_| |_|_____/ \___|\___|_| |_|\___|(_) \___| .__/| .__/ 
+//                                                             | |   | |    
+//                                                             |_|   |_|    
+//
+// Scenes of meshes (culled a chunk at a time)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// A scene is a set of objects (meshes, each placed at a position) with one tree over all of their chunks, so the work of culling a
+// frame depends on how much of the scene is in view rather than on how big it is.  Whole subtrees outside the view are dropped at
+// once, and only the polygons of the chunks that survive are ever transformed.
+//
+// Every object's vertices are numbered across the scene too (see firstVertex), so a renderer can keep one buffer of transformed
+// vertices for the whole scene.
+//
+// Objects can be moved after the tree is built.  Their chunks' boxes are refit in place (see Bvh.cpp), which is much cheaper than a
+// rebuild, but the tree keeps the shape it was built with; objects that travel far from where they started make for looser boxes,
+// and a scene that changes that much should be rebuilt now and then.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		MeshScene::MeshScene()
+		:_objectCount(0), _chunkCount(0), _vertexCount(0), _chunkObjects(NULL), _visible(NULL), _visibleCount(0)
+{
+	memset(_objects, 0, sizeof(_objects));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		MeshScene::~MeshScene()
+{
+	clear();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Adds an object to the scene (at the origin if there's no position) and returns its index, or -1 if there's no room.  The mesh
+// must stay open for as long as it's in the scene, and the scene must be built again before it's culled.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+int		MeshScene::add(const Mesh &mesh, const float *position)
+{
+	if (!mesh.isOpen() || _objectCount == meshSceneMaxObjects) return -1;
+
+	sSCENEOBJECT	&o = _objects[_objectCount];
+	o.mesh = &mesh;
+	o.firstChunk = _chunkCount;
+	o.firstVertex = _vertexCount;
+
+	for (unsigned int axis = 0; axis < 3; axis++) o.position[axis] = position ? position[axis] : 0;
+
+	_chunkCount += mesh.chunkCount();
+	_vertexCount += mesh.vertexCount();
+	_bvh.destroy();
+	return _objectCount++;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Builds the tree over the objects' chunks
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		MeshScene::build()
+{
+	delete[] _chunkObjects;
+	delete[] _visible;
+	_chunkObjects = NULL;
+	_visible = NULL;
+	_visibleCount = 0;
+
+	if (!_chunkCount) return false;
+
+	sBVHBOX	*boxes = new sBVHBOX[_chunkCount];
+	_chunkObjects = new unsigned int[_chunkCount];
+	_visible = new unsigned int[_chunkCount];
+
+	for (unsigned int i = 0; i < _objectCount; i++)
+	{
+		const	sSCENEOBJECT	&o = _objects[i];
+
+		for (unsigned int j = 0; j < o.mesh->chunkCount(); j++)
+		{
+			chunkBox(i, j, boxes[o.firstChunk + j]);
+			_chunkObjects[o.firstChunk + j] = i;
+		}
+	}
+
+	bool	result = _bvh.build(boxes, _chunkCount);
+	delete[] boxes;
+	return result;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Moves an object, refitting the tree around its chunks
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		MeshScene::move(const unsigned int object, const float *position)
+{
+	sSCENEOBJECT	&o = _objects[object];
+	for (unsigned int axis = 0; axis < 3; axis++) o.position[axis] = position[axis];
+
+	if (!_bvh.isBuilt()) return;
+
+	for (unsigned int i = 0; i < o.mesh->chunkCount(); i++)
+	{
+		sBVHBOX	box;
+		chunkBox(object, i, box);
+		_bvh.refit(o.firstChunk + i, box);
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Finds the chunks that aren't entirely outside any of the planes (see Bvh::cull.)  Returns the number found; the chunks themselves
+// are visibleChunk(0) through visibleChunk(count - 1).
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int	MeshScene::cull(const sBVHPLANE *planes, const unsigned int planeCount)
+{
+	_visibleCount = _bvh.cull(planes, planeCount, _visible);
+	return _visibleCount;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		MeshScene::clear()
+{
+	_bvh.destroy();
+
+	delete[] _chunkObjects;
+	_chunkObjects = NULL;
+
+	delete[] _visible;
+	_visible = NULL;
+
+	_visibleCount = 0;
+	_objectCount = 0;
+	_chunkCount = 0;
+	_vertexCount = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns the box around one of an object's chunks, where it is in the scene
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		MeshScene::chunkBox(const unsigned int object, const unsigned int chunk, sBVHBOX &box) const
+{
+	const	sSCENEOBJECT	&o = _objects[object];
+	box = o.mesh->chunk(chunk).bounds;
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		box.minimum[axis] += o.position[axis];
+		box.maximum[axis] += o.position[axis];
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// MeshScene.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
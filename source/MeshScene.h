@@ -0,0 +1,98 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  __  __           _      _____                          _     
+// |  \/  |         | |    / ____|                        | |    
+// | \  / | ___  ___| |__ | (___   ___  ___ _ __   ___    | |__  
+// | |\/| |/ _ \/ __| '_ \ \___ \ / __|/ _ \ '_ \ / _ \   | '_ \ 
+// | |  | |  __/\__ \ | | |____) | (__|  __/ | | |  __/ _ | | | |
+// |_|  |_|\___||___/_| |_|_____/ \___|\___|_| |_|\___|(_)|_| |_|
+//                                                               
+//                                                               
+//
+// Scenes of meshes (culled a chunk at a time)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_MESHSCENE
+#define	_H_MESHSCENE
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned int	meshSceneMaxObjects = 64;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// An object: a mesh, placed in the scene
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	sceneobject
+{
+	const	Mesh		*mesh;
+	float			position[3];		// Added to the mesh's vertices
+	unsigned int		firstChunk;		// Its first chunk, in the scene's numbering
+	unsigned int		firstVertex;		// Its first vertex, likewise
+} sSCENEOBJECT;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	MeshScene
+{
+public:
+	// Construction/Destruction
+
+				MeshScene();
+virtual				~MeshScene();
+
+	// Accessors
+
+inline	const	unsigned int	&objectCount() const {return _objectCount;}
+inline	const	unsigned int	&vertexCount() const {return _vertexCount;}
+inline	const	sSCENEOBJECT	&object(const unsigned int i) const {return _objects[i];}
+inline	const	bool		isBuilt() const {return _bvh.isBuilt();}
+inline	const	sBVHBOX		&bounds() const {return _bvh.bounds();}
+
+	// The chunks found by the last cull()
+
+inline	const	unsigned int	&visibleCount() const {return _visibleCount;}
+inline	const	sSCENEOBJECT	&visibleObject(const unsigned int i) const {return _objects[_chunkObjects[_visible[i]]];}
+inline	const	sMESHCHUNK	&visibleChunk(const unsigned int i) const
+				{
+					const	sSCENEOBJECT	&o = visibleObject(i);
+					return o.mesh->chunk(_visible[i] - o.firstChunk);
+				}
+
+	// Utilitarian
+
+virtual		int		add(const Mesh &mesh, const float *position = NULL);
+virtual		bool		build();
+virtual		void		move(const unsigned int object, const float *position);
+virtual		unsigned int	cull(const sBVHPLANE *planes, const unsigned int planeCount);
+virtual		void		clear();
+
+private:
+virtual		void		chunkBox(const unsigned int object, const unsigned int chunk, sBVHBOX &box) const;
+
+		sSCENEOBJECT	_objects[meshSceneMaxObjects];
+		unsigned int	_objectCount;
+		unsigned int	_chunkCount;
+		unsigned int	_vertexCount;
+		Bvh		_bvh;			// Over every object's chunks
+		unsigned int	*_chunkObjects;		// The object each chunk belongs to
+		unsigned int	*_visible;
+		unsigned int	_visibleCount;
+};
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// MeshScene.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,676 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____       _        _____ _                                                 
+// |  __ \     | |      / ____| |                                                
+// | |__) |___ | |_   _| (___ | |_ _ __ ___  __ _ _ __ ___       ___ _ __  _ __  
+// |  ___// _ \| | | | |\___ \| __| '__/ _ \/ _` | '_ ` _ \     / __| '_ \| '_ \ 
+// | |   | (_) | | |_| |____) | |_| | |  __/ (_| | | | | | | _ | (__| |_) | |_) |
+// |_|    \___/|_|\__, |_____/ \__|_|  \___|\__,_|_| |_| |_|(_) \___| .__/| .__/ 
+//                 __/ |                                            | |   | |    
+//                |___/                                             |_|   |_|    
+//
+// Polygon-stream recording and replay
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// A recording captures the polygons after they've been transformed, projected and lit, exactly as they're handed to the mappers,
+// along with everything else the mappers read: the buffer they draw into, the bound texture and the blend mode.  Replaying one
+// leaves out the window, the presenter, the frame loop and the transform, so what's left to time is the clears and the mappers,
+// with nothing else in the way, and the same frames every run (the animation is frozen into the file.)
+//
+// Targets are identified by their buffer, and textures by their sTEXTURE, so a swap chain's buffers show up as separate targets.
+// A texture is compared against a copy of what was last sent the first time a polygon is drawn with it each frame, and again if
+// its generation has changed since (a full compare is up to 256K for a 256x256 texture, far too much to do for every polygon.)
+// RenderTarget::updated() bumps its texture's generation, so a render target's texture is sent again each time it's redrawn;
+// anything else that changes a texture's texels part way through a frame needs to do the same.
+//
+// The affine and exact perspective mappers always read the default texture (the checkerboard from drawTexture), so the player
+// needs drawTexture() called before it replays.  The virtual texture isn't recorded, so polygons drawn with that mapper are
+// recorded as such, but skipped on replay.
+//
+// The mappers don't wrap or clamp texture coordinates, so right along a polygon's edges they can read a texel or two from just
+// past the end of a texture, which is wherever the texture happens to be in memory.  So a replay can differ from the frames that
+// were recorded by the odd pixel along the edges (though a replay always matches the replays before it.)
+//
+// The file is written in the machine's byte order (which is to say, little-endian.)
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <stdio.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns a texture's texels as (up to) two runs of bytes, and their total size
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	unsigned int	texelRuns(const sTEXTURE &tex, const unsigned char *runs[2], unsigned int bytes[2])
+{
+	unsigned int	count = tex.width * tex.height;
+
+	runs[0] = runs[1] = NULL;
+	bytes[0] = bytes[1] = 0;
+
+	switch(tex.format)
+	{
+		case TF_ARGB32:
+			runs[0] = (const unsigned char *) tex.argb;
+			bytes[0] = count * sizeof(unsigned int);
+			break;
+
+		case TF_PAL8:
+			runs[0] = tex.indices;
+			bytes[0] = count;
+			runs[1] = (const unsigned char *) tex.palette;
+			bytes[1] = 256 * sizeof(unsigned int);
+			break;
+
+		case TF_BC1:
+			runs[0] = (const unsigned char *) tex.blocks;
+			bytes[0] = count / 16 * sizeof(sBC1BLOCK);
+			break;
+
+		case TF_RGB565:
+			runs[0] = (const unsigned char *) tex.rgb565;
+			bytes[0] = count * sizeof(unsigned short);
+			break;
+	}
+
+	return bytes[0] + bytes[1];
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The recorder
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		PolyRecorder::PolyRecorder()
+		:_file(NULL), _frames(0), _limit(0), _targetCount(0), _textureCount(0)
+{
+	memset(_targetBuffers, 0, sizeof(_targetBuffers));
+	memset(_textures, 0, sizeof(_textures));
+	memset(_texels, 0, sizeof(_texels));
+	memset(_texelBytes, 0, sizeof(_texelBytes));
+	memset(_checked, 0, sizeof(_checked));
+	memset(_generations, 0, sizeof(_generations));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		PolyRecorder::~PolyRecorder()
+{
+	stop();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Records the next 'frames' frames into the given file
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		PolyRecorder::start(const char *filename, const unsigned int frames)
+{
+	stop();
+
+	_file = fopen(filename, "wb");
+	if (!_file) return false;
+
+	sPOLYSTREAMHEADER	header;
+	header.magic = polyStreamMagic;
+	header.version = polyStreamVersion;
+	fwrite(&header, sizeof(header), 1, _file);
+
+	_frames = 0;
+	_limit = frames;
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		PolyRecorder::stop()
+{
+	if (_file) fclose(_file);
+	_file = NULL;
+
+	for (unsigned int i = 0; i < polyStreamMaxTextures; i++)
+	{
+		delete[] _texels[i];
+		_texels[i] = NULL;
+		_texelBytes[i] = 0;
+		_textures[i] = NULL;
+	}
+
+	memset(_targetBuffers, 0, sizeof(_targetBuffers));
+	_targetCount = 0;
+	_textureCount = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Marks the start of a frame (the recording ends when the last frame is done)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		PolyRecorder::frame()
+{
+	if (!_file) return;
+
+	if (_frames == _limit)
+	{
+		stop();
+		return;
+	}
+
+	memset(_checked, 0, sizeof(_checked));
+
+	sPOLYFRAME	frame;
+	frame.frame = _frames++;
+	chunk(POLY_CHUNK_FRAME, &frame, sizeof(frame));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		PolyRecorder::clear(const void *buffer, const unsigned int width, const unsigned int height, const unsigned int pitch,
+				    const unsigned int depth, const unsigned int color)
+{
+	if (!_file) return;
+
+	sPOLYCLEAR	clear;
+	clear.target = target(buffer, width, height, pitch, depth);
+	clear.color = color;
+	chunk(POLY_CHUNK_CLEAR, &clear, sizeof(clear));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Records a polygon, as it's about to be drawn with the given mappers (PolyMapper bits) into the given buffer
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		PolyRecorder::polygon(const unsigned int mappers, const sVERT *verts, const void *buffer, const unsigned int width,
+				      const unsigned int height, const unsigned int pitch, const unsigned int depth)
+{
+	if (!_file) return;
+
+	sPOLYDRAW	draw;
+	draw.target = target(buffer, width, height, pitch, depth);
+	draw.texture = texture(boundTexture());
+	draw.blend = blendMode();
+	draw.mappers = mappers;
+	draw.vertexCount = 0;
+
+	sPOLYVERTEX	stream[polyStreamMaxVerts];
+
+	for (const sVERT *v = verts; v && draw.vertexCount < polyStreamMaxVerts; v = v->next)
+	{
+		sPOLYVERTEX	&dst = stream[draw.vertexCount++];
+		dst.u = v->u; dst.v = v->v; dst.w = v->w;
+		dst.x = v->x; dst.y = v->y; dst.z = v->z;
+		dst.r = v->r; dst.g = v->g; dst.b = v->b;
+		dst.i = v->i; dst.s = v->s;
+	}
+
+	chunk(POLY_CHUNK_DRAW, &draw, sizeof(draw), stream, draw.vertexCount * sizeof(sPOLYVERTEX));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns the id of a target, sending it first if it's new (or has changed size)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int	PolyRecorder::target(const void *buffer, const unsigned int width, const unsigned int height, const unsigned int pitch,
+				     const unsigned int depth)
+{
+	unsigned int	known = _targetCount < polyStreamMaxTargets ? _targetCount : polyStreamMaxTargets;
+	unsigned int	id = 0;
+
+	while (id < known && _targetBuffers[id] != buffer) id++;
+
+	if (id == known)
+	{
+		id = _targetCount++ % polyStreamMaxTargets;
+		_targetBuffers[id] = buffer;
+	}
+	else
+	{
+		const	sPOLYTARGET	&t = _targets[id];
+		if (t.width == width && t.height == height && t.pitch == pitch && t.depth == depth) return id;
+	}
+
+	sPOLYTARGET	&t = _targets[id];
+	t.id = id;
+	t.width = width;
+	t.height = height;
+	t.pitch = pitch;
+	t.depth = depth;
+	chunk(POLY_CHUNK_TARGET, &t, sizeof(t));
+	return id;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns the id of a texture, sending its texels first if it's new (or they've changed since they were last sent)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int	PolyRecorder::texture(const sTEXTURE &tex)
+{
+	unsigned int	known = _textureCount < polyStreamMaxTextures ? _textureCount : polyStreamMaxTextures;
+	unsigned int	id = 0;
+
+	while (id < known && _textures[id] != &tex) id++;
+
+	// Compared once a frame (and again if it's been redrawn since)
+
+	if (id < known && _checked[id] && _generations[id] == tex.generation) return id;
+
+	const	unsigned char	*runs[2];
+	unsigned int		bytes[2];
+	unsigned int		total = texelRuns(tex, runs, bytes);
+	bool			unchanged = false;
+
+	if (id == known)
+	{
+		id = _textureCount++ % polyStreamMaxTextures;
+		_textures[id] = &tex;
+		_texelBytes[id] = 0;
+	}
+	else
+	{
+		const	sPOLYTEXTURE	&info = _textureInfo[id];
+
+		unchanged = info.format == (unsigned int) tex.format && info.width == tex.width && info.height == tex.height &&
+			    !memcmp(_texels[id], runs[0], bytes[0]) && !memcmp(_texels[id] + bytes[0], runs[1], bytes[1]);
+	}
+
+	_checked[id] = true;
+	_generations[id] = tex.generation;
+	if (unchanged) return id;
+
+	// Keep a copy to compare against next time
+
+	if (_texelBytes[id] != total)
+	{
+		delete[] _texels[id];
+		_texels[id] = new unsigned char[total];
+		_texelBytes[id] = total;
+	}
+
+	memcpy(_texels[id], runs[0], bytes[0]);
+	memcpy(_texels[id] + bytes[0], runs[1], bytes[1]);
+
+	sPOLYTEXTURE	&info = _textureInfo[id];
+	info.id = id;
+	info.format = tex.format;
+	info.width = tex.width;
+	info.height = tex.height;
+	chunk(POLY_CHUNK_TEXTURE, &info, sizeof(info), runs[0], bytes[0], runs[1], bytes[1]);
+	return id;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Writes a chunk, its payload gathered from up to three pieces
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		PolyRecorder::chunk(const PolyChunkType type, const void *data, const unsigned int bytes, const void *extra,
+				    const unsigned int extraBytes, const void *extra2, const unsigned int extraBytes2)
+{
+	sPOLYCHUNK	header;
+	header.type = type;
+	header.bytes = bytes + extraBytes + extraBytes2;
+	fwrite(&header, sizeof(header), 1, _file);
+
+	fwrite(data, bytes, 1, _file);
+	if (extraBytes) fwrite(extra, extraBytes, 1, _file);
+	if (extraBytes2) fwrite(extra2, extraBytes2, 1, _file);
+
+	const	unsigned int	zero = 0;
+	unsigned int		pad = (4 - (header.bytes & 3)) & 3;
+	if (pad) fwrite(&zero, pad, 1, _file);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The player
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		PolyPlayer::PolyPlayer()
+		:_stream(NULL), _bytes(0), _frames(0), _polygons(0), _targetCount(0)
+{
+	memset(_targets, 0, sizeof(_targets));
+	memset(_targetBuffers, 0, sizeof(_targetBuffers));
+	memset(_targetBytes, 0, sizeof(_targetBytes));
+	memset(_textures, 0, sizeof(_textures));
+	memset(_caches, 0, sizeof(_caches));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		PolyPlayer::~PolyPlayer()
+{
+	close();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Loads a recording, checking every chunk (and allocating every target) up front.  A recording that was cut short (the viewer
+// closed before it was done) plays up to the last whole chunk.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		PolyPlayer::open(const char *filename)
+{
+	close();
+
+	FILE	*fp = fopen(filename, "rb");
+	if (!fp) return false;
+
+	fseek(fp, 0, SEEK_END);
+	long	length = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	if (length < (long) sizeof(sPOLYSTREAMHEADER))
+	{
+		fclose(fp);
+		return false;
+	}
+
+	_bytes = (unsigned int) length;
+	_stream = new unsigned char[_bytes];
+	bool	read = fread(_stream, _bytes, 1, fp) == 1;
+	fclose(fp);
+
+	const	sPOLYSTREAMHEADER	*header = (const sPOLYSTREAMHEADER *) _stream;
+	if (!read || header->magic != polyStreamMagic || header->version != polyStreamVersion)
+	{
+		close();
+		return false;
+	}
+
+	// Walk the chunks
+
+	unsigned int	targetsSeen = 0, texturesSeen = 0;
+	unsigned int	offset = sizeof(sPOLYSTREAMHEADER);
+
+	while (offset + sizeof(sPOLYCHUNK) <= _bytes)
+	{
+		const	sPOLYCHUNK	*chunk = (const sPOLYCHUNK *) (_stream + offset);
+		unsigned int		payload = offset + sizeof(sPOLYCHUNK);
+		unsigned char		*data = _stream + payload;
+		bool			valid = true;
+
+		if (chunk->bytes > _bytes - payload) break;
+
+		switch(chunk->type)
+		{
+			case POLY_CHUNK_FRAME:
+				_frames++;
+				break;
+
+			case POLY_CHUNK_TARGET:
+			{
+				const	sPOLYTARGET	*t = (const sPOLYTARGET *) data;
+				valid = chunk->bytes >= sizeof(sPOLYTARGET) && t->id < polyStreamMaxTargets && t->pitch >= t->width &&
+					(t->depth == 32 || t->depth == 16);
+				if (!valid) break;
+
+				unsigned int	bytes = t->pitch * t->height * t->depth / 8;
+				if (bytes > _targetBytes[t->id])
+				{
+					poolFree(_targetBuffers[t->id]);
+					_targetBuffers[t->id] = (unsigned char *) poolAlloc(bytes);
+					_targetBytes[t->id] = _targetBuffers[t->id] ? bytes : 0;
+					valid = _targetBuffers[t->id] != NULL;
+					if (valid) memset(_targetBuffers[t->id], 0, bytes);
+				}
+
+				targetsSeen |= 1 << t->id;
+				if (t->id >= _targetCount) _targetCount = t->id + 1;
+				break;
+			}
+
+			case POLY_CHUNK_TEXTURE:
+			{
+				const	sPOLYTEXTURE	*t = (const sPOLYTEXTURE *) data;
+				valid = chunk->bytes >= sizeof(sPOLYTEXTURE) && t->id < polyStreamMaxTextures;
+				if (!valid) break;
+
+				// Check the texels are all there (and the dimensions are ones the mappers can handle)
+
+				sTEXTURE	tex;
+				memset(&tex, 0, sizeof(tex));
+				tex.format = (TextureFormat) t->format;
+				tex.width = t->width;
+				tex.height = t->height;
+
+				const	unsigned char	*runs[2];
+				unsigned int		bytes[2];
+				unsigned int		total = texelRuns(tex, runs, bytes);
+
+				valid = total && chunk->bytes == sizeof(sPOLYTEXTURE) + total && t->width <= 256 && t->height <= 256 &&
+					!(t->width & (t->width - 1)) && !(t->height & (t->height - 1));
+				if (!valid) break;
+
+				if (t->format == TF_BC1 && !_caches[t->id]) _caches[t->id] = new sBC1CACHE[bc1CacheSize];
+				texturesSeen |= 1 << t->id;
+				break;
+			}
+
+			case POLY_CHUNK_CLEAR:
+			{
+				const	sPOLYCLEAR	*c = (const sPOLYCLEAR *) data;
+				valid = chunk->bytes >= sizeof(sPOLYCLEAR) && c->target < polyStreamMaxTargets && (targetsSeen & (1 << c->target));
+				break;
+			}
+
+			case POLY_CHUNK_DRAW:
+			{
+				const	sPOLYDRAW	*d = (const sPOLYDRAW *) data;
+				valid = chunk->bytes >= sizeof(sPOLYDRAW) && d->vertexCount >= 3 && d->vertexCount <= polyStreamMaxVerts &&
+					chunk->bytes == sizeof(sPOLYDRAW) + d->vertexCount * sizeof(sPOLYVERTEX) &&
+					d->target < polyStreamMaxTargets && (targetsSeen & (1 << d->target)) &&
+					d->texture < polyStreamMaxTextures && (texturesSeen & (1 << d->texture));
+				_polygons++;
+				break;
+			}
+
+			// Anything else is from a later version; skip it
+		}
+
+		if (!valid)
+		{
+			close();
+			return false;
+		}
+
+		offset = payload + ((chunk->bytes + 3) & ~3);
+	}
+
+	// Drop a partial chunk at the end
+
+	if (offset < _bytes) _bytes = offset;
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		PolyPlayer::close()
+{
+	for (unsigned int i = 0; i < polyStreamMaxTargets; i++)
+	{
+		poolFree(_targetBuffers[i]);
+	}
+
+	for (unsigned int j = 0; j < polyStreamMaxTextures; j++)
+	{
+		delete[] _caches[j];
+	}
+
+	delete[] _stream;
+	_stream = NULL;
+	_bytes = 0;
+	_frames = 0;
+	_polygons = 0;
+	_targetCount = 0;
+
+	memset(_targets, 0, sizeof(_targets));
+	memset(_targetBuffers, 0, sizeof(_targetBuffers));
+	memset(_targetBytes, 0, sizeof(_targetBytes));
+	memset(_textures, 0, sizeof(_textures));
+	memset(_caches, 0, sizeof(_caches));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Plays every frame of the recording, as fast as it'll go.  If 'mappers' is given (PolyMapper bits), every polygon is drawn with
+// those mappers rather than the ones it was recorded with.  Returns the number of polygons drawn.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int	PolyPlayer::replay(const unsigned int mappers)
+{
+	unsigned int	drawn = 0;
+	unsigned int	offset = sizeof(sPOLYSTREAMHEADER);
+
+	while (offset < _bytes)
+	{
+		const	sPOLYCHUNK	*chunk = (const sPOLYCHUNK *) (_stream + offset);
+		unsigned char		*data = _stream + offset + sizeof(sPOLYCHUNK);
+
+		switch(chunk->type)
+		{
+			case POLY_CHUNK_TARGET:
+			{
+				const	sPOLYTARGET	*t = (const sPOLYTARGET *) data;
+				_targets[t->id] = *t;
+				break;
+			}
+
+			// The texels stay where they are, in the stream
+
+			case POLY_CHUNK_TEXTURE:
+			{
+				const	sPOLYTEXTURE	*t = (const sPOLYTEXTURE *) data;
+				unsigned char		*texels = data + sizeof(sPOLYTEXTURE);
+				sTEXTURE		&tex = _textures[t->id];
+
+				memset(&tex, 0, sizeof(tex));
+				tex.format = (TextureFormat) t->format;
+				tex.width = t->width;
+				tex.height = t->height;
+				while ((1U << tex.widthShift) < tex.width) tex.widthShift++;
+
+				switch(tex.format)
+				{
+					case TF_ARGB32:	tex.argb = (unsigned int *) texels; break;
+					case TF_BC1:	tex.blocks = (sBC1BLOCK *) texels; break;
+					case TF_RGB565:	tex.rgb565 = (unsigned short *) texels; break;
+					case TF_PAL8:
+						tex.indices = texels;
+						tex.palette = (unsigned int *) (texels + tex.width * tex.height);
+						break;
+				}
+
+				if (tex.format == TF_BC1)
+				{
+					tex.cache = _caches[t->id];
+					memset(tex.cache, 0, bc1CacheSize * sizeof(sBC1CACHE));
+				}
+				break;
+			}
+
+			case POLY_CHUNK_CLEAR:
+			{
+				const	sPOLYCLEAR	*c = (const sPOLYCLEAR *) data;
+				const	sPOLYTARGET	&t = _targets[c->target];
+				unsigned int		*buffer = (unsigned int *) _targetBuffers[c->target];
+
+				if (t.depth == 16)	clearBuffer(buffer, t.pitch * t.height / 2, argbTo565(c->color) * 0x10001);
+				else			clearBuffer(buffer, t.pitch * t.height, c->color);
+				break;
+			}
+
+			case POLY_CHUNK_DRAW:
+			{
+				const	sPOLYDRAW	*d = (const sPOLYDRAW *) data;
+				draw(*d, (const sPOLYVERTEX *) (data + sizeof(sPOLYDRAW)), mappers ? mappers : d->mappers);
+				drawn++;
+				break;
+			}
+		}
+
+		offset += sizeof(sPOLYCHUNK) + ((chunk->bytes + 3) & ~3);
+	}
+
+	bindTexture(NULL);
+	return drawn;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns a hash of a target's pixels (not the padding), for telling whether two replays drew the same thing
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int	PolyPlayer::checksum(const unsigned int id) const
+{
+	const	sPOLYTARGET	&t = _targets[id];
+	const	unsigned char	*row = _targetBuffers[id];
+	unsigned int		rowBytes = t.width * t.depth / 8;
+	unsigned int		hash = 2166136261;		// FNV-1a
+
+	if (!row) return 0;
+
+	for (unsigned int y = 0; y < t.height; y++, row += t.pitch * t.depth / 8)
+	{
+		for (unsigned int x = 0; x < rowBytes; x++)
+		{
+			hash = (hash ^ row[x]) * 16777619;
+		}
+	}
+
+	return hash;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Draws a recorded polygon with the given mappers.  Mappers that don't match the target's depth are skipped.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		PolyPlayer::draw(const sPOLYDRAW &draw, const sPOLYVERTEX *verts, const unsigned int mappers)
+{
+	sVERT	poly[polyStreamMaxVerts];
+
+	for (unsigned int i = 0; i < draw.vertexCount; i++)
+	{
+		const	sPOLYVERTEX	&src = verts[i];
+		sVERT			&dst = poly[i];
+
+		dst.u = src.u; dst.v = src.v; dst.w = src.w;
+		dst.x = src.x; dst.y = src.y; dst.z = src.z;
+		dst.r = src.r; dst.g = src.g; dst.b = src.b;
+		dst.i = src.i; dst.s = src.s;
+		dst.iy = 0;
+		dst.next = i + 1 < draw.vertexCount ? &poly[i+1] : NULL;
+	}
+
+	bindTexture(&_textures[draw.texture]);
+	setBlendMode((BlendMode) draw.blend);
+
+	const	sPOLYTARGET	&t = _targets[draw.target];
+	unsigned char		*buffer = _targetBuffers[draw.target];
+
+	if (t.depth == 16)
+	{
+		if (mappers & POLY_MAPPER_SUB_AFFINE_565) drawSubPerspectiveTexturedPolygon16(poly, (unsigned short *) buffer, t.pitch);
+		return;
+	}
+
+	if (mappers & POLY_MAPPER_AFFINE)	drawAffineTexturedPolygon(poly, (unsigned int *) buffer, t.pitch);
+	if (mappers & POLY_MAPPER_PERSPECTIVE)	drawPerspectiveTexturedPolygon(poly, (unsigned int *) buffer, t.pitch);
+	if (mappers & POLY_MAPPER_SUB_AFFINE)	drawSubPerspectiveTexturedPolygon(poly, (unsigned int *) buffer, t.pitch);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// PolyStream.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,218 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____       _        _____ _                                _     
+// |  __ \     | |      / ____| |                              | |    
+// | |__) |___ | |_   _| (___ | |_ _ __ ___  __ _ _ __ ___     | |__  
+// |  ___// _ \| | | | |\___ \| __| '__/ _ \/ _` | '_ ` _ \    | '_ \ 
+// | |   | (_) | | |_| |____) | |_| | |  __/ (_| | | | | | | _ | | | |
+// |_|    \___/|_|\__, |_____/ \__|_|  \___|\__,_|_| |_| |_|(_)|_| |_|
+//                 __/ |                                              
+//                |___/                                               
+//
+// Polygon-stream recording and replay
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_POLYSTREAM
+#define	_H_POLYSTREAM
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned int	polyStreamMagic = 0x53504d54;		// "TMPS"
+const	unsigned int	polyStreamVersion = 2;
+const	unsigned int	polyStreamMaxTargets = 8;		// Distinct buffers drawn into (frame buffers, render targets)
+const	unsigned int	polyStreamMaxTextures = 8;		// Distinct textures bound
+const	unsigned int	polyStreamMaxVerts = clipMaxVerts;	// Per polygon (they're recorded after they're clipped)
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The mappers a polygon was drawn with (any combination; they're drawn in this order)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+enum	PolyMapper
+{
+	POLY_MAPPER_AFFINE = 1,
+	POLY_MAPPER_PERSPECTIVE = 2,
+	POLY_MAPPER_SUB_AFFINE = 4,
+	POLY_MAPPER_SUB_AFFINE_565 = 8,		// Into a 16-bit target
+	POLY_MAPPER_VIRTUAL = 16		// Recorded, but not replayed (the virtual texture isn't in the stream)
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The file is a header followed by chunks: a chunk header, then 'bytes' bytes of payload (padded to a multiple of 4 bytes.)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+enum	PolyChunkType
+{
+	POLY_CHUNK_FRAME,			// sPOLYFRAME: the start of a frame
+	POLY_CHUNK_TARGET,			// sPOLYTARGET: a buffer to draw into (re-sent if its size changes)
+	POLY_CHUNK_TEXTURE,			// sPOLYTEXTURE, then the texels (re-sent whenever they change)
+	POLY_CHUNK_CLEAR,			// sPOLYCLEAR: a target cleared to a color
+	POLY_CHUNK_DRAW				// sPOLYDRAW, then 'vertexCount' sPOLYVERTEXs
+};
+
+typedef	struct	polystreamheader
+{
+	unsigned int	magic;
+	unsigned int	version;
+} sPOLYSTREAMHEADER;
+
+typedef	struct	polychunk
+{
+	unsigned int	type;			// PolyChunkType
+	unsigned int	bytes;			// Of payload (not counting the padding)
+} sPOLYCHUNK;
+
+typedef	struct	polyframe
+{
+	unsigned int	frame;
+} sPOLYFRAME;
+
+typedef	struct	polytarget
+{
+	unsigned int	id;
+	unsigned int	width, height;
+	unsigned int	pitch;			// In pixels
+	unsigned int	depth;			// 32, or 16 for 5-6-5
+} sPOLYTARGET;
+
+typedef	struct	polytexture
+{
+	unsigned int	id;
+	unsigned int	format;			// TextureFormat
+	unsigned int	width, height;
+} sPOLYTEXTURE;
+
+typedef	struct	polyclear
+{
+	unsigned int	target;
+	unsigned int	color;			// ARGB (converted for 16-bit targets)
+} sPOLYCLEAR;
+
+typedef	struct	polydraw
+{
+	unsigned int	target;
+	unsigned int	texture;		// The bound texture
+	unsigned int	blend;			// BlendMode
+	unsigned int	mappers;		// PolyMapper bits
+	unsigned int	vertexCount;
+} sPOLYDRAW;
+
+typedef	struct	polyvertex
+{
+	float		u, v, w;
+	float		x, y, z;
+	float		r, g, b, i, s;
+} sPOLYVERTEX;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The recorder.  Everything the mappers are given goes into the file as it's submitted; targets and textures are sent the first
+// time they're seen (and again when they change.)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	PolyRecorder
+{
+public:
+	// Construction/Destruction
+
+				PolyRecorder();
+virtual				~PolyRecorder();
+
+	// Accessors
+
+inline	const	bool		isRecording() const {return _file != NULL;}
+inline	const	unsigned int	&frames() const {return _frames;}
+
+	// Utilitarian
+
+virtual		bool		start(const char *filename, const unsigned int frames);
+virtual		void		stop();
+virtual		void		frame();
+virtual		void		clear(const void *buffer, const unsigned int width, const unsigned int height, const unsigned int pitch,
+				      const unsigned int depth, const unsigned int color);
+virtual		void		polygon(const unsigned int mappers, const sVERT *verts, const void *buffer, const unsigned int width,
+					const unsigned int height, const unsigned int pitch, const unsigned int depth);
+
+private:
+		unsigned int	target(const void *buffer, const unsigned int width, const unsigned int height, const unsigned int pitch,
+				       const unsigned int depth);
+		unsigned int	texture(const sTEXTURE &tex);
+		void		chunk(const PolyChunkType type, const void *data, const unsigned int bytes, const void *extra = NULL,
+				      const unsigned int extraBytes = 0, const void *extra2 = NULL, const unsigned int extraBytes2 = 0);
+
+		FILE		*_file;
+		unsigned int	_frames;		// Started so far
+		unsigned int	_limit;			// Frames to record
+
+		const	void	*_targetBuffers[polyStreamMaxTargets];
+		sPOLYTARGET	_targets[polyStreamMaxTargets];
+		unsigned int	_targetCount;		// Ever seen (slots are reused round-robin once they run out)
+
+		const	sTEXTURE *_textures[polyStreamMaxTextures];
+		sPOLYTEXTURE	_textureInfo[polyStreamMaxTextures];
+		unsigned char	*_texels[polyStreamMaxTextures];	// A copy of what was last sent, to spot changes
+		unsigned int	_texelBytes[polyStreamMaxTextures];
+		bool		_checked[polyStreamMaxTextures];	// Compared this frame (see frame())
+		unsigned int	_generations[polyStreamMaxTextures];	// sTEXTURE::generation when it was compared
+		unsigned int	_textureCount;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The player.  The whole file is loaded up front (and every target allocated) so a replay does nothing but draw.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	PolyPlayer
+{
+public:
+	// Construction/Destruction
+
+				PolyPlayer();
+virtual				~PolyPlayer();
+
+	// Accessors
+
+inline	const	bool		isOpen() const {return _stream != NULL;}
+inline	const	unsigned int	&frames() const {return _frames;}
+inline	const	unsigned int	&polygons() const {return _polygons;}
+inline	const	unsigned int	&targetCount() const {return _targetCount;}
+inline	const	sPOLYTARGET	&target(const unsigned int id) const {return _targets[id];}
+inline	const	unsigned char	*targetBuffer(const unsigned int id) const {return _targetBuffers[id];}
+
+	// Utilitarian
+
+virtual		bool		open(const char *filename);
+virtual		void		close();
+virtual		unsigned int	replay(const unsigned int mappers = 0);
+virtual		unsigned int	checksum(const unsigned int id) const;
+
+private:
+		void		draw(const sPOLYDRAW &draw, const sPOLYVERTEX *verts, const unsigned int mappers);
+
+		unsigned char	*_stream;
+		unsigned int	_bytes;
+		unsigned int	_frames;
+		unsigned int	_polygons;
+
+		sPOLYTARGET	_targets[polyStreamMaxTargets];
+		unsigned char	*_targetBuffers[polyStreamMaxTargets];
+		unsigned int	_targetBytes[polyStreamMaxTargets];	// Allocated (the most the stream ever needs)
+		unsigned int	_targetCount;		// Highest id + 1
+
+		sTEXTURE	_textures[polyStreamMaxTextures];	// Texels point into the stream
+		sBC1CACHE	*_caches[polyStreamMaxTextures];
+};
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// PolyStream.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
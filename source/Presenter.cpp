@@ -0,0 +1,265 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____                           _                                  
+// |  __ \                         | |                                 
+// | |__) |_ __ ___  ___  ___ _ __ | |_  ___ _ __      ___ _ __  _ __  
+// |  ___/| '__/ _ \/ __|/ _ \ '_ \| __|/ _ \ '__|    / __| '_ \| '_ \ 
+// | |    | | |  __/\__ \  __/ | | | |_|  __/ |    _ | (__| |_) | |_) |
+// |_|    |_|  \___||___/\___|_| |_|\__|\___|_|   (_) \___| .__/| .__/ 
+//                                                        | |   | |    
+//                                                        |_|   |_|    
+//
+// Presenters (getting a finished frame onto the display)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// SetDIBitsToDevice copies the whole source rectangle into GDI on every call, which at high resolutions costs about as much as
+// drawing the frame.  A DIB section avoids that: GDI allocates the bits and hands us a pointer, so the renderer draws straight
+// into memory that GDI can read, and presenting is a BitBlt from a memory DC with the section selected into it.
+//
+// GDI may batch calls, so GdiFlush() is called after each frame is presented, before the renderer starts writing to the bits
+// again.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		Presenter::Presenter()
+		:_width(0), _height(0), _depth(0)
+{
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		Presenter::~Presenter()
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned char	*Presenter::resize(const unsigned int width, const unsigned int height, const WORD depth)
+{
+	_width = width;
+	_height = height;
+	_depth = depth;
+	return NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Presents part of the frame (relative to the upper-left of the frame, and at the same place on the display.)  The base class
+// just keeps the books.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		Presenter::present(const CRect &rect)
+{
+	_stats.rects++;
+	_stats.pixels += rect.Width() * rect.Height();
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Presenter::endFrame()
+{
+	_stats.frames++;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Waits for the display's next vertical blank.  GDI has no way to, but the desktop compositor (Vista and later) does; DwmFlush is
+// looked up at run time so the viewer still runs without it.  Returns false if there was nothing to wait with.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		Presenter::waitForVerticalBlank()
+{
+	typedef	HRESULT	(WINAPI *DWMFLUSHPROC)();
+	static	DWMFLUSHPROC	dwmFlush = NULL;
+	static	bool		loaded = false;
+
+	if (!loaded)
+	{
+		loaded = true;
+		HMODULE	dwm = LoadLibrary("dwmapi.dll");
+		if (dwm) dwmFlush = (DWMFLUSHPROC) GetProcAddress(dwm, "DwmFlush");
+	}
+
+	return dwmFlush && dwmFlush() >= 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// DIBPresenter
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		DIBPresenter::DIBPresenter(CDC &dc)
+		:_dib(dc)
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		DIBPresenter::~DIBPresenter()
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned char	*DIBPresenter::resize(const unsigned int width, const unsigned int height, const WORD depth)
+{
+	Presenter::resize(width, height, depth);
+
+	_dib.dstRect() = CRect(0, 0, width, height);
+	_dib.srcRect() = CRect(0, 0, width, height);
+	_dib.frameBuffer(NULL, width, height, depth);
+	return NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		DIBPresenter::attach(unsigned char *frameBuffer)
+{
+	_dib.frameBuffer(frameBuffer, width(), height());
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		DIBPresenter::palette(const unsigned int *colors, const unsigned int count)
+{
+	_dib.palette(colors, count);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		DIBPresenter::present(const CRect &rect)
+{
+	Presenter::present(rect);
+	if (!_dib.frameBuffer()) return false;
+	return _dib.copyToDisplay(rect) != 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// DIBSectionPresenter
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		DIBSectionPresenter::DIBSectionPresenter(CDC &dc)
+		:_dc(dc), _dib(dc), _memDC(NULL), _section(NULL), _oldBitmap(NULL), _bits(NULL)
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		DIBSectionPresenter::~DIBSectionPresenter()
+{
+	release();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		DIBSectionPresenter::release()
+{
+	if (_memDC)
+	{
+		if (_oldBitmap) SelectObject(_memDC, _oldBitmap);
+		DeleteDC(_memDC);
+	}
+
+	if (_section) DeleteObject(_section);
+
+	_memDC = NULL;
+	_section = NULL;
+	_oldBitmap = NULL;
+	_bits = NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned char	*DIBSectionPresenter::resize(const unsigned int width, const unsigned int height, const WORD depth)
+{
+	Presenter::resize(width, height, depth);
+	release();
+
+	// The header (and palette) come from a winDIB
+
+	_dib.frameBuffer(NULL, width, height, depth);
+
+	void	*bits = NULL;
+	_section = CreateDIBSection(_dc.GetSafeHdc(), _dib.bitmapInfo(), DIB_RGB_COLORS, &bits, NULL, 0);
+	if (!_section) return NULL;
+
+	_memDC = CreateCompatibleDC(_dc.GetSafeHdc());
+	if (!_memDC)
+	{
+		release();
+		return NULL;
+	}
+
+	_oldBitmap = SelectObject(_memDC, _section);
+	_bits = (unsigned char *) bits;
+	return _bits;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		DIBSectionPresenter::palette(const unsigned int *colors, const unsigned int count)
+{
+	_dib.palette(colors, count);
+	if (_memDC) SetDIBColorTable(_memDC, 0, count > 256 ? 256 : count, (const RGBQUAD *) colors);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		DIBSectionPresenter::present(const CRect &rect)
+{
+	Presenter::present(rect);
+	if (!_memDC) return false;
+
+	return BitBlt(_dc.GetSafeHdc(), rect.left, rect.top, rect.Width(), rect.Height(), _memDC, rect.left, rect.top, SRCCOPY) != FALSE;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Make sure GDI is done with the bits before we draw into them again
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		DIBSectionPresenter::endFrame()
+{
+	GdiFlush();
+	Presenter::endFrame();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Creates a presenter (delete it when done)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+Presenter	*createPresenter(const PresenterType type, CDC &dc)
+{
+	switch(type)
+	{
+		case PRESENT_DIB_SECTION:	return new DIBSectionPresenter(dc);
+		case PRESENT_NULL:		return new NullPresenter();
+		default:			return new DIBPresenter(dc);
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Presenter.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
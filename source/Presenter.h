@@ -0,0 +1,155 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____                           _                 _     
+// |  __ \                         | |               | |    
+// | |__) |_ __ ___  ___  ___ _ __ | |_  ___ _ __    | |__  
+// |  ___/| '__/ _ \/ __|/ _ \ '_ \| __|/ _ \ '__|   | '_ \ 
+// | |    | | |  __/\__ \  __/ | | | |_|  __/ |    _ | | | |
+// |_|    |_|  \___||___/\___|_| |_|\__|\___|_|   (_)|_| |_|
+//                                                          
+//                                                          
+//
+// Presenters (getting a finished frame onto the display)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_PRESENTER
+#define	_H_PRESENTER
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Presenter backends
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+enum	PresenterType
+{
+	PRESENT_DIB,				// SetDIBitsToDevice from the renderer's buffer (a copy per present)
+	PRESENT_DIB_SECTION,			// Renders into a DIB section that GDI shares with us (BitBlt, no copy of the bits)
+	PRESENT_NULL				// Headless: counts frames, presents nothing
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Presentation statistics
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	presentstats
+{
+	unsigned int	frames;			// Calls to endFrame()
+	unsigned int	rects;			// Calls to present()
+	unsigned int	pixels;			// Total area presented
+} sPRESENTSTATS;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The presenter interface.  After resize(), a presenter that shares its memory with the display returns the buffer to render
+// into; the others return NULL, and present from whatever buffer is given to attach().  Buffers are top-down, with DWORD-aligned
+// scanlines (see pitch().)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	Presenter
+{
+public:
+	// Construction/Destruction
+
+				Presenter();
+virtual				~Presenter();
+
+	// Accessors
+
+inline	const	unsigned int	width() const {return _width;}
+inline	const	unsigned int	height() const {return _height;}
+inline	const	WORD		depth() const {return _depth;}
+inline	const	unsigned int	pitch() const {return ((_width * (_depth == 15 ? 16 : _depth) + 31) & ~31) >> 3;}
+inline	const	sPRESENTSTATS	&stats() const {return _stats;}
+virtual	const	char		*name() const = 0;
+
+	// Utilitarian
+
+virtual		unsigned char	*resize(const unsigned int width, const unsigned int height, const WORD depth);
+virtual		void		attach(unsigned char *frameBuffer) {}
+virtual		void		palette(const unsigned int *colors, const unsigned int count) {}
+virtual		bool		present(const CRect &rect);
+virtual		void		endFrame();
+virtual		bool		waitForVerticalBlank();
+
+protected:
+		unsigned int	_width, _height;
+		WORD		_depth;
+		sPRESENTSTATS	_stats;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// SetDIBitsToDevice (the original path)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	DIBPresenter : public Presenter
+{
+public:
+				DIBPresenter(CDC &dc);
+virtual				~DIBPresenter();
+
+virtual	const	char		*name() const {return "DIB";}
+virtual		unsigned char	*resize(const unsigned int width, const unsigned int height, const WORD depth);
+virtual		void		attach(unsigned char *frameBuffer);
+virtual		void		palette(const unsigned int *colors, const unsigned int count);
+virtual		bool		present(const CRect &rect);
+
+private:
+		winDIB		_dib;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// DIB section: the frame buffer lives in memory that GDI can read directly, so presenting is a BitBlt from a memory DC
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	DIBSectionPresenter : public Presenter
+{
+public:
+				DIBSectionPresenter(CDC &dc);
+virtual				~DIBSectionPresenter();
+
+virtual	const	char		*name() const {return "DIB section";}
+virtual		unsigned char	*resize(const unsigned int width, const unsigned int height, const WORD depth);
+virtual		void		palette(const unsigned int *colors, const unsigned int count);
+virtual		bool		present(const CRect &rect);
+virtual		void		endFrame();
+
+private:
+		void		release();
+
+		CDC		&_dc;
+		winDIB		_dib;			// Describes the section's format
+		HDC		_memDC;
+		HBITMAP		_section;
+		HGDIOBJ		_oldBitmap;
+		unsigned char	*_bits;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Headless (benchmarking without the cost of the display, or running without one)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	NullPresenter : public Presenter
+{
+public:
+virtual	const	char		*name() const {return "null";}
+virtual		bool		waitForVerticalBlank() {return false;}
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+Presenter	*createPresenter(const PresenterType type, CDC &dc);
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Presenter.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
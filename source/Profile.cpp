@@ -0,0 +1,169 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____             __ _ _                           
+// |  __ \           / _(_) |                          
+// | |__) |_ __ ___ | |_ _| | ___      ___ _ __  _ __  
+// |  ___/| '__/ _ \|  _| | |/ _ \    / __| '_ \| '_ \ 
+// | |    | | | (_) | | | | |  __/ _ | (__| |_) | |_) |
+// |_|    |_|  \___/|_| |_|_|\___|(_) \___| .__/| .__/ 
+//                                        | |   | |    
+//                                        |_|   |_|    
+//
+// Hot-path timers and per-frame counters
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// Timers read the processor's time stamp counter, which costs a few dozen cycles (a QueryPerformanceCounter call can cost a
+// microsecond on some systems), so they can go around the span loops without swamping what they measure.  Ticks are converted to
+// seconds at the end of each frame, against the frame's length by the performance counter, so the TSC's rate never needs to be
+// known.  (That assumes the TSC runs at a constant rate, as it does on anything from the last decade or so.)
+//
+// Timers are flat: nothing is timed twice, so the times add up to less than the frame, and the difference is everything that
+// isn't instrumented.  Counters and timers are plain globals, updated only from the render thread.  With a swap chain, the
+// present timer measures handing the frame over, not the present itself (that's on the present thread.)
+//
+// With USE_TRACE, each timer also adds an event to the trace when it stops, except inside a PROFILE_TRACE_SUMMARY (around the
+// scene's drawing), where the mappers' per-polygon timers would add thousands a frame.  There, each timer gets one event for the
+// whole summary.
+//
+// With USE_PROFILE undefined, none of this is compiled, and the macros in Profile.h expand to nothing.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+#ifdef	USE_PROFILE
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The frame in progress (its times are kept in ticks until the frame ends) and the last one finished
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+sFRAMECOUNTERS		profileCounters;
+unsigned __int64	profileTicks[PROFILE_TIMERS];
+
+static	sFRAMECOUNTERS		lastFrame;
+static	unsigned __int64	frameStartTicks;
+static	double			frameStartSeconds;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	profileBeginFrame()
+{
+	memset(&profileCounters, 0, sizeof(profileCounters));
+	memset(profileTicks, 0, sizeof(profileTicks));
+
+	frameStartSeconds = seconds();
+	frameStartTicks = readTicks();
+
+	#ifdef USE_TRACE
+	traceFrame(frameStartTicks);
+	#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	profileEndFrame()
+{
+	unsigned __int64	end = readTicks();
+	unsigned __int64	ticks = end - frameStartTicks;
+	double			elapsed = seconds() - frameStartSeconds;
+	double			secondsPerTick = ticks ? elapsed / (double) (__int64) ticks : 0;
+
+	for (unsigned int i = 0; i < PROFILE_TIMERS; i++)
+	{
+		profileCounters.time[i] = (double) (__int64) profileTicks[i] * secondsPerTick;
+	}
+
+	profileCounters.frameTime = elapsed;
+	lastFrame = profileCounters;
+
+	#ifdef USE_TRACE
+	traceEvent("frame", frameStartTicks, end);
+	#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Trace summaries.  While one is open, the timers add up their ticks as usual but don't add events to the trace; when it closes,
+// each timer's share of it goes into the trace as a single event.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef	USE_TRACE
+
+unsigned int		profileTraceSummaries = 0;
+
+		ProfileTraceSummary::ProfileTraceSummary(const char *name)
+		:_name(name), _start(readTicks())
+{
+	memcpy(_ticks, profileTicks, sizeof(_ticks));
+	profileTraceSummaries++;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		ProfileTraceSummary::~ProfileTraceSummary()
+{
+	unsigned __int64	end = readTicks();
+	unsigned __int64	at = _start;
+
+	for (unsigned int i = 0; i < PROFILE_TIMERS; i++)
+	{
+		unsigned __int64	ticks = profileTicks[i] - _ticks[i];
+		if (!ticks) continue;
+
+		traceEvent(profileTimerName((ProfileTimer) i), at, at + ticks);
+		at += ticks;
+	}
+
+	traceEvent(_name, _start, end);
+	profileTraceSummaries--;
+}
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	sFRAMECOUNTERS &profileLastFrame()
+{
+	return lastFrame;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	char	*profileTimerName(const ProfileTimer timer)
+{
+	switch(timer)
+	{
+		case PROFILE_CULL:	return "cull";
+		case PROFILE_TRANSFORM:	return "transform";
+		case PROFILE_CLEAR:	return "clear";
+		case PROFILE_EDGES:	return "edges";
+		case PROFILE_SPANS:	return "spans";
+		case PROFILE_PRESENT:	return "present";
+		default:		return "?";
+	}
+}
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Profile.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,157 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____             __ _ _          _     
+// |  __ \           / _(_) |        | |    
+// | |__) |_ __ ___ | |_ _| | ___    | |__  
+// |  ___/| '__/ _ \|  _| | |/ _ \   | '_ \ 
+// | |    | | | (_) | | | | |  __/ _ | | | |
+// |_|    |_|  \___/|_| |_|_|\___|(_)|_| |_|
+//                                          
+//                                          
+//
+// Hot-path timers and per-frame counters
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_PROFILE
+#define	_H_PROFILE
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The timers
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+enum	ProfileTimer
+{
+	PROFILE_CULL,				// Finding the parts of the scene in view
+	PROFILE_TRANSFORM,			// Rotating, projecting and lighting the vertices
+	PROFILE_CLEAR,				// Clearing the frame buffer
+	PROFILE_EDGES,				// Edge setup in the mappers
+	PROFILE_SPANS,				// Filling the spans
+	PROFILE_PRESENT,			// Getting the frame to the display (or the swap chain)
+	PROFILE_TIMERS
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// A frame's worth of counters
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	framecounters
+{
+	unsigned int	polygonsSubmitted;
+	unsigned int	polygonsCulled;		// Entirely off-screen (or facing away)
+	unsigned int	polygonsDrawn;
+	unsigned int	verticesTransformed;
+	unsigned int	spans;
+	unsigned int	pixels;
+	unsigned int	subSpans;		// Affine runs in the sub-affine mappers
+	double		time[PROFILE_TIMERS];	// In seconds
+	double		frameTime;
+} sFRAMECOUNTERS;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Instrumentation.  Without USE_PROFILE, the macros expand to nothing.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef	USE_PROFILE
+
+extern	sFRAMECOUNTERS		profileCounters;
+extern	unsigned __int64	profileTicks[PROFILE_TIMERS];
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	profileBeginFrame();
+void	profileEndFrame();
+const	sFRAMECOUNTERS &profileLastFrame();
+const	char	*profileTimerName(const ProfileTimer timer);
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Adds the time since 'start' to a timer (and to the trace, if there is one)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef	USE_TRACE
+extern	unsigned int		profileTraceSummaries;
+#endif
+
+inline	void	profileAdd(const ProfileTimer timer, const unsigned __int64 start)
+{
+	unsigned __int64	end = readTicks();
+	profileTicks[timer] += end - start;
+
+	#ifdef USE_TRACE
+	if (!profileTraceSummaries) traceEvent(profileTimerName(timer), start, end);
+	#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Adds the time from construction to destruction to a timer
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	ProfileScope
+{
+public:
+inline				ProfileScope(const ProfileTimer timer) :_timer(timer), _start(readTicks()) {}
+inline				~ProfileScope() {profileAdd(_timer, _start);}
+
+private:
+		ProfileTimer	_timer;
+		unsigned __int64 _start;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Traces a stretch of drawing as one event, with one event per timer inside it (for the time that timer added up to, laid end to
+// end from the start), instead of an event every time a timer stops.  The mappers time their stages for every polygon, which would
+// fill the trace's ring many times over in a frame.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef	USE_TRACE
+
+class	ProfileTraceSummary
+{
+public:
+				ProfileTraceSummary(const char *name);
+				~ProfileTraceSummary();
+
+private:
+	const	char		*_name;
+		unsigned __int64 _start;
+		unsigned __int64 _ticks[PROFILE_TIMERS];
+};
+
+#define	PROFILE_TRACE_SUMMARY(name)	ProfileTraceSummary profileTraceSummary(name)
+
+#else
+
+#define	PROFILE_TRACE_SUMMARY(name)
+
+#endif
+
+#define	PROFILE_SCOPE(timer)		ProfileScope profileScope##timer(timer)
+#define	PROFILE_START(timer)		unsigned __int64 profileStart##timer = readTicks()
+#define	PROFILE_STOP(timer)		profileAdd(timer, profileStart##timer)
+#define	PROFILE_COUNT(counter, n)	(profileCounters.counter += (n))
+
+#else
+
+#define	PROFILE_SCOPE(timer)
+#define	PROFILE_START(timer)
+#define	PROFILE_STOP(timer)
+#define	PROFILE_COUNT(counter, n)
+#define	PROFILE_TRACE_SUMMARY(name)
+
+#endif
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Profile.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
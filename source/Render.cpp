@@ -1,247 +1,1037 @@
-// ---------------------------------------------------------------------------------------------------------------------------------
-//  _____                 _                                
-// |  __ \               | |                               
-// | |__) | ___ _ __   __| | ___ _ __      ___ _ __  _ __  
-// |  _  / / _ \ '_ \ / _` |/ _ \ '__|    / __| '_ \| '_ \ 
-// | | \ \|  __/ | | | (_| |  __/ |    _ | (__| |_) | |_) |
-// |_|  \_\\___|_| |_|\__,_|\___|_|   (_) \___| .__/| .__/ 
-//                                            | |   | |    
-//                                            |_|   |_|    
-//
-// Best viewed with 8-character tabs and (at least) 132 columns
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-//
-// Originally released under a custom license.
-// This historical re-release is provided under the MIT License.
-// See the LICENSE file in the repo root for details.
-//
-// https://github.com/nettlep
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Originally created on 12/22/2000 by Paul Nettle
-//
-// Copyright 2000, Fluid Studios, Inc., all rights reserved.
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-#include "stdafx.h"
-#include <math.h>
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-#ifdef _DEBUG
-#undef THIS_FILE
-static char THIS_FILE[]=__FILE__;
-#define new DEBUG_NEW
-#endif
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-		Render::Render(CDC &dc, CWnd &window)
-		:_window(window), _dc(dc), _dib(dc), _width(0), _height(0), _frameBuffer(NULL)
-{
-	// Setup the window stuff
-
-	updateWindowPosition();
-
-	// Init the texture mapper
-
-	drawTexture();
-
-	// Setup the 4 adjacent polygons
-
-	p0[0].x = -1.0; p0[0].y = -1.0; p0[0].z =  1.0; p0[0].next = &p0[1];
-	p0[1].x =    0; p0[1].y = -1.0; p0[1].z =  1.0; p0[1].next = &p0[2];
-	p0[2].x =    0; p0[2].y =    0; p0[2].z =    0; p0[2].next = &p0[3];
-	p0[3].x = -1.0; p0[3].y =    0; p0[3].z =    0; p0[3].next = NULL;
-
-	p1[0].x =    0; p1[0].y = -1.0; p1[0].z =  1.0; p1[0].next = &p1[1];
-	p1[1].x =  1.0; p1[1].y = -1.0; p1[1].z =  1.0; p1[1].next = &p1[2];
-	p1[2].x =  1.0; p1[2].y =    0; p1[2].z =    0; p1[2].next = &p1[3];
-	p1[3].x =    0; p1[3].y =    0; p1[3].z =    0; p1[3].next = NULL;
-
-	p2[0].x = -1.0; p2[0].y =    0; p2[0].z =    0; p2[0].next = &p2[1];
-	p2[1].x =    0; p2[1].y =    0; p2[1].z =    0; p2[1].next = &p2[2];
-	p2[2].x =    0; p2[2].y =  1.0; p2[2].z = -1.0; p2[2].next = &p2[3];
-	p2[3].x = -1.0; p2[3].y =  1.0; p2[3].z = -1.0; p2[3].next = NULL;
-
-	p3[0].x =    0; p3[0].y =    0; p3[0].z =    0; p3[0].next = &p3[1];
-	p3[1].x =  1.0; p3[1].y =    0; p3[1].z =    0; p3[1].next = &p3[2];
-	p3[2].x =  1.0; p3[2].y =  1.0; p3[2].z = -1.0; p3[2].next = &p3[3];
-	p3[3].x =    0; p3[3].y =  1.0; p3[3].z = -1.0; p3[3].next = NULL;
-
-	polys[0] = p0;
-	polys[1] = p1;
-	polys[2] = p2;
-	polys[3] = p3;
-	polyCount = 4;
-	theta = 0.0;
-}
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-		Render::~Render()
-{
-	delete[] _frameBuffer;
-}
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-void		Render::clear(unsigned int color)
-{
-	if (!color)
-	{
-		memset(_frameBuffer, 0, width() * height() *sizeof(unsigned int));
-	}
-	else
-	{
-		unsigned int	size = width() * height();
-		unsigned int	*ptr = _frameBuffer;
-
-		for (unsigned int i = 0; i < size; i++, ptr++)
-		{
-			*ptr = color;
-		}
-	}
-}
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-bool		Render::updateWindowPosition()
-{
-	// The new DIB dimensions
-
-	{
-		CRect	clientRect;
-		window().GetClientRect(clientRect);
-		unsigned int	w = clientRect.Width();
-		unsigned int	h = clientRect.Height();
-
-		// Bail if we don't have any dimension
-
-		if (!w || !h) return true;
-
-		// Bail if there's no change
-
-		if (width() == w && height() == h && frameBuffer()) return true;
-
-		// Update
-
-		width() = w;
-		height() = h;
-	}
-
-	// Reallocate our frame buffer
-
-	delete[] _frameBuffer;
-	_frameBuffer = new unsigned int[width()*height()];
-	if (!_frameBuffer) return false;
-
-	// Setup the dib
-
-	dib().dstRect() = CRect(0, 0, width(), height());
-	dib().srcRect() = CRect(0, 0, width(), height());
-	dib().frameBuffer((unsigned char *) frameBuffer(), width(), height());
-	dib().depth(32);
-	
-	// Done
-
-	return true;
-}
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-bool		Render::renderFrame()
-{
-	// Clear the frame buffer
-
-	clear();
-
-	// Animate
-
-	const	double	speed = 30.0;
-	theta   += 0.0003 * speed;
-
-	// Draw the polygons
-
-	for (int i = 0; i < polyCount; i++)
-	{
-		// Temporary polygon
-
-		sVERT	poly[4];
-
-		// Offset/scale the vertices
-
-		sVERT	*src = polys[i];
-		sVERT	*dst = poly;
-
-		while(src)
-		{
-			// Rotate
-
-			dst->u = src->x * (0.49f * textureWidth)  + (0.5f * textureWidth);
-			dst->v = src->y * (0.49f * textureHeight) + (0.5f * textureHeight);
-			dst->w = 1.0f;
-			dst->x = src->x * (float) cos(theta) - src->y * (float) sin(theta);
-			dst->y = src->x * (float) sin(theta) + src->y * (float) cos(theta);
-			dst->z = src->z;
-
-			// Scale
-
-			dst->x *= width() * 3;
-			dst->y *= height() * 3;
-			dst->z *= 10.0;
-			dst->z += 20.0;
-
-			// Project
-
-			#ifndef USE_AFFINE
-			dst->u /= dst->z;
-			dst->v /= dst->z;
-			dst->w /= dst->z;
-			#endif
-			dst->x /= dst->z;
-			dst->y /= dst->z;
-
-			// Offset to screen center
-
-			dst->x += width()  / 2.0f + 0.5f;
-			dst->y += height() / 2.0f + 0.5f;
-
-			// Terminate the list
-
-			dst->next = src->next ? &dst[1] : NULL;
-
-			// Next!
-
-			src = src->next;
-			dst = dst->next;
-		}
-
-		// Do some drawing...
-
-		#ifdef USE_AFFINE
-		drawAffineTexturedPolygon(poly, frameBuffer(), width());
-		#endif
-
-		#ifdef USE_EXACT_PERSPECTIVE
-		drawPerspectiveTexturedPolygon(poly, frameBuffer(), width());
-		#endif
-
-		#ifdef USE_SUB_AFFINE_PERSPECTIVE
-		drawSubPerspectiveTexturedPolygon(poly, frameBuffer(), width());
-		#endif
-	}
-
-	// Update the screen
-
-	flip();
-
-	// Done
-
-	return true;
-}
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Render.cpp - End of file
-// ---------------------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____                 _                                
+// |  __ \               | |                               
+// | |__) | ___ _ __   __| | ___ _ __      ___ _ __  _ __  
+// |  _  / / _ \ '_ \ / _` |/ _ \ '__|    / __| '_ \| '_ \ 
+// | | \ \|  __/ | | | (_| |  __/ |    _ | (__| |_) | |_) |
+// |_|  \_\\___|_| |_|\__,_|\___|_|   (_) \___| .__/| .__/ 
+//                                            | |   | |    
+//                                            |_|   |_|    
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Originally created on 12/22/2000 by Paul Nettle
+//
+// Copyright 2000, Fluid Studios, Inc., all rights reserved.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <math.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns the screen rectangle that a polygon can touch (clipped to the screen)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	CRect	polyBounds(const sVERT *verts, const unsigned int width, const unsigned int height)
+{
+	float	minX = verts->x, maxX = verts->x;
+	float	minY = verts->y, maxY = verts->y;
+
+	for (const sVERT *v = verts->next; v; v = v->next)
+	{
+		if (v->x < minX) minX = v->x;
+		if (v->x > maxX) maxX = v->x;
+		if (v->y < minY) minY = v->y;
+		if (v->y > maxY) maxY = v->y;
+	}
+
+	// The mappers draw from ceil(left) up to (but not including) ceil(right), so this has a pixel to spare
+
+	CRect	r((int) floor(minX), (int) floor(minY), (int) ceil(maxX) + 1, (int) ceil(maxY) + 1);
+	if (r.left < 0) r.left = 0;
+	if (r.top < 0) r.top = 0;
+	if (r.right > (int) width) r.right = width;
+	if (r.bottom > (int) height) r.bottom = height;
+	return r;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns true if a (projected) polygon winds clockwise on the screen -- facing the viewer
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	bool	isClockwise(const sVERT *verts)
+{
+	float	area = 0;
+
+	for (const sVERT *v = verts; v; v = v->next)
+	{
+		const	sVERT	*n = v->next ? v->next : verts;
+		area += v->x * n->y - n->x * v->y;
+	}
+
+	return area > 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The depth of the frame as presented
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#if	defined(USE_OUTPUT_DEPTH)
+static	const	WORD	presentDepth = USE_OUTPUT_DEPTH;
+#elif	defined(USE_RENDER_565)
+static	const	WORD	presentDepth = 16;
+#else
+static	const	WORD	presentDepth = 32;
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The mapper(s) the scene is drawn with, for the HUD
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef USE_HUD
+static	const	char	*mapperName =
+	#ifdef USE_AFFINE
+	"affine "
+	#endif
+	#ifdef USE_EXACT_PERSPECTIVE
+	"perspective "
+	#endif
+	#if	defined(USE_SUB_AFFINE_PERSPECTIVE) && defined(USE_RENDER_565)
+	"sub-affine 565 "
+	#elif	defined(USE_SUB_AFFINE_PERSPECTIVE)
+	"sub-affine "
+	#endif
+	#ifdef USE_VIRTUAL_TEXTURE
+	"virtual "
+	#endif
+	"";
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The mapper(s) and target depth, for the polygon recording
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef USE_POLY_RECORD
+static	const	unsigned int	recordMappers =
+	#ifdef USE_AFFINE
+	POLY_MAPPER_AFFINE |
+	#endif
+	#ifdef USE_EXACT_PERSPECTIVE
+	POLY_MAPPER_PERSPECTIVE |
+	#endif
+	#if	defined(USE_SUB_AFFINE_PERSPECTIVE) && defined(USE_RENDER_565)
+	POLY_MAPPER_SUB_AFFINE_565 |
+	#elif	defined(USE_SUB_AFFINE_PERSPECTIVE)
+	POLY_MAPPER_SUB_AFFINE |
+	#endif
+	#ifdef USE_VIRTUAL_TEXTURE
+	POLY_MAPPER_VIRTUAL |
+	#endif
+	0;
+
+#ifdef USE_RENDER_565
+static	const	unsigned int	recordDepth = 16;
+#else
+static	const	unsigned int	recordDepth = 32;
+#endif
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		Render::Render(CDC &dc, CWnd &window)
+		:_window(window), _dc(dc), _presenter(NULL), _presenterBuffer(false), _width(0), _height(0), _pitch(0), _frameBuffer(NULL), _capacity(0)
+{
+	// Record a timeline (before any of our threads start, so they're all in it)
+
+	#ifdef USE_TRACE
+	traceStart();
+	traceThreadName("render");
+	#endif
+
+	// How frames get to the display
+
+	#if	defined(USE_PRESENT_DIB_SECTION)
+	_presenter = createPresenter(PRESENT_DIB_SECTION, dc);
+	#elif	defined(USE_PRESENT_NULL)
+	_presenter = createPresenter(PRESENT_NULL, dc);
+	#else
+	_presenter = createPresenter(PRESENT_DIB, dc);
+	#endif
+
+	#ifdef USE_OUTPUT_DEPTH
+	_output = NULL;
+	_outputCapacity = 0;
+	#endif
+
+	#ifdef USE_DYNAMIC_RESOLUTION
+	_scaleBuffer = NULL;
+	_scaleCapacity = 0;
+	memset(&_scaleColumns, 0, sizeof(_scaleColumns));
+	_resolution.setup(USE_DYNAMIC_RESOLUTION / 1000.0);
+	#endif
+
+	// Setup the window stuff
+
+	updateWindowPosition();
+
+	// No tiled clear yet
+
+	memset(&_clearTiles, 0, sizeof(_clearTiles));
+
+	// The palette for 8-bit output
+
+	#ifdef USE_OUTPUT_DEPTH
+	#if USE_OUTPUT_DEPTH == 8
+	buildDefaultConvertPalette(_palette);
+	presenter().palette(_palette.colors, _palette.count);
+	#endif
+	#endif
+
+	// Init the texture mapper
+
+	drawTexture();
+
+	// Open the virtual texture (building a procedural one the first time through)
+
+	#ifdef USE_VIRTUAL_TEXTURE
+	if (!virtualTexture.open("virtual.vtx"))
+	{
+		VirtualTexture::build("virtual.vtx", 4096, 4096);
+		virtualTexture.open("virtual.vtx");
+	}
+	#endif
+
+	// Convert the texture to the compressed format
+
+	#if	defined(USE_RENDER_565)
+	createTexture(texture, TF_RGB565, defaultTexture().argb, textureWidth, textureHeight);
+	bindTexture(&texture);
+	#elif	defined(USE_TEXTURE_PAL8)
+	createTexture(texture, TF_PAL8, defaultTexture().argb, textureWidth, textureHeight);
+	bindTexture(&texture);
+	#elif	defined(USE_TEXTURE_BC1)
+	createTexture(texture, TF_BC1, defaultTexture().argb, textureWidth, textureHeight);
+	bindTexture(&texture);
+	#endif
+
+	// Setup the 4 adjacent polygons
+
+	buildScene(quadVertices);
+
+	// Load the mesh to draw in their place, with room to transform each of its vertices once a frame
+
+	#ifdef USE_MESH
+	#ifdef USE_MESH_REORDER
+	const	bool	reorder = true;
+	#else
+	const	bool	reorder = false;
+	#endif
+
+	_transformed = NULL;
+	_transformedDraw = NULL;
+	_drawNumber = 0;
+
+	if (_mesh.open(USE_MESH, 0, reorder))
+	{
+		_scene.add(_mesh);
+		_scene.build();
+
+		_transformed = new sVERT[_scene.vertexCount()];
+		_transformedDraw = new unsigned int[_scene.vertexCount()];
+		memset(_transformedDraw, 0, _scene.vertexCount() * sizeof(unsigned int));
+	}
+	#endif
+
+	theta = 0.0;
+	prevTheta = 0.0;
+	drawTheta = 0.0;
+	frameNumber = 0;
+
+	// The render target (redrawn every 4th frame)
+
+	#ifdef USE_RENDER_TARGET
+	renderTarget.create(128, 128, 4);
+	#endif
+
+	// Record the polygons of the first 600 frames (10 seconds, at 60Hz)
+
+	#ifdef USE_POLY_RECORD
+	_recorder.start(USE_POLY_RECORD, 600);
+	#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		Render::~Render()
+{
+	// Stop presenting (the swap chain's buffers go with it) and capturing
+
+	#ifdef USE_SWAP_CHAIN
+	_swapChain.destroy();
+	_frameBuffer = NULL;
+	#endif
+
+	#ifdef USE_CAPTURE
+	_capture.stop();
+	#endif
+
+	// Write out the timeline of the last few frames (now that the threads that add to it have stopped)
+
+	#ifdef USE_TRACE
+	traceWrite(USE_TRACE);
+	traceStop();
+	#endif
+
+	#ifdef USE_FRAME_EXPORT
+	if (_frameExport.isValid()) _frameBuffer = NULL;
+	_frameExport.destroy();
+	#endif
+
+	#if defined(USE_TEXTURE_PAL8) || defined(USE_TEXTURE_BC1) || defined(USE_RENDER_565)
+	bindTexture(NULL);
+	destroyTexture(texture);
+	#endif
+
+	bindClearTiles(NULL);
+	freeTiledClear(_clearTiles);
+
+	#ifdef USE_MESH
+	delete[] _transformed;
+	delete[] _transformedDraw;
+	#endif
+
+	#ifdef USE_DYNAMIC_RESOLUTION
+	poolFree(_scaleBuffer);
+	freeScaleColumns(_scaleColumns);
+	#endif
+
+	#ifdef USE_OUTPUT_DEPTH
+	if (!_presenterBuffer) poolFree(_output);
+	poolFree(_frameBuffer);
+	convertShutdown();
+	#else
+	if (!_presenterBuffer) poolFree(_frameBuffer);
+	#endif
+
+	delete _presenter;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Render::clear(unsigned int color)
+{
+	#ifdef USE_RENDER_565
+	clearBuffer(_frameBuffer, pitch() * height() / 2, argbTo565(color) * 0x10001);
+	#else
+	clearBuffer(_frameBuffer, pitch() * height(), color);
+	#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Render::clear(const CRect &rect, unsigned int color)
+{
+	#ifdef USE_RENDER_565
+	unsigned short	c = argbTo565(color);
+	unsigned short	*ptr = (unsigned short *) _frameBuffer + rect.top * pitch() + rect.left;
+
+	for (int y = rect.top; y < rect.bottom; y++, ptr += pitch())
+	{
+		for (int x = 0; x < rect.Width(); x++) ptr[x] = c;
+	}
+	#else
+	unsigned int	*ptr = _frameBuffer + rect.top * pitch() + rect.left;
+
+	for (int y = rect.top; y < rect.bottom; y++, ptr += pitch())
+	{
+		fillBuffer(ptr, rect.Width(), color);
+	}
+	#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Presents the frame.  With dirty rects, only what changed since the last frame is copied: what was drawn then (to erase it) and
+// what was drawn now.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Render::present()
+{
+	PROFILE_SCOPE(PROFILE_PRESENT);
+
+	// Record the frame (the capture thread takes a copy, so this is done before we move on to another buffer)
+
+	#ifdef USE_CAPTURE
+	_capture.submit(frameBuffer(), width(), height(), pitch());
+	#endif
+
+	#if	defined(USE_SWAP_CHAIN)
+	_presented.reset();
+	_presented.add(CRect(0, 0, width(), height()));
+
+	// Hand the frame to the present thread and move on to the next buffer
+
+	_swapChain.submit();
+	_frameBuffer = _swapChain.acquire();
+	#elif	defined(USE_DIRTY_RECTS)
+	_presented = _prevDirty;
+	_presented.add(_dirty);
+
+	for (unsigned int i = 0; i < _presented.count(); i++)
+	{
+		convertOutput(frameBuffer(), _presented[i]);
+		presenter().present(_presented[i]);
+	}
+
+	_prevDirty = _dirty;
+	presenter().endFrame();
+	#else
+	_presented.reset();
+	_presented.add(CRect(0, 0, width(), height()));
+	convertOutput(frameBuffer(), _presented[0]);
+	flip();
+	presenter().endFrame();
+
+	// Publish the frame for other processes, and draw the next one into the next buffer in the ring
+
+	#ifdef USE_FRAME_EXPORT
+	if (_frameExport.isValid())
+	{
+		_frameExport.publish();
+		_frameBuffer = _frameExport.acquire();
+
+		#ifndef USE_OUTPUT_DEPTH
+		presenter().attach((unsigned char *) frameBuffer());
+		#endif
+	}
+	#endif
+	#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Presents a whole frame from the given buffer (converting it first, if we're presenting at a different depth.)  With a swap chain,
+// this runs on the present thread.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Render::presentBuffer(unsigned int *buffer)
+{
+	TRACE_SCOPE("present buffer");
+
+	CRect	rect(0, 0, width(), height());
+
+	#ifdef USE_OUTPUT_DEPTH
+	convertOutput(buffer, rect);
+	#else
+	presenter().attach((unsigned char *) buffer);
+	#endif
+
+	presenter().present(rect);
+	presenter().endFrame();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	presentProc(void *context, unsigned int *buffer)
+{
+	((Render *) context)->presentBuffer(buffer);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Re-presents the whole frame (e.g. after the window is uncovered)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Render::flip()
+{
+	TRACE_SCOPE("flip");
+
+	#ifdef USE_SWAP_CHAIN
+	// The present thread has the presenter while frames are in flight, so wait for it, then present the last frame again
+
+	_swapChain.flush();
+	unsigned int	*last = _swapChain.lastPresented();
+	if (last) presentBuffer(last);
+	#else
+	presenter().present(CRect(0, 0, width(), height()));
+	#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Converts part of the frame to the output depth (a no-op when presenting at 32 bits)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Render::convertOutput(const unsigned int *buffer, const CRect &rect)
+{
+	#ifdef USE_OUTPUT_DEPTH
+	#ifdef USE_DITHER
+	const	bool	dither = true;
+	#else
+	const	bool	dither = false;
+	#endif
+
+	convertBuffer(buffer, pitch(), _output, presenter().pitch(), rect, USE_OUTPUT_DEPTH, dither, &_palette);
+	#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		Render::updateWindowPosition()
+{
+	// The new DIB dimensions
+
+	{
+		CRect	clientRect;
+		window().GetClientRect(clientRect);
+		unsigned int	w = clientRect.Width();
+		unsigned int	h = clientRect.Height();
+
+		// Bail if we don't have any dimension
+
+		if (!w || !h) return true;
+
+		// Bail if there's no change
+
+		if (width() == w && height() == h && frameBuffer()) return true;
+
+		// Update
+
+		width() = w;
+		height() = h;
+	}
+
+	// Stop presenting while we resize
+
+	#ifdef USE_SWAP_CHAIN
+	_swapChain.destroy();
+	_frameBuffer = NULL;
+	#endif
+
+	#ifdef USE_FRAME_EXPORT
+	if (_frameExport.isValid()) _frameBuffer = NULL;
+	_frameExport.destroy();
+	#endif
+
+	// A buffer the presenter shared with us (its DIB section's bits) goes when it resizes, so we mustn't hang on to it (or free it)
+
+	if (_presenterBuffer)
+	{
+		#ifdef USE_OUTPUT_DEPTH
+		_output = NULL;
+		#else
+		_frameBuffer = NULL;
+		#endif
+	}
+
+	// Set up the presenter
+
+	unsigned char	*shared = presenter().resize(width(), height(), presentDepth);
+
+	// A 16-bit frame buffer's scanlines are padded to an even width (the presenter wants them DWORD aligned)
+
+	#ifdef USE_RENDER_565
+	_pitch = (width() + 1) & ~1;
+	unsigned int	bytes = pitch() * height() * sizeof(unsigned short);
+	#else
+	_pitch = width();
+	unsigned int	bytes = pitch() * height() * sizeof(unsigned int);
+	#endif
+
+	// If the presenter shares its buffer with the display, the last stage (the frame buffer, or the converted output) goes
+	// straight into it
+
+	_presenterBuffer = shared != NULL;
+
+	#ifdef USE_OUTPUT_DEPTH
+	const	bool	sharedFrameBuffer = false;
+	#else
+	const	bool	sharedFrameBuffer = _presenterBuffer;
+	#endif
+
+	// Reallocate our frame buffer (only if it's outgrown the one we have.)  With a swap chain, the frame buffer is whichever of its
+	// buffers we're drawing into.
+
+	#if	defined(USE_SWAP_CHAIN)
+	if (!_swapChain.create(USE_SWAP_CHAIN, bytes, presentProc, this)) return false;
+	_frameBuffer = _swapChain.acquire();
+	#else
+	// Exported frames are drawn in shared memory, in a ring of three (so a reader has two frames' time to finish with one.)  If
+	// that fails, we carry on with a frame buffer of our own.
+
+	#ifdef USE_FRAME_EXPORT
+	#ifdef USE_RENDER_565
+	const	FrameExportFormat	format = FRAME_EXPORT_RGB565;
+	#else
+	const	FrameExportFormat	format = FRAME_EXPORT_XRGB8888;
+	#endif
+
+	if (_frameExport.create(USE_FRAME_EXPORT, width(), height(), bytes / height(), format, 3))
+	{
+		poolFree(_frameBuffer);
+		_capacity = 0;
+		_frameBuffer = _frameExport.acquire();
+	}
+	else
+	#endif
+	if (sharedFrameBuffer)
+	{
+		_frameBuffer = (unsigned int *) shared;
+	}
+	else if (!_frameBuffer || bytes > _capacity)
+	{
+		poolFree(_frameBuffer);
+		_capacity = 0;
+		_frameBuffer = (unsigned int *) poolAlloc(bytes, &_capacity);
+		if (!_frameBuffer) return false;
+	}
+	#endif
+
+	// The scene is drawn here at the scaled resolution (and it can go up to the full resolution)
+
+	#ifdef USE_DYNAMIC_RESOLUTION
+	if (!_scaleBuffer || bytes > _scaleCapacity)
+	{
+		poolFree(_scaleBuffer);
+		_scaleCapacity = 0;
+		_scaleBuffer = (unsigned int *) poolAlloc(bytes, &_scaleCapacity);
+		if (!_scaleBuffer) return false;
+	}
+	#endif
+
+	// The converted output
+
+	#ifdef USE_OUTPUT_DEPTH
+	if (_presenterBuffer)
+	{
+		_output = shared;
+	}
+	else if (!_output || presenter().pitch() * height() > _outputCapacity)
+	{
+		poolFree(_output);
+		_outputCapacity = 0;
+		_output = (unsigned char *) poolAlloc(presenter().pitch() * height(), &_outputCapacity);
+		if (!_output) return false;
+	}
+
+	presenter().attach(_output);
+	#else
+	presenter().attach((unsigned char *) frameBuffer());
+	#endif
+
+	// Capture at the first size we get (frames at any other size are skipped.)  The frame rate is nominal; we draw as fast as
+	// we can.
+
+	#ifdef USE_CAPTURE
+	#ifdef USE_RENDER_565
+	const	unsigned int	captureDepth = 16;
+	#else
+	const	unsigned int	captureDepth = 32;
+	#endif
+
+	if (!_capture.isCapturing())
+	{
+		_capture.start(USE_CAPTURE, FrameCapture::formatFromName(USE_CAPTURE), width(), height(), captureDepth, 60);
+	}
+	#endif
+
+	// The new frame buffer is garbage, so all of it needs clearing (and presenting) next frame
+
+	_prevDirty.reset();
+	_prevDirty.add(CRect(0, 0, width(), height()));
+	
+	// Done
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Advances the animation by one simulation step (in seconds)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Render::simulate(const double step)
+{
+	const	double	spin = 0.54;		// Radians per second
+
+	prevTheta = theta;
+	theta += spin * step;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Draws a frame, 'alpha' of the way from the previous simulation step to the latest one
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		Render::renderFrame(const double alpha)
+{
+	#ifdef USE_PROFILE
+	profileBeginFrame();
+	#endif
+
+	#ifdef USE_DYNAMIC_RESOLUTION
+	_resolution.beginFrame();
+	#endif
+
+	#ifdef USE_POLY_RECORD
+	_recorder.frame();
+	#endif
+
+	// Interpolate the animation
+
+	drawTheta = prevTheta + (theta - prevTheta) * alpha;
+
+	// Texture resolution that the UVs are scaled to
+
+	#ifdef USE_VIRTUAL_TEXTURE
+	if (!virtualTexture.isOpen()) return false;
+	const	float	texWidth  = (float) virtualTexture.width();
+	const	float	texHeight = (float) virtualTexture.height();
+	#else
+	const	float	texWidth  = (float) textureWidth;
+	const	float	texHeight = (float) textureHeight;
+	#endif
+
+	// Draw the scene (spinning the other way) into the render target every few frames, then texture the main scene with it
+
+	#ifdef USE_RENDER_TARGET
+	#if defined(USE_TEXTURE_PAL8) || defined(USE_TEXTURE_BC1)
+	const	sTEXTURE	*sceneTexture = &texture;
+	#else
+	const	sTEXTURE	*sceneTexture = NULL;
+	#endif
+
+	if (renderTarget.needsUpdate(frameNumber))
+	{
+		bindTexture(sceneTexture);
+		renderTarget.clear();
+
+		#ifdef USE_POLY_RECORD
+		_recorder.clear(renderTarget.buffer(), renderTarget.width(), renderTarget.height(), renderTarget.pitch(), 32, 0);
+		#endif
+
+		drawScene(renderTarget.buffer(), renderTarget.width(), renderTarget.height(), renderTarget.pitch(), -drawTheta * 2.0, texWidth, texHeight);
+		renderTarget.updated(frameNumber);
+	}
+
+	bindTexture(&renderTarget.texture());
+	const	float	sceneTexWidth  = (float) renderTarget.width();
+	const	float	sceneTexHeight = (float) renderTarget.height();
+	#else
+	const	float	sceneTexWidth  = texWidth;
+	const	float	sceneTexHeight = texHeight;
+	#endif
+
+	// With dynamic resolution, the scene is drawn smaller, then scaled up into the frame buffer
+
+	#ifdef USE_DYNAMIC_RESOLUTION
+	unsigned int	*target = _scaleBuffer;
+	unsigned int	targetWidth = _resolution.scaled(width());
+	unsigned int	targetHeight = _resolution.scaled(height());
+	#else
+	unsigned int	*target = frameBuffer();
+	unsigned int	targetWidth = width();
+	unsigned int	targetHeight = height();
+	#endif
+
+	// Clear the frame buffer (either up front, or as the polygons are drawn)
+	//
+	// With dirty rects, only what was drawn last frame needs clearing; everything else (including all of this frame's dirty rects
+	// that weren't dirty last frame) is still clear from before.
+
+	PROFILE_START(PROFILE_CLEAR);
+
+	#if	defined(USE_DIRTY_RECTS)
+	for (unsigned int r = 0; r < _prevDirty.count(); r++)
+	{
+		clear(_prevDirty[r]);
+	}
+	#elif	defined(USE_TILED_CLEAR)
+	#ifdef USE_RENDER_565
+	beginTiledClear(_clearTiles, target, pitch() / 2, targetHeight, 0);
+	#else
+	beginTiledClear(_clearTiles, target, pitch(), targetHeight, 0);
+	#endif
+	bindClearTiles(&_clearTiles);
+	#elif	defined(USE_DYNAMIC_RESOLUTION)
+	clearBuffer(target, pitch() * targetHeight, 0);
+	#else
+	clear();
+	#endif
+
+	PROFILE_STOP(PROFILE_CLEAR);
+	_dirty.reset();
+
+	// However it was done, the target is (or will be, where it's drawn) clear
+
+	#ifdef USE_POLY_RECORD
+	_recorder.clear(target, targetWidth, targetHeight, pitch(), recordDepth, 0);
+	#endif
+
+	// Draw the polygons
+
+	drawScene(target, targetWidth, targetHeight, pitch(), drawTheta, sceneTexWidth, sceneTexHeight, &_dirty);
+
+	// Finish the clear
+
+	#if	defined(USE_TILED_CLEAR) && !defined(USE_DIRTY_RECTS)
+	{
+		PROFILE_SCOPE(PROFILE_CLEAR);
+		bindClearTiles(NULL);
+		endTiledClear(_clearTiles);
+	}
+	#endif
+
+	// Page in whatever the virtual texture was missing this frame
+
+	#ifdef USE_VIRTUAL_TEXTURE
+	virtualTexture.update();
+	#endif
+
+	// Scale up to the window
+
+	#ifdef USE_DYNAMIC_RESOLUTION
+	scaleBilinear(target, targetWidth, targetHeight, pitch(), frameBuffer(), width(), height(), pitch(), _scaleColumns);
+	#endif
+
+	// The HUD goes over the finished frame (and gets presented, and cleared next frame, along with the polygons)
+
+	#ifdef USE_HUD
+	_dirty.add(_hud.draw(frameBuffer(), width(), height(), pitch(), mapperName));
+	#endif
+
+	// Update the screen
+
+	present();
+	frameNumber++;
+
+	#ifdef USE_DYNAMIC_RESOLUTION
+	_resolution.endFrame();
+	#endif
+
+	#ifdef USE_PROFILE
+	profileEndFrame();
+	#endif
+
+	// Done
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Draws the polygons into a buffer (the frame buffer or a render target), rotated by 'angle'.  If 'dirty' is given, the screen
+// bounds of every polygon are added to it.  With USE_RENDER_565, the buffer holds 16-bit pixels (and the pitch counts them.)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Render::drawScene(unsigned int *buffer, const unsigned int width, const unsigned int height, const unsigned int pitch,
+				  const double angle, const float texWidth, const float texHeight, DirtyRects *dirty)
+{
+	PROFILE_TRACE_SUMMARY("draw scene");
+
+	#ifdef USE_MESH
+	if (_scene.isBuilt())
+	{
+		drawMesh(buffer, width, height, pitch, angle, texWidth, texHeight, dirty);
+		return;
+	}
+	#endif
+
+	// Transform the vertices (each one once; the polygons share them)
+
+	PROFILE_START(PROFILE_TRANSFORM);
+
+	sSCENETRANSFORM	transform;
+	sVERT		transformed[sceneVertices];
+	setupSceneTransform(transform, width, height, angle, drawTheta, texWidth, texHeight);
+	transformSceneVertices(transform, quadVertices, transformed, sceneVertices);
+	PROFILE_COUNT(verticesTransformed, sceneVertices);
+
+	PROFILE_STOP(PROFILE_TRANSFORM);
+
+	for (unsigned int i = 0; i < scenePolygons; i++)
+	{
+		PROFILE_COUNT(polygonsSubmitted, 1);
+
+		// Temporary polygon
+
+		sVERT	poly[sceneVerts];
+		indexScenePolygon(transformed, sceneIndices[i], sceneVerts, poly);
+
+		drawPolygon(poly, buffer, width, height, pitch, dirty);
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Draws the scene of meshes, scaled to fit the same space as the quads (so it goes through the same transform.)  Only the chunks
+// in view are drawn.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef	USE_MESH
+void		Render::drawMesh(unsigned int *buffer, const unsigned int width, const unsigned int height, const unsigned int pitch,
+				 const double angle, const float texWidth, const float texHeight, DirtyRects *dirty)
+{
+	#ifdef USE_MESH_ZOOM
+	const	float	zoom = USE_MESH_ZOOM;
+	#else
+	const	float	zoom = 1.0f;
+	#endif
+
+	// Centered, and scaled into the unit sphere
+
+	const	sBVHBOX	&bounds = _scene.bounds();
+	float		center[3];
+	float		diagonal = 0;
+
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		float	extent = bounds.maximum[axis] - bounds.minimum[axis];
+		center[axis] = (bounds.minimum[axis] + bounds.maximum[axis]) * 0.5f;
+		diagonal += extent * extent;
+	}
+
+	const	float	scale = diagonal > 0 ? 2.0f / (float) sqrt(diagonal) : 1.0f;
+
+	// Find the chunks in view (the view is moved into the scene's space, rather than the other way around)
+
+	PROFILE_START(PROFILE_CULL);
+
+	sBVHPLANE	planes[4];
+	sceneFrustum(planes, width, height, angle, zoom);
+
+	for (unsigned int p = 0; p < 4; p++)
+	{
+		sBVHPLANE	&plane = planes[p];
+		plane.distance -= (plane.normal[0] * center[0] + plane.normal[1] * center[1] + plane.normal[2] * center[2]) * scale;
+		for (unsigned int axis = 0; axis < 3; axis++) plane.normal[axis] *= scale;
+	}
+
+	_scene.cull(planes, 4);
+
+	PROFILE_STOP(PROFILE_CULL);
+
+	// A vertex is transformed the first time a polygon in view uses it, and stamped with the draw, so it's only transformed once
+	// (and the ones out of view not at all)
+
+	sSCENETRANSFORM	transform;
+	setupSceneTransform(transform, width, height, angle, drawTheta, texWidth, texHeight, zoom);
+
+	if (!++_drawNumber)
+	{
+		memset(_transformedDraw, 0, _scene.vertexCount() * sizeof(unsigned int));
+		_drawNumber = 1;
+	}
+
+	for (unsigned int c = 0; c < _scene.visibleCount(); c++)
+	{
+		const	sSCENEOBJECT	&object = _scene.visibleObject(c);
+		const	sMESHCHUNK	&chunk = _scene.visibleChunk(c);
+		const	Mesh		&mesh = *object.mesh;
+		const	sMESHVERTEX	*vertices = mesh.vertices();
+		sVERT			*transformed = _transformed + object.firstVertex;
+		unsigned int		*transformedDraw = _transformedDraw + object.firstVertex;
+
+		float	offset[3];
+		for (unsigned int axis = 0; axis < 3; axis++) offset[axis] = object.position[axis] - center[axis];
+
+		for (unsigned int i = chunk.firstPolygon; i < chunk.firstPolygon + chunk.polygonCount; i++)
+		{
+			PROFILE_COUNT(polygonsSubmitted, 1);
+
+			const	unsigned int	*index = mesh.polygon(i);
+			const	unsigned int	count = mesh.polygonSize(i);
+
+			// Transform the vertices that haven't been yet
+
+			PROFILE_START(PROFILE_TRANSFORM);
+
+			for (unsigned int j = 0; j < count; j++)
+			{
+				const	unsigned int	k = index[j];
+				if (transformedDraw[k] == _drawNumber) continue;
+
+				const	sMESHVERTEX	&v = vertices[k];
+				sVERT			model;
+				model.x = (v.x + offset[0]) * scale;
+				model.y = (v.y + offset[1]) * scale;
+				model.z = (v.z + offset[2]) * scale;
+
+				transformSceneVertices(transform, &model, &transformed[k], 1);
+				transformedDraw[k] = _drawNumber;
+				PROFILE_COUNT(verticesTransformed, 1);
+			}
+
+			PROFILE_STOP(PROFILE_TRANSFORM);
+
+			// Temporary polygon
+
+			sVERT	poly[meshMaxVerts];
+			indexScenePolygon(transformed, index, count, poly);
+
+			// There's no depth buffer, so the back faces have to go
+
+			if (!isClockwise(poly))
+			{
+				PROFILE_COUNT(polygonsCulled, 1);
+				continue;
+			}
+
+			drawPolygon(poly, buffer, width, height, pitch, dirty);
+		}
+	}
+}
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Hands a transformed polygon to the mappers (clipped to the screen, unless it's entirely off-screen)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		Render::drawPolygon(sVERT *poly, unsigned int *buffer, const unsigned int width, const unsigned int height,
+				    const unsigned int pitch, DirtyRects *dirty)
+{
+	// Skip it if it's entirely off-screen, clip it if it's partly off-screen (the mappers don't clip), and track where it lands
+
+	CRect	bounds = polyBounds(poly, width, height);
+	sVERT	clipped[clipMaxVerts];
+
+	if (!bounds.IsRectEmpty()) poly = clipPolygon(poly, clipped, width, height);
+
+	if (bounds.IsRectEmpty() || !poly)
+	{
+		PROFILE_COUNT(polygonsCulled, 1);
+		return;
+	}
+
+	if (dirty) dirty->add(bounds);
+	PROFILE_COUNT(polygonsDrawn, 1);
+
+	#ifdef USE_POLY_RECORD
+	_recorder.polygon(recordMappers, poly, buffer, width, height, pitch, recordDepth);
+	#endif
+
+	// Do some drawing...
+
+	#ifdef USE_AFFINE
+	drawAffineTexturedPolygon(poly, buffer, pitch);
+	#endif
+
+	#ifdef USE_EXACT_PERSPECTIVE
+	drawPerspectiveTexturedPolygon(poly, buffer, pitch);
+	#endif
+
+	#ifdef USE_SUB_AFFINE_PERSPECTIVE
+	#ifdef USE_RENDER_565
+	drawSubPerspectiveTexturedPolygon16(poly, (unsigned short *) buffer, pitch);
+	#else
+	drawSubPerspectiveTexturedPolygon(poly, buffer, pitch);
+	#endif
+	#endif
+
+	#ifdef USE_VIRTUAL_TEXTURE
+	drawVirtualTexturedPolygon(poly, buffer, pitch, virtualTexture);
+	#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Render.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
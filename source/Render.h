@@ -1,81 +1,159 @@
-// ---------------------------------------------------------------------------------------------------------------------------------
-//  _____                 _               _     
-// |  __ \               | |             | |    
-// | |__) | ___ _ __   __| | ___ _ __    | |__  
-// |  _  / / _ \ '_ \ / _` |/ _ \ '__|   | '_ \ 
-// | | \ \|  __/ | | | (_| |  __/ |    _ | | | |
-// |_|  \_\\___|_| |_|\__,_|\___|_|   (_)|_| |_|
-//                                              
-//                                              
-//
-// Best viewed with 8-character tabs and (at least) 132 columns
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-//
-// Originally released under a custom license.
-// This historical re-release is provided under the MIT License.
-// See the LICENSE file in the repo root for details.
-//
-// https://github.com/nettlep
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Originally created on 12/22/2000 by Paul Nettle
-//
-// Copyright 2000, Fluid Studios, Inc., all rights reserved.
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-#ifndef	_H_RENDER
-#define	_H_RENDER
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-class	Render  
-{
-public:
-	// Construction/Destruction
-
-				Render(CDC &dc, CWnd &window);
-virtual				~Render();
-
-	// Accessors
-
-inline		CWnd		&window() {return _window;}
-inline		CDC		&dc() {return _dc;}
-inline		winDIB		&dib() {return _dib;}
-
-inline	const	unsigned int	&width() const {return _width;}
-inline		unsigned int	&width() {return _width;}
-
-inline	const	unsigned int	&height() const {return _height;}
-inline		unsigned int	&height() {return _height;}
-
-inline	const	unsigned int	*frameBuffer() const {return _frameBuffer;}
-inline		unsigned int	*frameBuffer() {return _frameBuffer;}
-
-	// Utilitarian
-
-inline		void		flip() {dib().copyToDisplay();}
-virtual		void		clear(unsigned int color = 0);
-virtual		bool		updateWindowPosition();
-virtual		bool		renderFrame();
-
-private:
-		CWnd		&_window;
-		CDC		&_dc;
-		winDIB		_dib;
-		unsigned int	_width, _height;
-		unsigned int	*_frameBuffer;
-
-		sVERT		p0[4];
-		sVERT		p1[4];			
-		sVERT		p2[4];			
-		sVERT		p3[4];			
-		sVERT		*polys[4];
-		int		polyCount;
-		double		theta;
-};
-
-#endif
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Render.h - End of file
-// ---------------------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____                 _               _     
+// |  __ \               | |             | |    
+// | |__) | ___ _ __   __| | ___ _ __    | |__  
+// |  _  / / _ \ '_ \ / _` |/ _ \ '__|   | '_ \ 
+// | | \ \|  __/ | | | (_| |  __/ |    _ | | | |
+// |_|  \_\\___|_| |_|\__,_|\___|_|   (_)|_| |_|
+//                                              
+//                                              
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Originally created on 12/22/2000 by Paul Nettle
+//
+// Copyright 2000, Fluid Studios, Inc., all rights reserved.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_RENDER
+#define	_H_RENDER
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	Render  
+{
+public:
+	// Construction/Destruction
+
+				Render(CDC &dc, CWnd &window);
+virtual				~Render();
+
+	// Accessors
+
+inline		CWnd		&window() {return _window;}
+inline		CDC		&dc() {return _dc;}
+inline		Presenter	&presenter() {return *_presenter;}
+
+inline	const	unsigned int	&width() const {return _width;}
+inline		unsigned int	&width() {return _width;}
+
+inline	const	unsigned int	&height() const {return _height;}
+inline		unsigned int	&height() {return _height;}
+
+inline	const	unsigned int	&pitch() const {return _pitch;}
+
+inline	const	unsigned int	*frameBuffer() const {return _frameBuffer;}
+inline		unsigned int	*frameBuffer() {return _frameBuffer;}
+
+inline	const	DirtyRects	&dirtyRects() const {return _dirty;}
+inline		DirtyRects	&dirtyRects() {return _dirty;}
+inline	const	DirtyRects	&presentedRects() const {return _presented;}
+
+	// Utilitarian
+
+virtual		void		clear(unsigned int color = 0);
+virtual		void		clear(const CRect &rect, unsigned int color = 0);
+virtual		void		flip();
+virtual		void		present();
+virtual		void		presentBuffer(unsigned int *buffer);
+virtual		void		convertOutput(const unsigned int *buffer, const CRect &rect);
+virtual		bool		updateWindowPosition();
+virtual		void		simulate(const double step);
+virtual		bool		renderFrame(const double alpha = 1.0);
+virtual		void		drawScene(unsigned int *buffer, const unsigned int width, const unsigned int height, const unsigned int pitch,
+					  const double angle, const float texWidth, const float texHeight, DirtyRects *dirty = NULL);
+
+private:
+virtual		void		drawPolygon(sVERT *poly, unsigned int *buffer, const unsigned int width, const unsigned int height,
+					    const unsigned int pitch, DirtyRects *dirty);
+		#ifdef USE_MESH
+virtual		void		drawMesh(unsigned int *buffer, const unsigned int width, const unsigned int height, const unsigned int pitch,
+					 const double angle, const float texWidth, const float texHeight, DirtyRects *dirty);
+		#endif
+
+		CWnd		&_window;
+		CDC		&_dc;
+		Presenter	*_presenter;
+		bool		_presenterBuffer;	// True if the presenter owns the last buffer we draw (or convert) into
+		unsigned int	_width, _height;
+		unsigned int	_pitch;			// In pixels (16-bit pixels with USE_RENDER_565)
+		unsigned int	*_frameBuffer;
+		unsigned int	_capacity;		// Size of the frame buffer allocation (in bytes)
+		sCLEARTILES	_clearTiles;
+		DirtyRects	_dirty;
+		DirtyRects	_prevDirty;
+		DirtyRects	_presented;
+
+		#ifdef USE_SWAP_CHAIN
+		SwapChain	_swapChain;
+		#endif
+
+		#ifdef USE_FRAME_EXPORT
+		FrameExport	_frameExport;
+		#endif
+
+		#ifdef USE_CAPTURE
+		FrameCapture	_capture;
+		#endif
+
+		#ifdef USE_DYNAMIC_RESOLUTION
+		DynamicResolution _resolution;
+		unsigned int	*_scaleBuffer;		// The scene, drawn at the scaled resolution (with the frame buffer's pitch)
+		unsigned int	_scaleCapacity;
+		sSCALECOLUMNS	_scaleColumns;
+		#endif
+
+		#ifdef USE_HUD
+		Hud		_hud;
+		#endif
+
+		#ifdef USE_POLY_RECORD
+		PolyRecorder	_recorder;
+		#endif
+
+		#ifdef USE_OUTPUT_DEPTH
+		unsigned char	*_output;		// The frame, converted to the output depth
+		unsigned int	_outputCapacity;
+		sCONVERTPALETTE	_palette;
+		#endif
+
+		sVERT		quadVertices[sceneVertices];
+		double		theta;
+		double		prevTheta;		// At the previous simulation step
+		double		drawTheta;		// Interpolated to the frame being drawn
+		unsigned int	frameNumber;
+
+		#ifdef USE_MESH
+		Mesh		_mesh;
+		MeshScene	_scene;
+		sVERT		*_transformed;		// Every vertex in the scene, as it was last transformed
+		unsigned int	*_transformedDraw;	// The draw each one was transformed for
+		unsigned int	_drawNumber;
+		#endif
+
+		#ifdef USE_VIRTUAL_TEXTURE
+		VirtualTexture	virtualTexture;
+		#endif
+
+		#if defined(USE_TEXTURE_PAL8) || defined(USE_TEXTURE_BC1) || defined(USE_RENDER_565)
+		sTEXTURE	texture;
+		#endif
+
+		#ifdef USE_RENDER_TARGET
+		RenderTarget	renderTarget;
+		#endif
+};
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Render.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,109 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____                 _        _______                    _                        
+// |  __ \               | |      |__   __|                  | |                       
+// | |__) | ___ _ __   __| | ___ _ __| |  __ _ _ __ __ _  ___| |_      ___ _ __  _ __  
+// |  _  / / _ \ '_ \ / _` |/ _ \ '__| | / _` | '__/ _` |/ _ \ __|    / __| '_ \| '_ \ 
+// | | \ \|  __/ | | | (_| |  __/ |  | || (_| | | | (_| |  __/ |_  _ | (__| |_) | |_) |
+// |_|  \_\\___|_| |_|\__,_|\___|_|  |_| \__,_|_|  \__, |\___|\__|(_) \___| .__/| .__/ 
+//                                                  __/ |                 | |   | |    
+//                                                 |___/                  |_|   |_|    
+//
+// Render targets (off-screen buffers that double as textures)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		RenderTarget::RenderTarget()
+		:_buffer(NULL), _width(0), _height(0), _updateInterval(1), _lastUpdate(0), _everUpdated(false)
+{
+	memset(&_texture, 0, sizeof(_texture));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		RenderTarget::~RenderTarget()
+{
+	destroy();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		RenderTarget::create(const unsigned int width, const unsigned int height, const unsigned int updateInterval)
+{
+	destroy();
+
+	_buffer = (unsigned int *) poolAlloc(width * height * sizeof(unsigned int));
+	if (!_buffer) return false;
+
+	// Wrap it as a texture (this fails if the dimensions aren't powers of two, which is fine -- it's still a target)
+
+	wrapTexture(_texture, _buffer, width, height);
+
+	_width = width;
+	_height = height;
+	_updateInterval = updateInterval ? updateInterval : 1;
+	_everUpdated = false;
+	clear();
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		RenderTarget::destroy()
+{
+	poolFree(_buffer);
+	_buffer = NULL;
+	_width = 0;
+	_height = 0;
+	memset(&_texture, 0, sizeof(_texture));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		RenderTarget::clear(const unsigned int color)
+{
+	if (_buffer) fillBuffer(_buffer, _width * _height, color);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns true if the target has never been drawn, or hasn't been drawn in updateInterval frames
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		RenderTarget::needsUpdate(const unsigned int frame) const
+{
+	return !_everUpdated || frame - _lastUpdate >= _updateInterval;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		RenderTarget::updated(const unsigned int frame)
+{
+	_lastUpdate = frame;
+	_everUpdated = true;
+	_texture.generation++;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// RenderTarget.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,76 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____                 _        _______                    _       _     
+// |  __ \               | |      |__   __|                  | |     | |    
+// | |__) | ___ _ __   __| | ___ _ __| |  __ _ _ __ __ _  ___| |_    | |__  
+// |  _  / / _ \ '_ \ / _` |/ _ \ '__| | / _` | '__/ _` |/ _ \ __|   | '_ \ 
+// | | \ \|  __/ | | | (_| |  __/ |  | || (_| | | | (_| |  __/ |_  _ | | | |
+// |_|  \_\\___|_| |_|\__,_|\___|_|  |_| \__,_|_|  \__, |\___|\__|(_)|_| |_|
+//                                                  __/ |                   
+//                                                 |___/                    
+//
+// Render targets (off-screen buffers that double as textures)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_RENDERTARGET
+#define	_H_RENDERTARGET
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// A render target is an off-screen buffer that the mappers can draw into (just like the frame buffer) and that can then be bound
+// as a texture (see bindTexture.)  To be usable as a texture, the dimensions must be powers of two, no larger than 256 (the limit
+// of the sub-affine mapper's 8.24 texture coordinates.)
+//
+// Targets that are expensive to draw can be re-drawn every few frames: needsUpdate() says when it's time.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	RenderTarget
+{
+public:
+	// Construction/Destruction
+
+				RenderTarget();
+virtual				~RenderTarget();
+
+	// Accessors
+
+inline	const	unsigned int	&width() const {return _width;}
+inline	const	unsigned int	&height() const {return _height;}
+inline	const	unsigned int	&pitch() const {return _width;}
+inline	const	unsigned int	*buffer() const {return _buffer;}
+inline		unsigned int	*buffer() {return _buffer;}
+inline	const	sTEXTURE	&texture() const {return _texture;}
+inline	const	unsigned int	&updateInterval() const {return _updateInterval;}
+inline		unsigned int	&updateInterval() {return _updateInterval;}
+inline	const	bool		isValid() const {return _buffer != NULL;}
+
+	// Utilitarian
+
+virtual		bool		create(const unsigned int width, const unsigned int height, const unsigned int updateInterval = 1);
+virtual		void		destroy();
+virtual		void		clear(const unsigned int color = 0);
+virtual		bool		needsUpdate(const unsigned int frame) const;
+virtual		void		updated(const unsigned int frame);
+
+private:
+		unsigned int	*_buffer;
+		unsigned int	_width, _height;
+		sTEXTURE	_texture;
+		unsigned int	_updateInterval;
+		unsigned int	_lastUpdate;
+		bool		_everUpdated;
+};
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// RenderTarget.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
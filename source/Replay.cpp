@@ -0,0 +1,156 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _____             _                                  
+// |  __ \           | |                                 
+// | |__) | ___ _ __ | | __ _ _   _      ___ _ __  _ __  
+// |  _  / / _ \ '_ \| |/ _` | | | |    / __| '_ \| '_ \ 
+// | | \ \|  __/ |_) | | (_| | |_| | _ | (__| |_) | |_) |
+// |_|  \_\\___| .__/|_|\__,_|\__, |(_) \___| .__/| .__/ 
+//             | |             __/ |        | |   | |    
+//             |_|            |___/         |_|   |_|    
+//
+// Headless polygon-stream replay (a benchmark for the mappers)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// Usage: Replay <recording> [passes] [mapper]
+//
+// Plays a recording made with USE_POLY_RECORD (see PolyStream.cpp) through the mappers as fast as they'll go, 'passes' times (10
+// by default), and prints the time each pass took.  There's no window and no presenting, so the times are the clears and the
+// mappers alone.  The first pass warms the caches (and the targets), so the best of the rest is the number to compare.
+//
+// Naming a mapper (affine, perspective, sub-affine or sub-affine-565) draws every polygon with it, rather than the mappers it was
+// recorded with, so they can all be timed on the same frames.
+//
+// The mappers are built with this project's TMap.h, so the blend and shading are whatever that says; it should match the build the
+// recording was made with.  After the last pass, a checksum of each target is printed: the same build playing the same recording
+// should always come up with the same checksums, so they show whether a change to a mapper changed what it draws.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The mappers that can be asked for by name
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	struct
+{
+	const	char		*name;
+	unsigned int		mappers;
+} mapperNames[] =
+{
+	{"affine",		POLY_MAPPER_AFFINE},
+	{"perspective",		POLY_MAPPER_PERSPECTIVE},
+	{"sub-affine",		POLY_MAPPER_SUB_AFFINE},
+	{"sub-affine-565",	POLY_MAPPER_SUB_AFFINE_565}
+};
+
+static	const	unsigned int	mapperNameCount = sizeof(mapperNames) / sizeof(mapperNames[0]);
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+int	main(int argc, char *argv[])
+{
+	if (!AfxWinInit(::GetModuleHandle(NULL), NULL, ::GetCommandLine(), 0)) return 1;
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: Replay <recording> [passes] [affine|perspective|sub-affine|sub-affine-565]\n");
+		return 1;
+	}
+
+	unsigned int	passes = argc > 2 ? atoi(argv[2]) : 10;
+	if (!passes) passes = 1;
+
+	// The mapper to draw everything with (or 0, for the ones it was recorded with)
+
+	unsigned int	mappers = 0;
+
+	if (argc > 3)
+	{
+		for (unsigned int i = 0; i < mapperNameCount && !mappers; i++)
+		{
+			if (!stricmp(argv[3], mapperNames[i].name)) mappers = mapperNames[i].mappers;
+		}
+
+		if (!mappers)
+		{
+			fprintf(stderr, "Replay: unknown mapper '%s'\n", argv[3]);
+			return 1;
+		}
+	}
+
+	// The affine and exact perspective mappers read the default texture
+
+	drawTexture();
+
+	PolyPlayer	player;
+	if (!player.open(argv[1]))
+	{
+		fprintf(stderr, "Replay: can't read a recording from '%s'\n", argv[1]);
+		return 1;
+	}
+
+	printf("%s: %u frames, %u polygons, %u targets\n", argv[1], player.frames(), player.polygons(), player.targetCount());
+
+	unsigned int	frames = player.frames() ? player.frames() : 1;
+	unsigned int	counted = 0;
+	double		best = 0, total = 0;
+
+	for (unsigned int pass = 0; pass < passes; pass++)
+	{
+		double		start = seconds();
+		unsigned int	drawn = player.replay(mappers);
+		double		elapsed = seconds() - start;
+
+		printf("pass %3u: %9.3fms (%.4fms per frame, %.0f polygons per second)\n", pass + 1, elapsed * 1000.0,
+			elapsed * 1000.0 / frames, elapsed > 0 ? drawn / elapsed : 0.0);
+
+		// The first pass is the warm-up, so it only counts if it's the only one
+
+		if (pass || passes == 1)
+		{
+			if (!counted || elapsed < best) best = elapsed;
+			total += elapsed;
+			counted++;
+		}
+	}
+
+	printf("best %.3fms, average %.3fms; %.4fms per frame at best\n", best * 1000.0, total * 1000.0 / counted, best * 1000.0 / frames);
+
+	for (unsigned int t = 0; t < player.targetCount(); t++)
+	{
+		const	sPOLYTARGET	&target = player.target(t);
+		if (!player.targetBuffer(t)) continue;
+
+		printf("target %u (%ux%u, %u bits): checksum %08X\n", t, target.width, target.height, target.depth, player.checksum(t));
+	}
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Replay.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -1,24 +1,24 @@
-// Originally released under a custom license.
-// This historical re-release is provided under the MIT License.
-// See the LICENSE file in the repo root for details.
-//
-// https://github.com/nettlep
-//
-//{{NO_DEPENDENCIES}}
-// Microsoft Visual C++ generated include file.
-// Used by VIEWER.RC
-//
-#define IDR_MAINFRAME					128
-#define IDD_VIEWER_DIALOG				102
-
-// Next default values for new objects
-// 
-#ifdef APSTUDIO_INVOKED
-#ifndef APSTUDIO_READONLY_SYMBOLS
-
-#define _APS_NEXT_RESOURCE_VALUE	129
-#define _APS_NEXT_CONTROL_VALUE		1000
-#define _APS_NEXT_SYMED_VALUE		101
-#define _APS_NEXT_COMMAND_VALUE		32771
-#endif
-#endif
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+//{{NO_DEPENDENCIES}}
+// Microsoft Visual C++ generated include file.
+// Used by VIEWER.RC
+//
+#define IDR_MAINFRAME					128
+#define IDD_VIEWER_DIALOG				102
+
+// Next default values for new objects
+// 
+#ifdef APSTUDIO_INVOKED
+#ifndef APSTUDIO_READONLY_SYMBOLS
+
+#define _APS_NEXT_RESOURCE_VALUE	129
+#define _APS_NEXT_CONTROL_VALUE		1000
+#define _APS_NEXT_SYMED_VALUE		101
+#define _APS_NEXT_COMMAND_VALUE		32771
+#endif
+#endif
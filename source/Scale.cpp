@@ -0,0 +1,219 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//   _____            _                           
+//  / ____|          | |                          
+// | (___   ___  __ _| | ___      ___ _ __  _ __  
+//  \___ \ / __|/ _` | |/ _ \    / __| '_ \| '_ \ 
+//  ____) | (__| (_| | |  __/ _ | (__| |_) | |_) |
+// |_____/ \___|\__,_|_|\___|(_) \___| .__/| .__/ 
+//                                   | |   | |    
+//                                   |_|   |_|    
+//
+// Image scaling
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// StretchDIBits can scale on the way to the display, but GDI's stretch is slow (and, depending on the stretch mode, nearest
+// neighbor), and it's no use when there's no display.  This is a bilinear filter that works on the frame buffer itself.
+//
+// Sample positions are in 16.16 fixed point, mapping pixel centers to pixel centers.  Weights are reduced to 7 bits so that a
+// difference between two channels (-255 to 255) times a weight (0 to 128), plus rounding, fits a signed 16-bit lane.  Each output
+// pixel is a vertical blend of two pairs of source pixels, then a horizontal blend of the results; the scalar code does exactly
+// the same arithmetic, so both paths give identical results.  The columns' positions and weights are the same for every scanline
+// (and for every frame at the same widths), so they're worked out once and kept by the caller (see sSCALECOLUMNS.)
+//
+// With SSE2, two output pixels are done at a time: each one's 2x2 source block is two 64-bit loads (the pixel and its right
+// neighbor, from two scanlines), widened to 16 bits.  Samples at the right and bottom edges are moved in by one pixel (with a
+// full weight on the far side), so the loads never go past the end of a scanline.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Splits a 16.16 sample position into a pixel index (with room for its neighbor) and a 7-bit weight for the neighbor
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	void	sampleAt(const int position, const unsigned int size, sSCALESAMPLE &sample)
+{
+	if (position <= 0)
+	{
+		sample.index = 0;
+		sample.weight = 0;
+		return;
+	}
+
+	sample.index = position >> 16;
+	sample.weight = (position >> 9) & 127;
+
+	if (sample.index >= size - 1)
+	{
+		sample.index = size - 2;
+		sample.weight = 128;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	int	lerpChannel(const int a, const int b, const int weight)
+{
+	return a + (((b - a) * weight + 64) >> 7);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	unsigned int	bilinear(const unsigned int *row0, const unsigned int *row1, const sSCALESAMPLE &column,
+					 const unsigned int fy)
+{
+	unsigned int	x = column.index;
+	unsigned int	result = 0;
+
+	for (unsigned int shift = 0; shift < 32; shift += 8)
+	{
+		int	left  = lerpChannel((row0[x]     >> shift) & 0xff, (row1[x]     >> shift) & 0xff, fy);
+		int	right = lerpChannel((row0[x + 1] >> shift) & 0xff, (row1[x + 1] >> shift) & 0xff, fy);
+		result |= (unsigned int) lerpChannel(left, right, column.weight) << shift;
+	}
+
+	return result;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Two output pixels (from a pair of columns) from a pair of scanlines
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef USE_SSE2
+static	inline	void	bilinear2(const unsigned int *row0, const unsigned int *row1, const sSCALESAMPLE *columns, const __m128i &fy,
+				  unsigned int *dst)
+{
+	const	__m128i	zero = _mm_setzero_si128();
+	const	__m128i	half = _mm_set1_epi16(64);
+	unsigned int	xa = columns[0].index;
+	unsigned int	xb = columns[1].index;
+
+	__m128i	top    = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) (row0 + xa)),
+					    _mm_loadl_epi64((const __m128i *) (row0 + xb)));
+	__m128i	bottom = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) (row1 + xa)),
+					    _mm_loadl_epi64((const __m128i *) (row1 + xb)));
+
+	// Vertical: a's pair in one register, b's in the other
+
+	__m128i	topA    = _mm_unpacklo_epi8(top, zero);
+	__m128i	topB    = _mm_unpackhi_epi8(top, zero);
+	__m128i	bottomA = _mm_unpacklo_epi8(bottom, zero);
+	__m128i	bottomB = _mm_unpackhi_epi8(bottom, zero);
+
+	__m128i	a = _mm_add_epi16(topA, _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(bottomA, topA), fy), half), 7));
+	__m128i	b = _mm_add_epi16(topB, _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(bottomB, topB), fy), half), 7));
+
+	// Horizontal: left pixels of both in one register, right pixels in the other
+
+	__m128i	left  = _mm_unpacklo_epi64(a, b);
+	__m128i	right = _mm_unpackhi_epi64(a, b);
+	__m128i	fx    = _mm_unpacklo_epi64(_mm_set1_epi16((short) columns[0].weight), _mm_set1_epi16((short) columns[1].weight));
+
+	__m128i	result = _mm_add_epi16(left, _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_sub_epi16(right, left), fx), half), 7));
+	_mm_storel_epi64((__m128i *) dst, _mm_packus_epi16(result, result));
+}
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Scales a 32-bit image (pitches are in pixels.)  Both images must be at least 2x2.  'columns' holds the column samples from the
+// last call, and they're only worked out again if a width has changed.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool	scaleBilinear(const unsigned int *src, const unsigned int srcWidth, const unsigned int srcHeight, const unsigned int srcPitch,
+		      unsigned int *dst, const unsigned int dstWidth, const unsigned int dstHeight, const unsigned int dstPitch,
+		      sSCALECOLUMNS &columns)
+{
+	if (!src || !dst || srcWidth < 2 || srcHeight < 2 || dstWidth < 2 || dstHeight < 2) return false;
+
+	// Steps through the source per destination pixel, starting half a step in (less half a pixel) so centers map to centers
+
+	int	stepX = (int) ((srcWidth << 16) / dstWidth);
+	int	stepY = (int) ((srcHeight << 16) / dstHeight);
+	int	startX = stepX / 2 - 0x8000;
+	int	startY = stepY / 2 - 0x8000;
+
+	// The columns (if they've changed)
+
+	if (!columns.samples || columns.srcWidth != srcWidth || columns.dstWidth != dstWidth)
+	{
+		if (columns.dstWidth != dstWidth)
+		{
+			delete[] columns.samples;
+			columns.samples = new sSCALESAMPLE[dstWidth];
+		}
+
+		for (unsigned int x = 0; x < dstWidth; x++)
+		{
+			sampleAt(startX + (int) x * stepX, srcWidth, columns.samples[x]);
+		}
+
+		columns.srcWidth = srcWidth;
+		columns.dstWidth = dstWidth;
+	}
+
+	const	sSCALESAMPLE	*samples = columns.samples;
+
+	for (unsigned int y = 0; y < dstHeight; y++, dst += dstPitch)
+	{
+		sSCALESAMPLE	row;
+		sampleAt(startY + (int) y * stepY, srcHeight, row);
+
+		const	unsigned int	*row0 = src + row.index * srcPitch;
+		const	unsigned int	*row1 = row0 + srcPitch;
+		unsigned int		x = 0;
+
+		#ifdef USE_SSE2
+		__m128i	fy = _mm_set1_epi16((short) row.weight);
+
+		for (; x + 2 <= dstWidth; x += 2)
+		{
+			bilinear2(row0, row1, samples + x, fy, dst + x);
+		}
+		#endif
+
+		for (; x < dstWidth; x++)
+		{
+			dst[x] = bilinear(row0, row1, samples[x], row.weight);
+		}
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	freeScaleColumns(sSCALECOLUMNS &columns)
+{
+	delete[] columns.samples;
+	memset(&columns, 0, sizeof(columns));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Scale.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,62 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//   _____            _          _     
+//  / ____|          | |        | |    
+// | (___   ___  __ _| | ___    | |__  
+//  \___ \ / __|/ _` | |/ _ \   | '_ \ 
+//  ____) | (__| (_| | |  __/ _ | | | |
+// |_____/ \___|\__,_|_|\___|(_)|_| |_|
+//                                     
+//                                     
+//
+// Image scaling
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_SCALE
+#define	_H_SCALE
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Where a column (or scanline) samples from
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	scalesample
+{
+	unsigned int	index;			// The left (or upper) source pixel
+	unsigned int	weight;			// Of the right (or lower) one (0 - 128)
+} sSCALESAMPLE;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The columns' samples, which are the same for every scanline (and every frame, until a width changes.)  The caller keeps one of
+// these (zeroed to start with) and hands it to every scale; it's rebuilt when the source or destination width changes.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	scalecolumns
+{
+	unsigned int	srcWidth;		// The widths the samples were worked out for
+	unsigned int	dstWidth;
+	sSCALESAMPLE	*samples;		// One per destination column
+} sSCALECOLUMNS;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool	scaleBilinear(const unsigned int *src, const unsigned int srcWidth, const unsigned int srcHeight, const unsigned int srcPitch,
+		      unsigned int *dst, const unsigned int dstWidth, const unsigned int dstHeight, const unsigned int dstPitch,
+		      sSCALECOLUMNS &columns);
+void	freeScaleColumns(sSCALECOLUMNS &columns);
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Scale.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,207 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//   _____                                           
+//  / ____|                                          
+// | (___   ___  ___ _ __   ___      ___ _ __  _ __  
+//  \___ \ / __|/ _ \ '_ \ / _ \    / __| '_ \| '_ \ 
+//  ____) | (__|  __/ | | |  __/ _ | (__| |_) | |_) |
+// |_____/ \___|\___|_| |_|\___|(_) \___| .__/| .__/ 
+//                                      | |   | |    
+//                                      |_|   |_|    
+//
+// The viewer's scene (four adjacent quads, spun about the view axis)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// The scene was built to test overlaps: four quads meeting at the center of the screen, sharing their edges.  It lives here (rather
+// than in Render) so the tools that draw it without a window (see Golden.cpp) draw exactly what the viewer does.
+//
+// The quads are indexed: there are nine vertices between them (the one in the center is in all four quads), and each is transformed
+// once per frame into a buffer that the polygons are gathered from.  A transformed vertex depends on nothing but the vertex, so a
+// polygon gathered this way is exactly the polygon that transforming its own copies would give.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <math.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The 4 adjacent polygons, as indices into the vertices (a 3 x 3 grid, in rows)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned int	sceneIndices[scenePolygons][sceneVerts] =
+{
+	{0, 1, 4, 3},
+	{1, 2, 5, 4},
+	{3, 4, 7, 6},
+	{4, 5, 8, 7}
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Sets up the vertices of the 4 adjacent polygons (in model space)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	buildScene(sVERT vertices[sceneVertices])
+{
+	static	const	float	positions[sceneVertices][3] =
+	{
+		{-1.0, -1.0,  1.0}, {   0, -1.0,  1.0}, { 1.0, -1.0,  1.0},
+		{-1.0,    0,    0}, {   0,    0,    0}, { 1.0,    0,    0},
+		{-1.0,  1.0, -1.0}, {   0,  1.0, -1.0}, { 1.0,  1.0, -1.0}
+	};
+
+	memset(vertices, 0, sceneVertices * sizeof(sVERT));
+
+	for (unsigned int i = 0; i < sceneVertices; i++)
+	{
+		vertices[i].x = positions[i][0];
+		vertices[i].y = positions[i][1];
+		vertices[i].z = positions[i][2];
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Sets up a frame's transform: a rotation by 'angle', lighting (the light sweeps across with 'lightAngle'), and a projection onto a
+// width x height screen with texture coordinates for a texWidth x texHeight texture.  A 'zoom' above 1 narrows the view
+// (everything is scaled up on the screen, around its center.)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	setupSceneTransform(sSCENETRANSFORM &transform, const unsigned int width, const unsigned int height, const double angle,
+			    const double lightAngle, const float texWidth, const float texHeight, const float zoom)
+{
+	transform.cosAngle = (float) cos(angle);
+	transform.sinAngle = (float) sin(angle);
+	transform.lightAngle = lightAngle;
+	transform.texWidth = texWidth;
+	transform.texHeight = texHeight;
+	transform.scaleX = width * 3 * zoom;
+	transform.scaleY = height * 3 * zoom;
+	transform.centerX = width  / 2.0f + 0.5f;
+	transform.centerY = height / 2.0f + 0.5f;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Transforms 'count' vertices (the 'next' links aren't used or set)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	transformSceneVertices(const sSCENETRANSFORM &transform, const sVERT *src, sVERT *dst, const unsigned int count)
+{
+	for (unsigned int i = 0; i < count; i++, src++, dst++)
+	{
+		// Rotate
+
+		dst->u = src->x * (0.49f * transform.texWidth)  + (0.5f * transform.texWidth);
+		dst->v = src->y * (0.49f * transform.texHeight) + (0.5f * transform.texHeight);
+		dst->w = 1.0f;
+		dst->x = src->x * transform.cosAngle - src->y * transform.sinAngle;
+		dst->y = src->x * transform.sinAngle + src->y * transform.cosAngle;
+		dst->z = src->z;
+
+		// Light (a color ramp across the surface, with a light that sweeps across it as it spins)
+
+		#ifdef USE_GOURAUD
+		dst->r = (src->x + 1.0f) * 127.5f;
+		dst->g = (src->y + 1.0f) * 127.5f;
+		dst->b = 255.0f;
+		dst->i = 0.6f + 0.4f * (float) cos(transform.lightAngle * 4.0 - src->x * 2.0);
+		#endif
+		#ifdef USE_SPECULAR
+		dst->s = 255.0f * (float) pow(0.5 + 0.5 * cos(transform.lightAngle * 4.0 - src->x * 2.0), 8.0);
+		#endif
+
+		// Scale
+
+		dst->x *= transform.scaleX;
+		dst->y *= transform.scaleY;
+		dst->z *= 10.0;
+		dst->z += 20.0;
+
+		// Project
+
+		#ifndef USE_AFFINE
+		dst->u /= dst->z;
+		dst->v /= dst->z;
+		dst->w /= dst->z;
+		#endif
+		dst->x /= dst->z;
+		dst->y /= dst->z;
+
+		// Offset to screen center
+
+		dst->x += transform.centerX;
+		dst->y += transform.centerY;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Gathers a polygon from transformed vertices, linking it up for the mappers.  'dst' must have room for 'count' vertices.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	indexScenePolygon(const sVERT *vertices, const unsigned int *indices, const unsigned int count, sVERT *dst)
+{
+	for (unsigned int i = 0; i < count; i++)
+	{
+		dst[i] = vertices[indices[i]];
+		dst[i].next = &dst[i + 1];
+	}
+
+	dst[count - 1].next = NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns the planes around the part of model space that a transform (see setupSceneTransform) puts on a width x height screen
+// (with the same 'angle' & 'zoom'), facing inwards.  There's a couple of pixels to spare on each side.  There's no need for near & far planes;
+// the scene's depth is fixed.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	sceneFrustum(sBVHPLANE planes[4], const unsigned int width, const unsigned int height, const double angle, const float zoom)
+{
+	// A point is on the screen when its rotated x (scaled up by width * 3 * zoom) is within half the width of the center once it's
+	// divided by its depth (z * 10 + 20), and the same goes for y
+
+	const	float	c = (float) cos(angle);
+	const	float	s = (float) sin(angle);
+	const	float	sx = width * 3 * zoom;
+	const	float	sy = height * 3 * zoom;
+	const	float	hw = width / 2.0f + 2.0f;
+	const	float	hh = height / 2.0f + 2.0f;
+
+	const	float	normals[4][3] =
+	{
+		{ sx * c, -sx * s, hw * 10.0f},		// Left
+		{-sx * c,  sx * s, hw * 10.0f},		// Right
+		{ sy * s,  sy * c, hh * 10.0f},		// Top
+		{-sy * s, -sy * c, hh * 10.0f}		// Bottom
+	};
+
+	for (unsigned int i = 0; i < 4; i++)
+	{
+		planes[i].normal[0] = normals[i][0];
+		planes[i].normal[1] = normals[i][1];
+		planes[i].normal[2] = normals[i][2];
+		planes[i].distance = (i < 2 ? hw : hh) * 20.0f;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Scene.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,66 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//   _____                          _     
+//  / ____|                        | |    
+// | (___   ___  ___ _ __   ___    | |__  
+//  \___ \ / __|/ _ \ '_ \ / _ \   | '_ \ 
+//  ____) | (__|  __/ | | |  __/ _ | | | |
+// |_____/ \___|\___|_| |_|\___|(_)|_| |_|
+//                                        
+//                                        
+//
+// The viewer's scene (four adjacent quads, spun about the view axis)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_SCENE
+#define	_H_SCENE
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned int	scenePolygons = 4;
+const	unsigned int	sceneVerts = 4;			// Per polygon
+const	unsigned int	sceneVertices = 9;		// In all (the polygons share their edges)
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The parts of the transform that are the same for every vertex in a frame
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	scenetransform
+{
+	float		cosAngle, sinAngle;
+	double		lightAngle;
+	float		texWidth, texHeight;
+	float		scaleX, scaleY;
+	float		centerX, centerY;
+} sSCENETRANSFORM;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+extern	const	unsigned int	sceneIndices[scenePolygons][sceneVerts];
+
+void	buildScene(sVERT vertices[sceneVertices]);
+void	setupSceneTransform(sSCENETRANSFORM &transform, const unsigned int width, const unsigned int height, const double angle,
+			    const double lightAngle, const float texWidth, const float texHeight, const float zoom = 1.0f);
+void	transformSceneVertices(const sSCENETRANSFORM &transform, const sVERT *src, sVERT *dst, const unsigned int count);
+void	indexScenePolygon(const sVERT *vertices, const unsigned int *indices, const unsigned int count, sVERT *dst);
+void	sceneFrustum(sBVHPLANE planes[4], const unsigned int width, const unsigned int height, const double angle,
+		     const float zoom = 1.0f);
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Scene.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -1,34 +1,34 @@
-// ---------------------------------------------------------------------------------------------------------------------------------
-//   _____ _       _           __                           
-//  / ____| |     | |   /\    / _|                          
-// | (___ | |_  __| |  /  \  | |___  __     ___ _ __  _ __  
-//  \___ \| __|/ _` | / /\ \ |  _\ \/ /    / __| '_ \| '_ \ 
-//  ____) | |_| (_| |/ ____ \| |  >  <  _ | (__| |_) | |_) |
-// |_____/ \__|\__,_/_/    \_\_| /_/\_\(_) \___| .__/| .__/ 
-//                                             | |   | |    
-//                                             |_|   |_|    
-//
-// Best viewed with 8-character tabs and (at least) 132 columns
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-//
-// Originally released under a custom license.
-// This historical re-release is provided under the MIT License.
-// See the LICENSE file in the repo root for details.
-//
-// https://github.com/nettlep
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Originally created on 12/22/2000 by Paul Nettle
-//
-// Copyright 2000, Fluid Studios, Inc., all rights reserved.
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-#include "stdafx.h"
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// StdAfx.cpp - End of file
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-
-
+// ---------------------------------------------------------------------------------------------------------------------------------
+//   _____ _       _           __                           
+//  / ____| |     | |   /\    / _|                          
+// | (___ | |_  __| |  /  \  | |___  __     ___ _ __  _ __  
+//  \___ \| __|/ _` | / /\ \ |  _\ \/ /    / __| '_ \| '_ \ 
+//  ____) | |_| (_| |/ ____ \| |  >  <  _ | (__| |_) | |_) |
+// |_____/ \__|\__,_/_/    \_\_| /_/\_\(_) \___| .__/| .__/ 
+//                                             | |   | |    
+//                                             |_|   |_|    
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Originally created on 12/22/2000 by Paul Nettle
+//
+// Copyright 2000, Fluid Studios, Inc., all rights reserved.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// StdAfx.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+
+
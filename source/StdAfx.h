@@ -1,55 +1,78 @@
-// ---------------------------------------------------------------------------------------------------------------------------------
-//   _____ _       _           __          _     
-//  / ____| |     | |   /\    / _|        | |    
-// | (___ | |_  __| |  /  \  | |___  __   | |__  
-//  \___ \| __|/ _` | / /\ \ |  _\ \/ /   | '_ \ 
-//  ____) | |_| (_| |/ ____ \| |  >  <  _ | | | |
-// |_____/ \__|\__,_/_/    \_\_| /_/\_\(_)|_| |_|
-//                                               
-//                                               
-//
-// Best viewed with 8-character tabs and (at least) 132 columns
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-//
-// Originally released under a custom license.
-// This historical re-release is provided under the MIT License.
-// See the LICENSE file in the repo root for details.
-//
-// https://github.com/nettlep
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Originally created on 12/22/2000 by Paul Nettle
-//
-// Copyright 2000, Fluid Studios, Inc., all rights reserved.
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-#ifndef	_H_STDAFX
-#define _H_STDAFX
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-#define VC_EXTRALEAN		// Exclude rarely-used stuff from Windows headers
-#include <afxwin.h>		// MFC core and standard components
-#include <afxext.h>		// MFC extensions
-#include <afxdtctl.h>		// MFC support for Internet Explorer 4 Common Controls
-
-#ifndef _AFX_NO_AFXCMN_SUPPORT
-#include <afxcmn.h>		// MFC support for Windows Common Controls
-#endif
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Project includes
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-#include "resource.h"
-#include "WinDIB.h"
-#include "TMap.h"
-#include "Viewer.h"
-#include "Render.h"
-#include "ViewerDlg.h"
-
-//{{AFX_INSERT_LOCATION}}
-
-#endif
-// ---------------------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------------------
+//   _____ _       _           __          _     
+//  / ____| |     | |   /\    / _|        | |    
+// | (___ | |_  __| |  /  \  | |___  __   | |__  
+//  \___ \| __|/ _` | / /\ \ |  _\ \/ /   | '_ \ 
+//  ____) | |_| (_| |/ ____ \| |  >  <  _ | | | |
+// |_____/ \__|\__,_/_/    \_\_| /_/\_\(_)|_| |_|
+//                                               
+//                                               
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Originally created on 12/22/2000 by Paul Nettle
+//
+// Copyright 2000, Fluid Studios, Inc., all rights reserved.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_STDAFX
+#define _H_STDAFX
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#define VC_EXTRALEAN		// Exclude rarely-used stuff from Windows headers
+#include <afxwin.h>		// MFC core and standard components
+#include <afxext.h>		// MFC extensions
+#include <afxdtctl.h>		// MFC support for Internet Explorer 4 Common Controls
+
+#ifndef _AFX_NO_AFXCMN_SUPPORT
+#include <afxcmn.h>		// MFC support for Windows Common Controls
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Project includes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "resource.h"
+#include "WinDIB.h"
+#include "Presenter.h"
+#include "BufferPool.h"
+#include "SwapChain.h"
+#include "FrameExport.h"
+#include "FrameCapture.h"
+#include "DirtyRects.h"
+#include "VirtualTexture.h"
+#include "Texture.h"
+#include "Blend.h"
+#include "Clear.h"
+#include "Convert.h"
+#include "Scale.h"
+#include "DynamicResolution.h"
+#include "FrameLoop.h"
+#include "TMap.h"
+#include "Bvh.h"
+#include "Mesh.h"
+#include "MeshScene.h"
+#include "Scene.h"
+#include "PolyStream.h"
+#include "Trace.h"
+#include "Profile.h"
+#include "Hud.h"
+#include "RenderTarget.h"
+#include "Viewer.h"
+#include "Render.h"
+#include "ViewerDlg.h"
+
+//{{AFX_INSERT_LOCATION}}
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
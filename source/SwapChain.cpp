@@ -0,0 +1,229 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//   _____                       _____ _           _                            
+//  / ____|                     / ____| |         (_)                           
+// | (___ __      __ __ _ _ __ | |    | |__   __ _ _ _ __       ___ _ __  _ __  
+//  \___ \\ \ /\ / // _` | '_ \| |    | '_ \ / _` | | '_ \     / __| '_ \| '_ \ 
+//  ____) |\ V  V /| (_| | |_) | |____| | | | (_| | | | | | _ | (__| |_) | |_) |
+// |_____/  \_/\_/  \__,_| .__/ \_____|_| |_|\__,_|_|_| |_|(_) \___| .__/| .__/ 
+//                       | |                                       | |   | |    
+//                       |_|                                       |_|   |_|    
+//
+// Swap chain (frames are presented on their own thread while the next one is drawn)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// Without a swap chain, a frame is cleared, drawn and presented, and nothing else happens while the present (and any conversion
+// to the output depth) runs.  With two or three buffers, the present thread works on the last frame while the renderer draws
+// the next one.
+//
+// Buffers are used round-robin, and the present thread takes them in the same order, so the queue is implicit: a semaphore counts
+// the frames that have been submitted and not yet presented.  Each buffer's fence is a manual-reset event that's set once the
+// buffer has been presented; acquire() waits for it (and resets it.)  With two buffers, the renderer can be at most one frame
+// ahead of the display; with three, two.
+//
+// The present thread uses the window's DC while the renderer doesn't, so nothing else may present while the chain is running.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <process.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		SwapChain::SwapChain()
+		:_count(0), _queued(NULL), _thread(NULL), _current(0xffffffff), _next(0), _lastPresented(0xffffffff), _proc(NULL), _context(NULL), _quitting(false)
+{
+	memset(_buffers, 0, sizeof(_buffers));
+	memset(_fences, 0, sizeof(_fences));
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		SwapChain::~SwapChain()
+{
+	destroy();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Creates 'count' (2 or 3) buffers of 'bytes' bytes each, and starts the present thread
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		SwapChain::create(const unsigned int count, const unsigned int bytes, PRESENTPROC proc, void *context)
+{
+	destroy();
+
+	if (count < 2 || count > swapChainMaxBuffers || !proc) return false;
+
+	_count = count;
+	_proc = proc;
+	_context = context;
+	_current = 0xffffffff;
+	_next = 0;
+	_lastPresented = 0xffffffff;
+	_quitting = false;
+	memset(&_stats, 0, sizeof(_stats));
+
+	for (unsigned int i = 0; i < _count; i++)
+	{
+		_buffers[i] = (unsigned int *) poolAlloc(bytes);
+		_fences[i] = CreateEvent(NULL, TRUE, TRUE, NULL);
+
+		if (!_buffers[i] || !_fences[i])
+		{
+			destroy();
+			return false;
+		}
+	}
+
+	_queued = CreateSemaphore(NULL, 0, _count, NULL);
+
+	unsigned int	id;
+	if (_queued) _thread = (HANDLE) _beginthreadex(NULL, 0, presentThread, this, 0, &id);
+
+	if (!_thread)
+	{
+		destroy();
+		return false;
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Presents whatever is still queued, stops the present thread and frees the buffers
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		SwapChain::destroy()
+{
+	if (_thread)
+	{
+		flush();
+
+		_quitting = true;
+		ReleaseSemaphore(_queued, 1, NULL);
+		WaitForSingleObject(_thread, INFINITE);
+		CloseHandle(_thread);
+		_thread = NULL;
+	}
+
+	if (_queued) CloseHandle(_queued);
+	_queued = NULL;
+
+	for (unsigned int i = 0; i < swapChainMaxBuffers; i++)
+	{
+		poolFree(_buffers[i]);
+		if (_fences[i]) CloseHandle(_fences[i]);
+		_buffers[i] = NULL;
+		_fences[i] = NULL;
+	}
+
+	_count = 0;
+	_current = 0xffffffff;
+	_lastPresented = 0xffffffff;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns the next buffer to draw into, once it's free (i.e. once the frame that was last drawn into it has been presented)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int	*SwapChain::acquire()
+{
+	if (!_thread) return NULL;
+
+	double	start = seconds();
+	WaitForSingleObject(_fences[_next], INFINITE);
+	ResetEvent(_fences[_next]);
+
+	_stats.lastRenderWait = seconds() - start;
+	_stats.renderWait += _stats.lastRenderWait;
+
+	_current = _next;
+	_next = (_next + 1) % _count;
+	return _buffers[_current];
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Queues the acquired buffer for presentation
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		SwapChain::submit()
+{
+	if (!_thread || _current == 0xffffffff) return;
+
+	_current = 0xffffffff;
+	ReleaseSemaphore(_queued, 1, NULL);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Waits until everything that's been submitted has been presented
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		SwapChain::flush()
+{
+	for (unsigned int i = 0; i < _count; i++)
+	{
+		if (i != _current) WaitForSingleObject(_fences[i], INFINITE);
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned WINAPI	SwapChain::presentThread(void *param)
+{
+	SwapChain	&chain = *(SwapChain *) param;
+	unsigned int	index = 0;
+
+	#ifdef USE_TRACE
+	traceThreadName("present");
+	#endif
+
+	for(;;)
+	{
+		double	start = seconds();
+		WaitForSingleObject(chain._queued, INFINITE);
+		if (chain._quitting) break;
+
+		double	presentStart = seconds();
+		chain._proc(chain._context, chain._buffers[index]);
+		double	end = seconds();
+
+		chain._stats.lastPresentWait = presentStart - start;
+		chain._stats.lastPresentTime = end - presentStart;
+		chain._stats.presentWait += chain._stats.lastPresentWait;
+		chain._stats.presentTime += chain._stats.lastPresentTime;
+		chain._stats.frames++;
+
+		// The buffer is free again
+
+		chain._lastPresented = index;
+		SetEvent(chain._fences[index]);
+		index = (index + 1) % chain._count;
+	}
+
+	return 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// SwapChain.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
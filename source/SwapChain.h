@@ -0,0 +1,104 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//   _____                       _____ _           _           _     
+//  / ____|                     / ____| |         (_)         | |    
+// | (___ __      __ __ _ _ __ | |    | |__   __ _ _ _ __     | |__  
+//  \___ \\ \ /\ / // _` | '_ \| |    | '_ \ / _` | | '_ \    | '_ \ 
+//  ____) |\ V  V /| (_| | |_) | |____| | | | (_| | | | | | _ | | | |
+// |_____/  \_/\_/  \__,_| .__/ \_____|_| |_|\__,_|_|_| |_|(_)|_| |_|
+//                       | |                                         
+//                       |_|                                         
+//
+// Swap chain (frames are presented on their own thread while the next one is drawn)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_SWAPCHAIN
+#define	_H_SWAPCHAIN
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Most buffers a swap chain can have (triple buffering)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned int	swapChainMaxBuffers = 3;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Called on the present thread, once per submitted frame
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	void	(*PRESENTPROC)(void *context, unsigned int *buffer);
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Timing (in seconds.)  The waits say which side is the bottleneck: if the renderer waits, presenting is slower than drawing;
+// if the present thread waits, it's the other way around.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	swapstats
+{
+	unsigned int	frames;			// Frames presented
+	double		renderWait;		// Time the renderer spent waiting for a free buffer (total)
+	double		presentWait;		// Time the present thread spent waiting for a frame (total)
+	double		presentTime;		// Time spent presenting (total)
+	double		lastRenderWait;		// ...for the most recent frame
+	double		lastPresentWait;
+	double		lastPresentTime;
+} sSWAPSTATS;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The swap chain.  The renderer acquire()s a buffer, draws into it and submit()s it; the present thread presents submitted buffers
+// in order.  Each buffer has a fence that's signaled once it's been presented, which is what acquire() waits on.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	SwapChain
+{
+public:
+	// Construction/Destruction
+
+				SwapChain();
+virtual				~SwapChain();
+
+	// Accessors
+
+inline	const	unsigned int	count() const {return _count;}
+inline	const	bool		isValid() const {return _thread != NULL;}
+inline	const	sSWAPSTATS	&stats() const {return _stats;}
+inline		unsigned int	*lastPresented() {return _lastPresented < _count ? _buffers[_lastPresented] : NULL;}
+
+	// Utilitarian
+
+virtual		bool		create(const unsigned int count, const unsigned int bytes, PRESENTPROC proc, void *context);
+virtual		void		destroy();
+virtual		unsigned int	*acquire();
+virtual		void		submit();
+virtual		void		flush();
+
+private:
+static		unsigned WINAPI	presentThread(void *param);
+
+		unsigned int	_count;
+		unsigned int	*_buffers[swapChainMaxBuffers];
+		HANDLE		_fences[swapChainMaxBuffers];	// Signaled when the buffer is free (presented)
+		HANDLE		_queued;			// Counts submitted frames waiting to be presented
+		HANDLE		_thread;
+		unsigned int	_current;			// The buffer the renderer has (or -1)
+		unsigned int	_next;				// The next buffer to acquire
+	volatile unsigned int	_lastPresented;			// The buffer most recently presented (or -1)
+		PRESENTPROC	_proc;
+		void		*_context;
+		volatile bool	_quitting;
+		sSWAPSTATS	_stats;
+};
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// SwapChain.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -1,596 +1,1440 @@
-// ---------------------------------------------------------------------------------------------------------------------------------
-//  _______ __  __                                  
-// |__   __|  \/  |                                 
-//    | |  | \  / | __ _ _ __       ___ _ __  _ __  
-//    | |  | |\/| |/ _` | '_ \     / __| '_ \| '_ \ 
-//    | |  | |  | | (_| | |_) | _ | (__| |_) | |_) |
-//    |_|  |_|  |_|\__,_| .__/ (_) \___| .__/| .__/ 
-//                      | |            | |   | |    
-//                      |_|            |_|   |_|    
-//
-// Generic texture mappers
-//
-// Best viewed with 8-character tabs and (at least) 132 columns
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-//
-// Originally released under a custom license.
-// This historical re-release is provided under the MIT License.
-// See the LICENSE file in the repo root for details.
-//
-// https://github.com/nettlep
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Originally created on 12/22/2000 by Paul Nettle
-//
-// Copyright 2000, Fluid Studios, Inc., all rights reserved.
-// ---------------------------------------------------------------------------------------------------------------------------------
-//
-// NOTES ABOUT THE ROUTINES BELOW:
-//
-// When drawing, there are four polygons plotted (in perspective) that combine to create a single continuous surface.  This is done
-// to test for overlaps in adjacent polygons.
-//
-// Each polygon routine acheives results as accurate as the algorithm will allow.  See the comments above each routine for details
-// of accuracy issues.
-//
-// Each polygon routine performs no wrapping (and the wrapping error should be visible if there is overflow error.)  They also ADD
-// each pixel to the screen, rather than simply plotting them, to show any overlapping of adjacent polygons.
-//
-// Each routine is hard-coded for a 64x64 texture.  If you change the texture size defines (i.e. TEX_X & TEX_Y) you need to change
-// the inner-loops of the texture mappers.
-//
-// Vertices must be in clock-wise order.
-//
-// The routines SHOULD not crash with concave polygons, but may only render a portion of the given polygon (and incorrectly at
-// that.)
-//
-// Any other notes about a specific algorithm are given above each polgyon routine.
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-//
-// OTHER NOTES:
-//
-// The routines may not properly handle polygons that have three vertices in a straight line across the top of the polygon (causing
-// it to bail too early)
-//
-// The routines SHOULD not crash with concave polygons, but may only render a portion of the given polygon (and incorrectly at
-// that.)
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-#include <stdafx.h>
-#include <math.h>
-
-#include "TMap.h"
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Constants
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-const	unsigned int	textureWidth = 64;		// Texture resolution
-const	unsigned int	textureHeight = 64;		//
-
-const	unsigned int	subShift = 4;			// Sub-affine span size
-const	unsigned int	subSpan = 1 << subShift;	//
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Our texture
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-static	unsigned int	textureBuffer[textureWidth * textureHeight];
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Draws a checkerboard texture into textureBuffer
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-void	drawTexture()
-{
-	// Frequency: the lower the number, the higher the frequency
-
-	const int	freq = 2;
-	const int	fAnd = 1 << freq;
-
-	for (int y = 0; y < textureHeight; y++)
-	{
-		int	yIndex = y * textureWidth;
-
-		for (int x = 0; x < textureWidth; x++)
-		{
-			unsigned int	c = ((x * 4) << 16) | (y*4);
-			textureBuffer[yIndex+x] = (y&fAnd) == (x&fAnd) ? 0:c;
-		}
-	}
-}
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Calculate the deltas along an edge.  This routine is called once per edge per polygon.  Notice how the affine does not require
-// the calculation of the homogenous coordinate (w)
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-inline	void	calcEdgeDeltas(sEDGE &edge, sVERT *top, sVERT *bot)
-{
-	// Edge deltas
-
-	float	overHeight = 1.0f / (bot->y - top->y);
-	edge.du = (bot->u - top->u) * overHeight;
-	edge.dv = (bot->v - top->v) * overHeight;
-	#ifndef USE_AFFINE
-	edge.dw = (bot->w - top->w) * overHeight;
-	#endif
-	edge.dx = (bot->x - top->x) * overHeight;
-
-	// Screen pixel Adjustments (some call this "sub-pixel accuracy")
-
-	float	subPix = (float) top->iy - top->y;
-	edge.u  = top->u + edge.du * subPix;
-	edge.v  = top->v + edge.dv * subPix;
-	#ifndef USE_AFFINE
-	edge.w  = top->w + edge.dw * subPix;
-	#endif
-	edge.x  = top->x + edge.dx * subPix;
-}
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Draw an affine texture-mapped polygon.
-//
-// With a simple affine texture mapper (and without the use of sub-texel accuracy) the final pixel on each scanline of the polygon
-// references the texel along that edge.  If the polygon uses the entire texture, then that last pixel will be out of bounds of the
-// texture.  For example, a 4-sided polygon might reference these UV values:
-//
-//    [0,0] [1,0]                             [0,0] [64,0]
-//      +-----+                                 +-----+
-//      |     |                                 |     |
-//      |     |    given a 64x64 texture:       |     |  
-//      |     |                                 |     |
-//      |     |                                 |     |
-//      +-----+                                 +-----+
-//    [0,1] [1,1]                            [0,64] [64,64]
-//
-// Note that the edges on the right reference the texel that is just beyond the range of the texture map (0-63 does not include
-// 64).  This is safe, since these polygons are rendered top/left, which means that the far right edge and the last scanline of the
-// polygon is not drawn (to avoid overlapping of adjacent polygons.)
-//
-// Normal affine texture mapping has only one form of accuracy loss which can not be avoided.  The texture mapper interpolates
-// (i.e. adds a delta to each U/V value per pixel) which accumulates error, since the deltas calculated are only stored at the
-// resolution that the floating point unit will provide. Very few numbers can be represented exactly in IEEE floating point, so the
-// closest representative is stored instead.  This inaccuracy is accumulated as values are interpolated from pixel to pixel,
-// accumulating the error in the deltas.  Add this to the error of the original U/V value where the interpolation began (also due
-// to the inability to store an exact value) and the error is still small, but not negligable.
-//
-// This can be reduced by using higher precision floating point values (i.e. using doubles rather than floats.)  But this sill only
-// reduces the problem, and does not solve the problem entirely.
-//
-// This problem can manifest itself in a few ways.  First, it can cause inaccurate texel selections, and cause slight jitters in
-// the texture.  It can cause overflows in the texture (i.e. the right edge of the span may reference a texel beyond the range of
-// the texture).  It may also cause slight inaccuracies along each edge of the polygon, choosing to render to the wrong pixel.
-//
-// These problems are very rare, indeed, and may never be visually noticed. Especially the last error (choosing the wrong pixel
-// along the edges of the polygon) since the adjacent polygons will most likely make the same wrong choice, if the two adjacent
-// polygons share their edge vertices.
-//
-// There is no cure for this inaccuracy, given the algorithms used.  However, there is an acceptable work-around.  Simply choosing
-// UV values that are just INSIDE the bounds of the texture can solve this problem.  Also, allowing wrapping textures can also
-// solve this problem, provided the overflow wraps to a texel that "looks right."
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-void	drawAffineTexturedPolygon(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch)
-{
-	// Find the top-most vertex
-
-	sVERT		*v = verts, *lastVert = verts, *lTop = verts, *rTop;
-
-	while(v)
-	{
-		if (v->y < lTop->y) lTop = v;
-		lastVert = v;
-		v->iy = (int) ceil(v->y);
-		v = v->next;
-	}
-
-	// Make sure we have the top-most vertex that is earliest in the winding order
-
-	if (lastVert->y == lTop->y && verts->y == lTop->y) lTop = lastVert;
-
-	rTop = lTop;
-
-	// Top scanline of the polygon in the frame buffer
-
-	unsigned int	*fb = &frameBuffer[lTop->iy * pitch];
-
-	// Left & Right edges (primed with 0 to force edge calcs first-time through)
-
-	sEDGE		le, re;
-	le.height = 0;
-	re.height = 0;
-
-	// Render the polygon
-
-	bool	done = false;
-	while(!done)
-	{
-		if (!le.height)
-		{
-			sVERT	*lBot = lTop - 1; if (lBot < verts) lBot = lastVert;
-			le.height = lBot->iy - lTop->iy;
-			if (le.height < 0) return;
-			calcEdgeDeltas(le, lTop, lBot);
-			lTop = lBot;
-			if (lTop == rTop) done = true;
-			if (lTop != rTop && done) return;
-		}
-
-		if (!re.height)
-		{
-			sVERT	*rBot = rTop + 1; if (rBot > lastVert) rBot = verts;
-			re.height = rBot->iy - rTop->iy;
-			if (re.height < 0) return;
-			calcEdgeDeltas(re, rTop, rBot);
-			rTop = rBot;
-			if (lTop == rTop) done = true;
-			if (lTop != rTop && done) return;
-		}
-
-		// Get the height
-
-		int	height = _min(le.height, re.height);
-
-		// Subtract the height from each edge
-
-		le.height -= height;
-		re.height -= height;
-
-		// Render the current trapezoid defined by left & right edges
-
-		while(height-- > 0)
-		{
-			// Texture coordinates
-
-			float		overWidth = 1.0f / (re.x - le.x);
-			float		du  = (re.u - le.u) * overWidth;
-			float		dv  = (re.v - le.v) * overWidth;
-			int		idu = int(du * 65536.0f);
-			int		idv = int(dv * 65536.0f);
-
-			// Find the end-points
-
-			int		start = (int) ceil(le.x);
-			int		end   = (int) ceil(re.x);
-
-			// Texture adjustment (some call this "sub-texel accuracy")
-
-			float		subTex = (float) start - le.x;
-			int		iu = int((le.u + du * subTex) * 65536.0f);
-			int		iv = int((le.v + dv * subTex) * 65536.0f);
-
-			// Fill the entire span
-
-			unsigned int	*span = fb + start;
-
-			for (; start < end; start++)
-			{
-				*(span++) += textureBuffer[((iv>>10)&0xffffffC0) + (iu>>16)];
-				iu += idu;
-				iv += idv;
-			}
-
-			// Step
-
-			le.u += le.du;
-			le.v += le.dv;
-			le.x += le.dx;
-			re.u += re.du;
-			re.v += re.dv;
-			re.x += re.dx;
-			fb += pitch;
-		}
-	}
-}
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Draw a perspective-correct texture-mapped polygon.  The following routine performs perspective correction on ALL pixels.  This
-// produces a much slower routine, but at the same time, much more accurate results.
-//
-// Given the inaccuracies I've already explained for the affine texture mapper, this routine suffers from one more accumulation of
-// error.  The fact that the values interpolated are not their original values, rather they are divided by Z.
-//
-// Interpolating these u/z and v/z values accumulates the error in an amplified form, so that when the values are then divided by W
-// for each pixel, the amplified error from accumulation is added to the accuracy lost from the two divisions (first division by Z,
-// then the division by W).
-// 
-// This error can manifest itself in the same ways that the affine version can, with the exception that the error produced by the
-// following routine is amplified.
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-void	drawPerspectiveTexturedPolygon(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch)
-{
-	// Find the top-most vertex
-
-	sVERT		*v = verts, *lastVert = verts, *lTop = verts, *rTop;
-
-	while(v)
-	{
-		if (v->y < lTop->y) lTop = v;
-		lastVert = v;
-		v->iy = (int) ceil(v->y);
-		v = v->next;
-	}
-
-	// Make sure we have the top-most vertex that is earliest in the winding order
-
-	if (lastVert->y == lTop->y && verts->y == lTop->y) lTop = lastVert;
-
-	rTop = lTop;
-
-	// Top scanline of the polygon in the frame buffer
-
-	unsigned int	*fb = &frameBuffer[lTop->iy * pitch];
-
-	// Left & Right edges (primed with 0)
-
-	sEDGE		le, re;
-	le.height = 0;
-	re.height = 0;
-
-	// Render the polygon
-
-	bool	done = false;
-	while(!done)
-	{
-		if (!le.height)
-		{
-			sVERT	*lBot = lTop - 1; if (lBot < verts) lBot = lastVert;
-			le.height = lBot->iy - lTop->iy;
-			if (le.height < 0) return;
-			calcEdgeDeltas(le, lTop, lBot);
-			lTop = lBot;
-			if (lTop == rTop) done = true;
-			if (lTop != rTop && done) return;
-		}
-
-		if (!re.height)
-		{
-			sVERT	*rBot = rTop + 1; if (rBot > lastVert) rBot = verts;
-			re.height = rBot->iy - rTop->iy;
-			if (re.height < 0) return;
-			calcEdgeDeltas(re, rTop, rBot);
-			rTop = rBot;
-			if (lTop == rTop) done = true;
-			if (lTop != rTop && done) return;
-		}
-
-		// Get the height
-
-		int	height = _min(le.height, re.height);
-
-		// Subtract the height from each edge
-
-		le.height -= height;
-		re.height -= height;
-
-		// Render the current trapezoid defined by left & right edges
-
-		while(height-- > 0)
-		{
-			// Texture coordinates
-
-			float		overWidth = 1.0f / (re.x - le.x);
-			float		du = (re.u - le.u) * overWidth;
-			float		dv = (re.v - le.v) * overWidth;
-			float		dw = (re.w - le.w) * overWidth;
-
-			// Find the end-points
-
-			int		start = (int) ceil(le.x);
-			int		end   = (int) ceil(re.x);
-
-			// Texture adjustment (some call this "sub-texel accuracy")
-
-			float		subTex = (float) start - le.x;
-			float		u = le.u + du * subTex;
-			float		v = le.v + dv * subTex;
-			float		w = le.w + dw * subTex;
-
-			// Fill the entire span
-
-			unsigned int	*span = fb + start;
-
-			for (; start < end; start++)
-			{
-				float	z = 1.0f / w;
-				int	s = (int) (u * z);
-				int	t = (int) (v * z);
-
-				*(span++) += textureBuffer[(t<<6)+s];
-
-				u += du;
-				v += dv;
-				w += dw;
-			}
-
-			// Step
-
-			le.u += le.du;
-			le.v += le.dv;
-			le.w += le.dw;
-			le.x += le.dx;
-			re.u += re.du;
-			re.v += re.dv;
-			re.w += re.dw;
-			re.x += re.dx;
-			fb += pitch;
-		}
-	}
-}
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Draw a "sub-affine" perspective-correct texture-mapped polygon.  This routine uses affine texture-mapping between sub-spans of
-// subSpan length while only performing perspective correction every subSpan pixels.  This produces a much faster routine that
-// the one above, but suffers from accuracy loss.
-//
-// This routine also suffers from other aliasing problems of the first two, however, since these polygons are an estimated
-// perspective-correct, they choose texels in a non-perfect fasion. Remember that the perspective curve (explained in the comments
-// above the previous example) is being estimated with linear interpolation (i.e. straight lines.)  This can cause the error
-// (already present in a non-linear estimation) to be amplified even more.
-//
-// The greater the subSpan length, the less "perspective correction" is performed AND the less accurately texels will be chosen.
-//
-// This routine also uses a fixed-point representation of the UV values as it interpolates each sub-span.  This should not cause
-// any problems since the fixed-point representation is 8.24 (24 bits used to represent the fractional component) which is a higher
-// degree of resolution than a 32-bit floating-point variable offers.  However, if the delta from texel to texel goes beyond
-// 255.999... texels from texel to texel, the value will overflow and results may be unpredictable.
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-void	drawSubPerspectiveTexturedPolygon(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch)
-{
-	// Find the top-most vertex
-
-	sVERT		*v = verts, *lastVert = verts, *lTop = verts, *rTop;
-
-	while(v)
-	{
-		if (v->y < lTop->y) lTop = v;
-		lastVert = v;
-		v->iy = (int) ceil(v->y);
-		v = v->next;
-	}
-
-	// Make sure we have the top-most vertex that is earliest in the winding order
-
-	if (lastVert->y == lTop->y && verts->y == lTop->y) lTop = lastVert;
-
-	rTop = lTop;
-
-	// Top scanline of the polygon in the frame buffer
-
-	unsigned int	*fb = &frameBuffer[lTop->iy * pitch];
-
-	// Left & Right edges (primed with 0)
-
-	sEDGE		le, re;
-	le.height = 0;
-	re.height = 0;
-
-	// Render the polygon
-
-	bool	done = false;
-	while(!done)
-	{
-		if (!le.height)
-		{
-			sVERT	*lBot = lTop - 1; if (lBot < verts) lBot = lastVert;
-			le.height = lBot->iy - lTop->iy;
-			if (le.height < 0) return;
-			calcEdgeDeltas(le, lTop, lBot);
-			lTop = lBot;
-			if (lTop == rTop) done = true;
-			if (lTop != rTop && done) return;
-		}
-
-		if (!re.height)
-		{
-			sVERT	*rBot = rTop + 1; if (rBot > lastVert) rBot = verts;
-			re.height = rBot->iy - rTop->iy;
-			if (re.height < 0) return;
-			calcEdgeDeltas(re, rTop, rBot);
-			rTop = rBot;
-			if (lTop == rTop) done = true;
-			if (lTop != rTop && done) return;
-		}
-
-		// Get the height
-
-		int	height = _min(le.height, re.height);
-
-		// Subtract the height from each edge
-
-		le.height -= height;
-		re.height -= height;
-
-		// Render the current trapezoid defined by left & right edges
-
-		while(height-- > 0)
-		{
-			// Texture coordinates
-
-			float		overWidth = 1.0f / (re.x - le.x);
-			float		du = (re.u - le.u) * overWidth;
-			float		dv = (re.v - le.v) * overWidth;
-			float		dw = (re.w - le.w) * overWidth;
-
-			// Find the end-points
-
-			int		start = (int) ceil(le.x);
-			int		end   = (int) ceil(re.x);
-
-			// Texture adjustment (some call this "sub-texel accuracy")
-
-			float		subTex = (float) start - le.x;
-			float		u = le.u + du * subTex;
-			float		v = le.v + dv * subTex;
-			float		w = le.w + dw * subTex;
-
-			// Start of the first span
-
-			float		z  = 1.0f / w;
-			float		s1 = u * z;
-			float		t1 = v * z;
-
-			// Fill the entire span
-
-			unsigned int	*span = fb + start;
-			int		pixelsDrawn = 0;
-
-			for(; start < end; start += subSpan)
-			{
-				// Start of the current span
-
-				float		s0 = s1;
-				float		t0 = t1;
-
-				unsigned int	l = end-start;
-				int		len = _min(subSpan, l);
-				pixelsDrawn += len;
-
-				// End of the current span
-
-				z  = 1.0f / (w + dw * pixelsDrawn);
-				s1 = z    * (u + du * pixelsDrawn);
-				t1 = z    * (v + dv * pixelsDrawn);
-
-				// The span (8.24 fixed-point)
-
-				float		divisor = 1.0f / len * 0x1000000;
-				unsigned int	ds = (unsigned int) ((s1 - s0) * divisor);
-				unsigned int	dt = (unsigned int) ((t1 - t0) * divisor);
-				unsigned int	s  = (unsigned int) (s0 * 0x1000000);
-				unsigned int	t  = (unsigned int) (t0 * 0x1000000);
-
-				// Draw the sub-span
-
-				for (int j = 0; j < len; j++)
-				{
-					*(span++) += textureBuffer[((t>>18)&0xffffffC0)+(s>>24)];
-					s += ds;
-					t += dt;
-				}
-			}
-
-			// Scanline step
-
-			le.u += le.du;
-			le.v += le.dv;
-			le.w += le.dw;
-			le.x += le.dx;
-			re.u += re.du;
-			re.v += re.dv;
-			re.w += re.dw;
-			re.x += re.dx;
-			fb += pitch;
-		}
-	}
-}
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// TMap.cpp - End of file
-// ---------------------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _______ __  __                                  
+// |__   __|  \/  |                                 
+//    | |  | \  / | __ _ _ __       ___ _ __  _ __  
+//    | |  | |\/| |/ _` | '_ \     / __| '_ \| '_ \ 
+//    | |  | |  | | (_| | |_) | _ | (__| |_) | |_) |
+//    |_|  |_|  |_|\__,_| .__/ (_) \___| .__/| .__/ 
+//                      | |            | |   | |    
+//                      |_|            |_|   |_|    
+//
+// Generic texture mappers
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Originally created on 12/22/2000 by Paul Nettle
+//
+// Copyright 2000, Fluid Studios, Inc., all rights reserved.
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES ABOUT THE ROUTINES BELOW:
+//
+// When drawing, there are four polygons plotted (in perspective) that combine to create a single continuous surface.  This is done
+// to test for overlaps in adjacent polygons.
+//
+// Each polygon routine acheives results as accurate as the algorithm will allow.  See the comments above each routine for details
+// of accuracy issues.
+//
+// Each polygon routine performs no wrapping (and the wrapping error should be visible if there is overflow error.)  By default, they
+// also ADD each pixel to the screen, rather than simply plotting them, to show any overlapping of adjacent polygons.  Other blend
+// modes can be selected (see setBlendMode and Blend.h.)
+//
+// The affine and exact perspective routines are hard-coded for the default 64x64 texture.  If you change its size (textureWidth &
+// textureHeight) you need to change their inner-loops.  The sub-affine routines fetch from the bound texture (see bindTexture),
+// using its widthShift, so they draw textures of any power-of-two size up to 256x256 (their coordinates are 8.24 fixed-point.)
+// The virtual texture routine fetches from its own pages.
+//
+// Vertices must be in clock-wise order.
+//
+// The routines SHOULD not crash with concave polygons, but may only render a portion of the given polygon (and incorrectly at
+// that.)
+//
+// Any other notes about a specific algorithm are given above each polgyon routine.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// OTHER NOTES:
+//
+// The routines may not properly handle polygons that have three vertices in a straight line across the top of the polygon (causing
+// it to bail too early)
+//
+// The routines SHOULD not crash with concave polygons, but may only render a portion of the given polygon (and incorrectly at
+// that.)
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include <stdafx.h>
+#include <math.h>
+
+#include "TMap.h"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned int	textureWidth = 64;		// Texture resolution
+const	unsigned int	textureHeight = 64;		//
+
+const	unsigned int	subShift = 4;			// Sub-affine span size
+const	unsigned int	subSpan = 1 << subShift;	//
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Our texture
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	unsigned int	textureBuffer[textureWidth * textureHeight];
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The texture used by the sub-affine mapper.  By default, this is textureBuffer (see drawTexture) but any other format can be bound
+// in its place.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	sTEXTURE	textureDefault;
+static	const	sTEXTURE *textureBound = &textureDefault;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The frame buffer's tiled clear, if one is in progress (see Clear.h)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	sCLEARTILES	*clearTiles = NULL;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// How the mappers blend into the frame buffer
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#if	defined(USE_BLEND_REPLACE)
+static	BlendMode	blend = BLEND_REPLACE;
+#elif	defined(USE_BLEND_ADD_SATURATE)
+static	BlendMode	blend = BLEND_ADD_SATURATE;
+#elif	defined(USE_BLEND_ALPHA)
+static	BlendMode	blend = BLEND_ALPHA;
+#elif	defined(USE_BLEND_MULTIPLY)
+static	BlendMode	blend = BLEND_MULTIPLY;
+#else
+static	BlendMode	blend = BLEND_ADD;
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Draws a checkerboard texture into textureBuffer
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	drawTexture()
+{
+	// Frequency: the lower the number, the higher the frequency
+
+	const int	freq = 2;
+	const int	fAnd = 1 << freq;
+
+	for (int y = 0; y < textureHeight; y++)
+	{
+		int	yIndex = y * textureWidth;
+
+		for (int x = 0; x < textureWidth; x++)
+		{
+			unsigned int	c = 0xff000000 | ((x * 4) << 16) | (y*4);
+			textureBuffer[yIndex+x] = (y&fAnd) == (x&fAnd) ? 0:c;
+		}
+	}
+
+	wrapTexture(textureDefault, textureBuffer, textureWidth, textureHeight);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Selects the texture for the sub-affine mapper (NULL selects the default texture)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	bindTexture(const sTEXTURE *texture)
+{
+	textureBound = texture ? texture : &textureDefault;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	sTEXTURE &defaultTexture()
+{
+	return textureDefault;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	sTEXTURE &boundTexture()
+{
+	return *textureBound;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	setBlendMode(const BlendMode mode)
+{
+	blend = mode;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+BlendMode	blendMode()
+{
+	return blend;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Selects the tiled clear that the mappers clear into as they draw (NULL for none)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	bindClearTiles(sCLEARTILES *tiles)
+{
+	clearTiles = tiles;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Clips a polygon to a width x height screen, for the mappers (which don't clip.)  Returns 'verts' if it's entirely on the screen,
+// 'clipped' (linked up, and as contiguous as the mappers need it) if it had to be clipped, or NULL if there's nothing left of it.
+//
+// This is Sutherland-Hodgman against each side in turn; everything the mappers interpolate is interpolated along the edges that
+// get cut, so the clipped polygon draws exactly the pixels the whole one would have on the screen.  Where a vertex lands on a side,
+// it's put exactly on it, so the mappers' rows start & end where they should.  The right side is half a pixel in: the mappers draw
+// up to (not including) ceil(x) of the right edge, and the error an edge accumulates as it's stepped down the rows could otherwise
+// take that to one pixel past the end of the row.  Half a pixel in still draws the last column.
+//
+// A clipped polygon has up to 4 more vertices than it started with; one with more than clipMaxVerts - 4 is culled.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	void	clipLerp(sVERT &dst, const sVERT &a, const sVERT &b, const float t)
+{
+	dst.u = a.u + (b.u - a.u) * t;
+	dst.v = a.v + (b.v - a.v) * t;
+	dst.w = a.w + (b.w - a.w) * t;
+	dst.x = a.x + (b.x - a.x) * t;
+	dst.y = a.y + (b.y - a.y) * t;
+	dst.z = a.z + (b.z - a.z) * t;
+
+	// The mappers interpolate the lit color (color * intensity), so that's what's interpolated here
+
+	dst.r = a.r * a.i + (b.r * b.i - a.r * a.i) * t;
+	dst.g = a.g * a.i + (b.g * b.i - a.g * a.i) * t;
+	dst.b = a.b * a.i + (b.b * b.i - a.b * a.i) * t;
+	dst.i = 1.0f;
+	dst.s = a.s + (b.s - a.s) * t;
+}
+
+sVERT	*clipPolygon(sVERT *verts, sVERT clipped[clipMaxVerts], const unsigned int width, const unsigned int height)
+{
+	// Anything to do?
+
+	const	float	right = (float) width - 0.5f;
+	const	float	bottom = (float) height;
+	unsigned int	count = 0;
+	bool		inside = true;
+
+	for (sVERT *v = verts; v; v = v->next, count++)
+	{
+		if (v->x < 0 || v->x > right || v->y < 0 || v->y > bottom) inside = false;
+	}
+
+	if (inside) return verts;
+	if (count < 3 || count + 4 > clipMaxVerts) return NULL;
+
+	// Each side in turn (left, right, top, bottom), back and forth between the two buffers
+
+	sVERT		temp[clipMaxVerts];
+	sVERT		*src = clipped, *dst = temp;
+	unsigned int	i = 0;
+
+	for (sVERT *c = verts; c; c = c->next) src[i++] = *c;
+
+	for (unsigned int side = 0; side < 4; side++)
+	{
+		const	bool	vertical = side < 2;
+		const	float	limit = side == 1 ? right : side == 3 ? bottom : 0.0f;
+		const	float	sign = side & 1 ? -1.0f : 1.0f;
+		unsigned int	out = 0;
+
+		for (i = 0; i < count; i++)
+		{
+			const	sVERT	&a = src[i];
+			const	sVERT	&b = src[(i + 1) % count];
+			float		da = ((vertical ? a.x : a.y) - limit) * sign;
+			float		db = ((vertical ? b.x : b.y) - limit) * sign;
+
+			if (da >= 0) dst[out++] = a;
+
+			if ((da >= 0) != (db >= 0))
+			{
+				sVERT	&n = dst[out++];
+				clipLerp(n, a, b, da / (da - db));
+				if (vertical)	n.x = limit;
+				else		n.y = limit;
+			}
+		}
+
+		count = out;
+		if (count < 3) return NULL;
+
+		sVERT	*swap = src;
+		src = dst;
+		dst = swap;
+	}
+
+	// Four sides later, it's back where it started (in 'clipped')
+
+	for (i = 0; i < count; i++) clipped[i].next = i + 1 < count ? &clipped[i + 1] : NULL;
+	return clipped;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Sub-span kernels, one per texture format.  Each one fetches 'len' texels from the 8.24 fixed-point texture coordinates (s, t).
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	void	drawSpanARGB32(unsigned int *span, const sTEXTURE &tex, unsigned int s, unsigned int t, const unsigned int ds, const unsigned int dt, int len)
+{
+	const	unsigned int	*texels = tex.argb;
+	const	unsigned int	shift = tex.widthShift;
+
+	while(len-- > 0)
+	{
+		*(span++) = texels[((t>>24)<<shift)+(s>>24)];
+		s += ds;
+		t += dt;
+	}
+}
+
+static	inline	void	drawSpanPAL8(unsigned int *span, const sTEXTURE &tex, unsigned int s, unsigned int t, const unsigned int ds, const unsigned int dt, int len)
+{
+	const	unsigned char	*indices = tex.indices;
+	const	unsigned int	*palette = tex.palette;
+	const	unsigned int	shift = tex.widthShift;
+
+	while(len-- > 0)
+	{
+		*(span++) = palette[indices[((t>>24)<<shift)+(s>>24)]];
+		s += ds;
+		t += dt;
+	}
+}
+
+static	inline	void	drawSpanBC1(unsigned int *span, const sTEXTURE &tex, unsigned int s, unsigned int t, const unsigned int ds, const unsigned int dt, int len)
+{
+	const	unsigned int	blockShift = tex.widthShift - 2;
+
+	while(len-- > 0)
+	{
+		unsigned int	x = s>>24;
+		unsigned int	y = t>>24;
+		const	unsigned int	*block = bc1CachedBlock(tex, ((y>>2)<<blockShift)+(x>>2));
+		*(span++) = block[((y&3)<<2)+(x&3)];
+		s += ds;
+		t += dt;
+	}
+}
+
+static	inline	void	drawSpanExpand565(unsigned int *span, const sTEXTURE &tex, unsigned int s, unsigned int t, const unsigned int ds, const unsigned int dt, int len)
+{
+	const	unsigned short	*texels = tex.rgb565;
+	const	unsigned int	shift = tex.widthShift;
+
+	while(len-- > 0)
+	{
+		unsigned short	c = texels[((t>>24)<<shift)+(s>>24)];
+		*(span++) = c == rgb565Transparent ? 0 : argbFrom565(c);
+		s += ds;
+		t += dt;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The 16-bit mapper's kernel (for TF_RGB565 textures)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	inline	void	drawSpanRGB565(unsigned short *span, const sTEXTURE &tex, unsigned int s, unsigned int t, const unsigned int ds, const unsigned int dt, int len)
+{
+	const	unsigned short	*texels = tex.rgb565;
+	const	unsigned int	shift = tex.widthShift;
+
+	while(len-- > 0)
+	{
+		*(span++) = texels[((t>>24)<<shift)+(s>>24)];
+		s += ds;
+		t += dt;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Calculate the deltas along an edge.  This routine is called once per edge per polygon.  Notice how the affine does not require
+// the calculation of the homogenous coordinate (w)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+inline	void	calcEdgeDeltas(sEDGE &edge, sVERT *top, sVERT *bot)
+{
+	// Edge deltas
+
+	float	overHeight = 1.0f / (bot->y - top->y);
+	edge.du = (bot->u - top->u) * overHeight;
+	edge.dv = (bot->v - top->v) * overHeight;
+	#ifndef USE_AFFINE
+	edge.dw = (bot->w - top->w) * overHeight;
+	#endif
+	edge.dx = (bot->x - top->x) * overHeight;
+
+	// Screen pixel Adjustments (some call this "sub-pixel accuracy")
+
+	float	subPix = (float) top->iy - top->y;
+	edge.u  = top->u + edge.du * subPix;
+	edge.v  = top->v + edge.dv * subPix;
+	#ifndef USE_AFFINE
+	edge.w  = top->w + edge.dw * subPix;
+	#endif
+	edge.x  = top->x + edge.dx * subPix;
+
+	// Shading (the color is lit at the vertices, then interpolated)
+
+	#ifdef USE_GOURAUD
+	edge.dr = (bot->r * bot->i - top->r * top->i) * overHeight;
+	edge.dg = (bot->g * bot->i - top->g * top->i) * overHeight;
+	edge.db = (bot->b * bot->i - top->b * top->i) * overHeight;
+	edge.r  = top->r * top->i + edge.dr * subPix;
+	edge.g  = top->g * top->i + edge.dg * subPix;
+	edge.b  = top->b * top->i + edge.db * subPix;
+	#endif
+	#ifdef USE_SPECULAR
+	edge.ds = (bot->s - top->s) * overHeight;
+	edge.s  = top->s + edge.ds * subPix;
+	#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Steps the shading interpolants of an edge to the next scanline
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+inline	void	stepEdgeShade(sEDGE &edge)
+{
+	#ifdef USE_GOURAUD
+	edge.r += edge.dr;
+	edge.g += edge.dg;
+	edge.b += edge.db;
+	#endif
+	#ifdef USE_SPECULAR
+	edge.s += edge.ds;
+	#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Calculate the shading interpolants for a span (see shadeSpan.)  Shading is interpolated linearly in screen space, as is
+// traditional for Gouraud shading, regardless of the mapper.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+inline	void	calcSpanShade(sSHADE &shade, const sEDGE &le, const sEDGE &re, const float overWidth, const float subTex)
+{
+	#ifdef USE_GOURAUD
+	float	dr = (re.r - le.r) * overWidth;
+	float	dg = (re.g - le.g) * overWidth;
+	float	db = (re.b - le.b) * overWidth;
+	shade.dr = (int) (dr * 65536.0f);
+	shade.dg = (int) (dg * 65536.0f);
+	shade.db = (int) (db * 65536.0f);
+	shade.r  = (int) ((le.r + dr * subTex) * 65536.0f);
+	shade.g  = (int) ((le.g + dg * subTex) * 65536.0f);
+	shade.b  = (int) ((le.b + db * subTex) * 65536.0f);
+	#endif
+	#ifdef USE_SPECULAR
+	float	ds = (re.s - le.s) * overWidth;
+	shade.ds = (int) (ds * 65536.0f);
+	shade.s  = (int) ((le.s + ds * subTex) * 65536.0f);
+	#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Draw an affine texture-mapped polygon.
+//
+// With a simple affine texture mapper (and without the use of sub-texel accuracy) the final pixel on each scanline of the polygon
+// references the texel along that edge.  If the polygon uses the entire texture, then that last pixel will be out of bounds of the
+// texture.  For example, a 4-sided polygon might reference these UV values:
+//
+//    [0,0] [1,0]                             [0,0] [64,0]
+//      +-----+                                 +-----+
+//      |     |                                 |     |
+//      |     |    given a 64x64 texture:       |     |  
+//      |     |                                 |     |
+//      |     |                                 |     |
+//      +-----+                                 +-----+
+//    [0,1] [1,1]                            [0,64] [64,64]
+//
+// Note that the edges on the right reference the texel that is just beyond the range of the texture map (0-63 does not include
+// 64).  This is safe, since these polygons are rendered top/left, which means that the far right edge and the last scanline of the
+// polygon is not drawn (to avoid overlapping of adjacent polygons.)
+//
+// Normal affine texture mapping has only one form of accuracy loss which can not be avoided.  The texture mapper interpolates
+// (i.e. adds a delta to each U/V value per pixel) which accumulates error, since the deltas calculated are only stored at the
+// resolution that the floating point unit will provide. Very few numbers can be represented exactly in IEEE floating point, so the
+// closest representative is stored instead.  This inaccuracy is accumulated as values are interpolated from pixel to pixel,
+// accumulating the error in the deltas.  Add this to the error of the original U/V value where the interpolation began (also due
+// to the inability to store an exact value) and the error is still small, but not negligable.
+//
+// This can be reduced by using higher precision floating point values (i.e. using doubles rather than floats.)  But this sill only
+// reduces the problem, and does not solve the problem entirely.
+//
+// This problem can manifest itself in a few ways.  First, it can cause inaccurate texel selections, and cause slight jitters in
+// the texture.  It can cause overflows in the texture (i.e. the right edge of the span may reference a texel beyond the range of
+// the texture).  It may also cause slight inaccuracies along each edge of the polygon, choosing to render to the wrong pixel.
+//
+// These problems are very rare, indeed, and may never be visually noticed. Especially the last error (choosing the wrong pixel
+// along the edges of the polygon) since the adjacent polygons will most likely make the same wrong choice, if the two adjacent
+// polygons share their edge vertices.
+//
+// There is no cure for this inaccuracy, given the algorithms used.  However, there is an acceptable work-around.  Simply choosing
+// UV values that are just INSIDE the bounds of the texture can solve this problem.  Also, allowing wrapping textures can also
+// solve this problem, provided the overflow wraps to a texel that "looks right."
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	drawAffineTexturedPolygon(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch)
+{
+	// Find the top-most vertex
+
+	sVERT		*v = verts, *lastVert = verts, *lTop = verts, *rTop;
+
+	while(v)
+	{
+		if (v->y < lTop->y) lTop = v;
+		lastVert = v;
+		v->iy = (int) ceil(v->y);
+		v = v->next;
+	}
+
+	// Make sure we have the top-most vertex that is earliest in the winding order
+
+	if (lastVert->y == lTop->y && verts->y == lTop->y) lTop = lastVert;
+
+	rTop = lTop;
+
+	// Top scanline of the polygon in the frame buffer
+
+	unsigned int	*fb = &frameBuffer[lTop->iy * pitch];
+
+	// Left & Right edges (primed with 0 to force edge calcs first-time through)
+
+	sEDGE		le, re;
+	le.height = 0;
+	re.height = 0;
+
+	// Render the polygon
+
+	bool	done = false;
+	while(!done)
+	{
+		if (!le.height)
+		{
+			PROFILE_SCOPE(PROFILE_EDGES);
+
+			sVERT	*lBot = lTop - 1; if (lBot < verts) lBot = lastVert;
+			le.height = lBot->iy - lTop->iy;
+			if (le.height < 0) return;
+			calcEdgeDeltas(le, lTop, lBot);
+			lTop = lBot;
+			if (lTop == rTop) done = true;
+			if (lTop != rTop && done) return;
+		}
+
+		if (!re.height)
+		{
+			PROFILE_SCOPE(PROFILE_EDGES);
+
+			sVERT	*rBot = rTop + 1; if (rBot > lastVert) rBot = verts;
+			re.height = rBot->iy - rTop->iy;
+			if (re.height < 0) return;
+			calcEdgeDeltas(re, rTop, rBot);
+			rTop = rBot;
+			if (lTop == rTop) done = true;
+			if (lTop != rTop && done) return;
+		}
+
+		// Get the height
+
+		int	height = _min(le.height, re.height);
+
+		// Subtract the height from each edge
+
+		le.height -= height;
+		re.height -= height;
+
+		// Clear the frame buffer under the trapezoid (if it's being cleared as it's drawn into)
+
+		if (clearTiles)
+		{
+			PROFILE_SCOPE(PROFILE_CLEAR);
+			touchRows(*clearTiles, (int) ((fb - frameBuffer) / pitch), height);
+		}
+
+		// Render the current trapezoid defined by left & right edges
+
+		PROFILE_SCOPE(PROFILE_SPANS);
+
+		while(height-- > 0)
+		{
+			// Texture coordinates
+
+			float		overWidth = 1.0f / (re.x - le.x);
+			float		du  = (re.u - le.u) * overWidth;
+			float		dv  = (re.v - le.v) * overWidth;
+			int		idu = int(du * 65536.0f);
+			int		idv = int(dv * 65536.0f);
+
+			// Find the end-points
+
+			int		start = (int) ceil(le.x);
+			int		end   = (int) ceil(re.x);
+
+			PROFILE_COUNT(spans, 1);
+			PROFILE_COUNT(pixels, end > start ? end - start : 0);
+
+			// Texture adjustment (some call this "sub-texel accuracy")
+
+			float		subTex = (float) start - le.x;
+			int		iu = int((le.u + du * subTex) * 65536.0f);
+			int		iv = int((le.v + dv * subTex) * 65536.0f);
+
+			// Shading
+
+			#ifdef USE_GOURAUD
+			sSHADE		shade;
+			calcSpanShade(shade, le, re, overWidth, subTex);
+			#endif
+
+			// Fill the entire span, a chunk at a time (replace mode skips the chunk buffer and writes straight to the frame buffer)
+
+			unsigned int	*span = fb + start;
+			unsigned int	texels[blendChunk];
+
+			while(start < end)
+			{
+				int		len = end - start < (int) blendChunk ? end - start : (int) blendChunk;
+				unsigned int	*dst = blend == BLEND_REPLACE ? span : texels;
+
+				for (int j = 0; j < len; j++)
+				{
+					dst[j] = textureBuffer[((iv>>10)&0xffffffC0) + (iu>>16)];
+					iu += idu;
+					iv += idv;
+				}
+
+				#ifdef USE_GOURAUD
+				shadeSpan(dst, len, shade);
+				#endif
+
+				if (dst != span) blendSpan(span, texels, len, blend);
+				span += len;
+				start += len;
+			}
+
+			// Step
+
+			le.u += le.du;
+			le.v += le.dv;
+			le.x += le.dx;
+			re.u += re.du;
+			re.v += re.dv;
+			re.x += re.dx;
+			#ifdef USE_GOURAUD
+			stepEdgeShade(le);
+			stepEdgeShade(re);
+			#endif
+			fb += pitch;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Draw a perspective-correct texture-mapped polygon.  The following routine performs perspective correction on ALL pixels.  This
+// produces a much slower routine, but at the same time, much more accurate results.
+//
+// Given the inaccuracies I've already explained for the affine texture mapper, this routine suffers from one more accumulation of
+// error.  The fact that the values interpolated are not their original values, rather they are divided by Z.
+//
+// Interpolating these u/z and v/z values accumulates the error in an amplified form, so that when the values are then divided by W
+// for each pixel, the amplified error from accumulation is added to the accuracy lost from the two divisions (first division by Z,
+// then the division by W).
+// 
+// This error can manifest itself in the same ways that the affine version can, with the exception that the error produced by the
+// following routine is amplified.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	drawPerspectiveTexturedPolygon(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch)
+{
+	// Find the top-most vertex
+
+	sVERT		*v = verts, *lastVert = verts, *lTop = verts, *rTop;
+
+	while(v)
+	{
+		if (v->y < lTop->y) lTop = v;
+		lastVert = v;
+		v->iy = (int) ceil(v->y);
+		v = v->next;
+	}
+
+	// Make sure we have the top-most vertex that is earliest in the winding order
+
+	if (lastVert->y == lTop->y && verts->y == lTop->y) lTop = lastVert;
+
+	rTop = lTop;
+
+	// Top scanline of the polygon in the frame buffer
+
+	unsigned int	*fb = &frameBuffer[lTop->iy * pitch];
+
+	// Left & Right edges (primed with 0)
+
+	sEDGE		le, re;
+	le.height = 0;
+	re.height = 0;
+
+	// Render the polygon
+
+	bool	done = false;
+	while(!done)
+	{
+		if (!le.height)
+		{
+			PROFILE_SCOPE(PROFILE_EDGES);
+
+			sVERT	*lBot = lTop - 1; if (lBot < verts) lBot = lastVert;
+			le.height = lBot->iy - lTop->iy;
+			if (le.height < 0) return;
+			calcEdgeDeltas(le, lTop, lBot);
+			lTop = lBot;
+			if (lTop == rTop) done = true;
+			if (lTop != rTop && done) return;
+		}
+
+		if (!re.height)
+		{
+			PROFILE_SCOPE(PROFILE_EDGES);
+
+			sVERT	*rBot = rTop + 1; if (rBot > lastVert) rBot = verts;
+			re.height = rBot->iy - rTop->iy;
+			if (re.height < 0) return;
+			calcEdgeDeltas(re, rTop, rBot);
+			rTop = rBot;
+			if (lTop == rTop) done = true;
+			if (lTop != rTop && done) return;
+		}
+
+		// Get the height
+
+		int	height = _min(le.height, re.height);
+
+		// Subtract the height from each edge
+
+		le.height -= height;
+		re.height -= height;
+
+		// Clear the frame buffer under the trapezoid (if it's being cleared as it's drawn into)
+
+		if (clearTiles)
+		{
+			PROFILE_SCOPE(PROFILE_CLEAR);
+			touchRows(*clearTiles, (int) ((fb - frameBuffer) / pitch), height);
+		}
+
+		// Render the current trapezoid defined by left & right edges
+
+		PROFILE_SCOPE(PROFILE_SPANS);
+
+		while(height-- > 0)
+		{
+			// Texture coordinates
+
+			float		overWidth = 1.0f / (re.x - le.x);
+			float		du = (re.u - le.u) * overWidth;
+			float		dv = (re.v - le.v) * overWidth;
+			float		dw = (re.w - le.w) * overWidth;
+
+			// Find the end-points
+
+			int		start = (int) ceil(le.x);
+			int		end   = (int) ceil(re.x);
+
+			PROFILE_COUNT(spans, 1);
+			PROFILE_COUNT(pixels, end > start ? end - start : 0);
+
+			// Texture adjustment (some call this "sub-texel accuracy")
+
+			float		subTex = (float) start - le.x;
+			float		u = le.u + du * subTex;
+			float		v = le.v + dv * subTex;
+			float		w = le.w + dw * subTex;
+
+			// Shading
+
+			#ifdef USE_GOURAUD
+			sSHADE		shade;
+			calcSpanShade(shade, le, re, overWidth, subTex);
+			#endif
+
+			// Fill the entire span, a chunk at a time (replace mode skips the chunk buffer and writes straight to the frame buffer)
+
+			unsigned int	*span = fb + start;
+			unsigned int	texels[blendChunk];
+
+			while(start < end)
+			{
+				int		len = end - start < (int) blendChunk ? end - start : (int) blendChunk;
+				unsigned int	*dst = blend == BLEND_REPLACE ? span : texels;
+
+				for (int j = 0; j < len; j++)
+				{
+					float	z = 1.0f / w;
+					int	s = (int) (u * z);
+					int	t = (int) (v * z);
+
+					dst[j] = textureBuffer[(t<<6)+s];
+
+					u += du;
+					v += dv;
+					w += dw;
+				}
+
+				#ifdef USE_GOURAUD
+				shadeSpan(dst, len, shade);
+				#endif
+
+				if (dst != span) blendSpan(span, texels, len, blend);
+				span += len;
+				start += len;
+			}
+
+			// Step
+
+			le.u += le.du;
+			le.v += le.dv;
+			le.w += le.dw;
+			le.x += le.dx;
+			re.u += re.du;
+			re.v += re.dv;
+			re.w += re.dw;
+			re.x += re.dx;
+			#ifdef USE_GOURAUD
+			stepEdgeShade(le);
+			stepEdgeShade(re);
+			#endif
+			fb += pitch;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Draw a "sub-affine" perspective-correct texture-mapped polygon.  This routine uses affine texture-mapping between sub-spans of
+// subSpan length while only performing perspective correction every subSpan pixels.  This produces a much faster routine that
+// the one above, but suffers from accuracy loss.
+//
+// This routine also suffers from other aliasing problems of the first two, however, since these polygons are an estimated
+// perspective-correct, they choose texels in a non-perfect fasion. Remember that the perspective curve (explained in the comments
+// above the previous example) is being estimated with linear interpolation (i.e. straight lines.)  This can cause the error
+// (already present in a non-linear estimation) to be amplified even more.
+//
+// The greater the subSpan length, the less "perspective correction" is performed AND the less accurately texels will be chosen.
+//
+// This routine also uses a fixed-point representation of the UV values as it interpolates each sub-span.  This should not cause
+// any problems since the fixed-point representation is 8.24 (24 bits used to represent the fractional component) which is a higher
+// degree of resolution than a 32-bit floating-point variable offers.  However, if the delta from texel to texel goes beyond
+// 255.999... texels from texel to texel, the value will overflow and results may be unpredictable.
+//
+// Unlike the other routines, this one reads from the bound texture (see bindTexture) which may be any size up to 256x256 and any of
+// the formats in Texture.h.  The format is checked once per sub-span, so the inner loops stay as tight as the 32-bit original.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	drawSubPerspectiveTexturedPolygon(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch)
+{
+	const	sTEXTURE	&tex = *textureBound;
+
+	// Find the top-most vertex
+
+	sVERT		*v = verts, *lastVert = verts, *lTop = verts, *rTop;
+
+	while(v)
+	{
+		if (v->y < lTop->y) lTop = v;
+		lastVert = v;
+		v->iy = (int) ceil(v->y);
+		v = v->next;
+	}
+
+	// Make sure we have the top-most vertex that is earliest in the winding order
+
+	if (lastVert->y == lTop->y && verts->y == lTop->y) lTop = lastVert;
+
+	rTop = lTop;
+
+	// Top scanline of the polygon in the frame buffer
+
+	unsigned int	*fb = &frameBuffer[lTop->iy * pitch];
+
+	// Left & Right edges (primed with 0)
+
+	sEDGE		le, re;
+	le.height = 0;
+	re.height = 0;
+
+	// Render the polygon
+
+	bool	done = false;
+	while(!done)
+	{
+		if (!le.height)
+		{
+			PROFILE_SCOPE(PROFILE_EDGES);
+
+			sVERT	*lBot = lTop - 1; if (lBot < verts) lBot = lastVert;
+			le.height = lBot->iy - lTop->iy;
+			if (le.height < 0) return;
+			calcEdgeDeltas(le, lTop, lBot);
+			lTop = lBot;
+			if (lTop == rTop) done = true;
+			if (lTop != rTop && done) return;
+		}
+
+		if (!re.height)
+		{
+			PROFILE_SCOPE(PROFILE_EDGES);
+
+			sVERT	*rBot = rTop + 1; if (rBot > lastVert) rBot = verts;
+			re.height = rBot->iy - rTop->iy;
+			if (re.height < 0) return;
+			calcEdgeDeltas(re, rTop, rBot);
+			rTop = rBot;
+			if (lTop == rTop) done = true;
+			if (lTop != rTop && done) return;
+		}
+
+		// Get the height
+
+		int	height = _min(le.height, re.height);
+
+		// Subtract the height from each edge
+
+		le.height -= height;
+		re.height -= height;
+
+		// Clear the frame buffer under the trapezoid (if it's being cleared as it's drawn into)
+
+		if (clearTiles)
+		{
+			PROFILE_SCOPE(PROFILE_CLEAR);
+			touchRows(*clearTiles, (int) ((fb - frameBuffer) / pitch), height);
+		}
+
+		// Render the current trapezoid defined by left & right edges
+
+		PROFILE_SCOPE(PROFILE_SPANS);
+
+		while(height-- > 0)
+		{
+			// Texture coordinates
+
+			float		overWidth = 1.0f / (re.x - le.x);
+			float		du = (re.u - le.u) * overWidth;
+			float		dv = (re.v - le.v) * overWidth;
+			float		dw = (re.w - le.w) * overWidth;
+
+			// Find the end-points
+
+			int		start = (int) ceil(le.x);
+			int		end   = (int) ceil(re.x);
+
+			PROFILE_COUNT(spans, 1);
+			PROFILE_COUNT(pixels, end > start ? end - start : 0);
+
+			// Texture adjustment (some call this "sub-texel accuracy")
+
+			float		subTex = (float) start - le.x;
+			float		u = le.u + du * subTex;
+			float		v = le.v + dv * subTex;
+			float		w = le.w + dw * subTex;
+
+			// Shading
+
+			#ifdef USE_GOURAUD
+			sSHADE		shade;
+			calcSpanShade(shade, le, re, overWidth, subTex);
+			#endif
+
+			// Start of the first span
+
+			float		z  = 1.0f / w;
+			float		s1 = u * z;
+			float		t1 = v * z;
+
+			// Fill the entire span
+
+			unsigned int	*span = fb + start;
+			unsigned int	texels[subSpan];
+			int		pixelsDrawn = 0;
+
+			for(; start < end; start += subSpan)
+			{
+				// Start of the current span
+
+				float		s0 = s1;
+				float		t0 = t1;
+
+				unsigned int	l = end-start;
+				int		len = _min(subSpan, l);
+				pixelsDrawn += len;
+				PROFILE_COUNT(subSpans, 1);
+
+				// End of the current span.  The last one ends on its last pixel: the pixel after it is past the polygon's right
+				// edge, and on a narrow span (where the deltas are huge) it's far enough past it to fetch from outside the texture.
+
+				int		steps = start + len < end ? len : len - 1;
+				float		at = (float) (pixelsDrawn - len + steps);
+				z  = 1.0f / (w + dw * at);
+				s1 = z    * (u + du * at);
+				t1 = z    * (v + dv * at);
+
+				// The span (8.24 fixed-point)
+
+				float		divisor = 1.0f / (steps ? steps : 1) * 0x1000000;
+				unsigned int	ds = (unsigned int) ((s1 - s0) * divisor);
+				unsigned int	dt = (unsigned int) ((t1 - t0) * divisor);
+				unsigned int	s  = (unsigned int) (s0 * 0x1000000);
+				unsigned int	t  = (unsigned int) (t0 * 0x1000000);
+
+				// Draw the sub-span (replace mode fetches straight into the frame buffer)
+
+				unsigned int	*dst = blend == BLEND_REPLACE ? span : texels;
+
+				switch(tex.format)
+				{
+					case TF_ARGB32:	drawSpanARGB32(dst, tex, s, t, ds, dt, len); break;
+					case TF_PAL8:	drawSpanPAL8(dst, tex, s, t, ds, dt, len); break;
+					case TF_BC1:	drawSpanBC1(dst, tex, s, t, ds, dt, len); break;
+					case TF_RGB565:	drawSpanExpand565(dst, tex, s, t, ds, dt, len); break;
+				}
+
+				#ifdef USE_GOURAUD
+				shadeSpan(dst, len, shade);
+				#endif
+
+				if (dst != span) blendSpan(span, texels, len, blend);
+				span += len;
+			}
+
+			// Scanline step
+
+			le.u += le.du;
+			le.v += le.dv;
+			le.w += le.dw;
+			le.x += le.dx;
+			re.u += re.du;
+			re.v += re.dv;
+			re.w += re.dw;
+			re.x += re.dx;
+			#ifdef USE_GOURAUD
+			stepEdgeShade(le);
+			stepEdgeShade(re);
+			#endif
+			fb += pitch;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The 16-bit (5-6-5) version of the sub-affine mapper.  This is the same algorithm as the routine above, but the frame buffer (and
+// its pitch) are in 16-bit pixels, so the blend's read-modify-write moves half as many bytes.  TF_RGB565 textures are fetched
+// directly; other formats are fetched at 32 bits and packed.  There's no Gouraud shading in this path.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	drawSubPerspectiveTexturedPolygon16(sVERT *verts, unsigned short *frameBuffer, const unsigned int pitch)
+{
+	const	sTEXTURE	&tex = *textureBound;
+
+	// Find the top-most vertex
+
+	sVERT		*v = verts, *lastVert = verts, *lTop = verts, *rTop;
+
+	while(v)
+	{
+		if (v->y < lTop->y) lTop = v;
+		lastVert = v;
+		v->iy = (int) ceil(v->y);
+		v = v->next;
+	}
+
+	// Make sure we have the top-most vertex that is earliest in the winding order
+
+	if (lastVert->y == lTop->y && verts->y == lTop->y) lTop = lastVert;
+
+	rTop = lTop;
+
+	// Top scanline of the polygon in the frame buffer
+
+	unsigned short	*fb = &frameBuffer[lTop->iy * pitch];
+
+	// Left & Right edges (primed with 0)
+
+	sEDGE		le, re;
+	le.height = 0;
+	re.height = 0;
+
+	// Render the polygon
+
+	bool	done = false;
+	while(!done)
+	{
+		if (!le.height)
+		{
+			PROFILE_SCOPE(PROFILE_EDGES);
+
+			sVERT	*lBot = lTop - 1; if (lBot < verts) lBot = lastVert;
+			le.height = lBot->iy - lTop->iy;
+			if (le.height < 0) return;
+			calcEdgeDeltas(le, lTop, lBot);
+			lTop = lBot;
+			if (lTop == rTop) done = true;
+			if (lTop != rTop && done) return;
+		}
+
+		if (!re.height)
+		{
+			PROFILE_SCOPE(PROFILE_EDGES);
+
+			sVERT	*rBot = rTop + 1; if (rBot > lastVert) rBot = verts;
+			re.height = rBot->iy - rTop->iy;
+			if (re.height < 0) return;
+			calcEdgeDeltas(re, rTop, rBot);
+			rTop = rBot;
+			if (lTop == rTop) done = true;
+			if (lTop != rTop && done) return;
+		}
+
+		// Get the height
+
+		int	height = _min(le.height, re.height);
+
+		// Subtract the height from each edge
+
+		le.height -= height;
+		re.height -= height;
+
+		// Clear the frame buffer under the trapezoid (if it's being cleared as it's drawn into)
+
+		if (clearTiles)
+		{
+			PROFILE_SCOPE(PROFILE_CLEAR);
+			touchRows(*clearTiles, (int) ((fb - frameBuffer) / pitch), height);
+		}
+
+		// Render the current trapezoid defined by left & right edges
+
+		PROFILE_SCOPE(PROFILE_SPANS);
+
+		while(height-- > 0)
+		{
+			// Texture coordinates
+
+			float		overWidth = 1.0f / (re.x - le.x);
+			float		du = (re.u - le.u) * overWidth;
+			float		dv = (re.v - le.v) * overWidth;
+			float		dw = (re.w - le.w) * overWidth;
+
+			// Find the end-points
+
+			int		start = (int) ceil(le.x);
+			int		end   = (int) ceil(re.x);
+
+			PROFILE_COUNT(spans, 1);
+			PROFILE_COUNT(pixels, end > start ? end - start : 0);
+
+			// Texture adjustment (some call this "sub-texel accuracy")
+
+			float		subTex = (float) start - le.x;
+			float		u = le.u + du * subTex;
+			float		v = le.v + dv * subTex;
+			float		w = le.w + dw * subTex;
+
+			// Start of the first span
+
+			float		z  = 1.0f / w;
+			float		s1 = u * z;
+			float		t1 = v * z;
+
+			// Fill the entire span
+
+			unsigned short	*span = fb + start;
+			unsigned short	texels[subSpan];
+			int		pixelsDrawn = 0;
+
+			for(; start < end; start += subSpan)
+			{
+				// Start of the current span
+
+				float		s0 = s1;
+				float		t0 = t1;
+
+				unsigned int	l = end-start;
+				int		len = _min(subSpan, l);
+				pixelsDrawn += len;
+				PROFILE_COUNT(subSpans, 1);
+
+				// End of the current span (the last one ends on its last pixel; see drawSubPerspectiveTexturedPolygon)
+
+				int		steps = start + len < end ? len : len - 1;
+				float		at = (float) (pixelsDrawn - len + steps);
+				z  = 1.0f / (w + dw * at);
+				s1 = z    * (u + du * at);
+				t1 = z    * (v + dv * at);
+
+				// The span (8.24 fixed-point)
+
+				float		divisor = 1.0f / (steps ? steps : 1) * 0x1000000;
+				unsigned int	ds = (unsigned int) ((s1 - s0) * divisor);
+				unsigned int	dt = (unsigned int) ((t1 - t0) * divisor);
+				unsigned int	s  = (unsigned int) (s0 * 0x1000000);
+				unsigned int	t  = (unsigned int) (t0 * 0x1000000);
+
+				// Draw the sub-span (replace mode fetches straight into the frame buffer)
+
+				unsigned short	*dst = blend == BLEND_REPLACE ? span : texels;
+
+				if (tex.format == TF_RGB565)
+				{
+					drawSpanRGB565(dst, tex, s, t, ds, dt, len);
+				}
+				else
+				{
+					// Any other format is fetched at 32 bits and packed
+
+					unsigned int	argb[subSpan];
+
+					switch(tex.format)
+					{
+						case TF_ARGB32:	drawSpanARGB32(argb, tex, s, t, ds, dt, len); break;
+						case TF_PAL8:	drawSpanPAL8(argb, tex, s, t, ds, dt, len); break;
+						case TF_BC1:	drawSpanBC1(argb, tex, s, t, ds, dt, len); break;
+						default:	break;
+					}
+
+					for (int i = 0; i < len; i++) dst[i] = argbTo565(argb[i]);
+				}
+
+				if (dst != span) blendSpan16(span, texels, len, blend);
+				span += len;
+			}
+
+			// Scanline step
+
+			le.u += le.du;
+			le.v += le.dv;
+			le.w += le.dw;
+			le.x += le.dx;
+			re.u += re.du;
+			re.v += re.dv;
+			re.w += re.dw;
+			re.x += re.dx;
+			fb += pitch;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Draw a "sub-affine" perspective-correct polygon from a virtual texture.  This is the same algorithm as the routine above, with two
+// differences:
+//
+// First, the texture may be far larger than 256 texels, so the 8.24 fixed-point UVs would overflow.  This routine uses 16.16 (good
+// for textures up to 64k on a side), which gives up some fractional precision.  The same caveat applies about deltas -- if the
+// delta from texel to texel goes beyond 32767.999... the value will overflow.
+//
+// Second, every texel is fetched through the virtual texture's page table, which also records the pages touched during the frame
+// (see VirtualTexture.cpp.)  Coordinates wrap, so the right edge overflow described for the affine mapper reads a valid page.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	drawVirtualTexturedPolygon(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch, VirtualTexture &texture)
+{
+	// Find the top-most vertex
+
+	sVERT		*v = verts, *lastVert = verts, *lTop = verts, *rTop;
+
+	while(v)
+	{
+		if (v->y < lTop->y) lTop = v;
+		lastVert = v;
+		v->iy = (int) ceil(v->y);
+		v = v->next;
+	}
+
+	// Make sure we have the top-most vertex that is earliest in the winding order
+
+	if (lastVert->y == lTop->y && verts->y == lTop->y) lTop = lastVert;
+
+	rTop = lTop;
+
+	// Top scanline of the polygon in the frame buffer
+
+	unsigned int	*fb = &frameBuffer[lTop->iy * pitch];
+
+	// Left & Right edges (primed with 0)
+
+	sEDGE		le, re;
+	le.height = 0;
+	re.height = 0;
+
+	// Render the polygon
+
+	bool	done = false;
+	while(!done)
+	{
+		if (!le.height)
+		{
+			PROFILE_SCOPE(PROFILE_EDGES);
+
+			sVERT	*lBot = lTop - 1; if (lBot < verts) lBot = lastVert;
+			le.height = lBot->iy - lTop->iy;
+			if (le.height < 0) return;
+			calcEdgeDeltas(le, lTop, lBot);
+			lTop = lBot;
+			if (lTop == rTop) done = true;
+			if (lTop != rTop && done) return;
+		}
+
+		if (!re.height)
+		{
+			PROFILE_SCOPE(PROFILE_EDGES);
+
+			sVERT	*rBot = rTop + 1; if (rBot > lastVert) rBot = verts;
+			re.height = rBot->iy - rTop->iy;
+			if (re.height < 0) return;
+			calcEdgeDeltas(re, rTop, rBot);
+			rTop = rBot;
+			if (lTop == rTop) done = true;
+			if (lTop != rTop && done) return;
+		}
+
+		// Get the height
+
+		int	height = _min(le.height, re.height);
+
+		// Subtract the height from each edge
+
+		le.height -= height;
+		re.height -= height;
+
+		// Clear the frame buffer under the trapezoid (if it's being cleared as it's drawn into)
+
+		if (clearTiles)
+		{
+			PROFILE_SCOPE(PROFILE_CLEAR);
+			touchRows(*clearTiles, (int) ((fb - frameBuffer) / pitch), height);
+		}
+
+		// Render the current trapezoid defined by left & right edges
+
+		PROFILE_SCOPE(PROFILE_SPANS);
+
+		while(height-- > 0)
+		{
+			// Texture coordinates
+
+			float		overWidth = 1.0f / (re.x - le.x);
+			float		du = (re.u - le.u) * overWidth;
+			float		dv = (re.v - le.v) * overWidth;
+			float		dw = (re.w - le.w) * overWidth;
+
+			// Find the end-points
+
+			int		start = (int) ceil(le.x);
+			int		end   = (int) ceil(re.x);
+
+			PROFILE_COUNT(spans, 1);
+			PROFILE_COUNT(pixels, end > start ? end - start : 0);
+
+			// Texture adjustment (some call this "sub-texel accuracy")
+
+			float		subTex = (float) start - le.x;
+			float		u = le.u + du * subTex;
+			float		v = le.v + dv * subTex;
+			float		w = le.w + dw * subTex;
+
+			// Shading
+
+			#ifdef USE_GOURAUD
+			sSHADE		shade;
+			calcSpanShade(shade, le, re, overWidth, subTex);
+			#endif
+
+			// Start of the first span
+
+			float		z  = 1.0f / w;
+			float		s1 = u * z;
+			float		t1 = v * z;
+
+			// Fill the entire span
+
+			unsigned int	*span = fb + start;
+			unsigned int	texels[subSpan];
+			int		pixelsDrawn = 0;
+
+			for(; start < end; start += subSpan)
+			{
+				// Start of the current span
+
+				float		s0 = s1;
+				float		t0 = t1;
+
+				int		l = end-start;
+				int		len = l < (int) subSpan ? l : (int) subSpan;
+				pixelsDrawn += len;
+				PROFILE_COUNT(subSpans, 1);
+
+				// End of the current span (the last one ends on its last pixel; see drawSubPerspectiveTexturedPolygon)
+
+				int		steps = start + len < end ? len : len - 1;
+				float		at = (float) (pixelsDrawn - len + steps);
+				z  = 1.0f / (w + dw * at);
+				s1 = z    * (u + du * at);
+				t1 = z    * (v + dv * at);
+
+				// The span (16.16 fixed-point)
+
+				float		divisor = 1.0f / (steps ? steps : 1) * 0x10000;
+				unsigned int	ds = (unsigned int) (int) ((s1 - s0) * divisor);
+				unsigned int	dt = (unsigned int) (int) ((t1 - t0) * divisor);
+				unsigned int	s  = (unsigned int) (s0 * 0x10000);
+				unsigned int	t  = (unsigned int) (t0 * 0x10000);
+
+				// Draw the sub-span (replace mode fetches straight into the frame buffer)
+
+				unsigned int	*dst = blend == BLEND_REPLACE ? span : texels;
+
+				for (int j = 0; j < len; j++)
+				{
+					dst[j] = texture.fetch(s>>16, t>>16);
+					s += ds;
+					t += dt;
+				}
+
+				#ifdef USE_GOURAUD
+				shadeSpan(dst, len, shade);
+				#endif
+
+				if (dst != span) blendSpan(span, texels, len, blend);
+				span += len;
+			}
+
+			// Scanline step
+
+			le.u += le.du;
+			le.v += le.dv;
+			le.w += le.dw;
+			le.x += le.dx;
+			re.u += re.du;
+			re.v += re.dv;
+			re.w += re.dw;
+			re.x += re.dx;
+			#ifdef USE_GOURAUD
+			stepEdgeShade(le);
+			stepEdgeShade(re);
+			#endif
+			fb += pitch;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// TMap.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
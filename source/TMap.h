@@ -1,101 +1,279 @@
-// ---------------------------------------------------------------------------------------------------------------------------------
-//  _______ __  __                 _     
-// |__   __|  \/  |               | |    
-//    | |  | \  / | __ _ _ __     | |__  
-//    | |  | |\/| |/ _` | '_ \    | '_ \ 
-//    | |  | |  | | (_| | |_) | _ | | | |
-//    |_|  |_|  |_|\__,_| .__/ (_)|_| |_|
-//                      | |              
-//                      |_|              
-//
-// Generic texture mappers
-//
-// Best viewed with 8-character tabs and (at least) 132 columns
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-//
-// Originally released under a custom license.
-// This historical re-release is provided under the MIT License.
-// See the LICENSE file in the repo root for details.
-//
-// https://github.com/nettlep
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Originally created on 12/22/2000 by Paul Nettle
-//
-// Copyright 2000, Fluid Studios, Inc., all rights reserved.
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-#ifndef	_H_TMAP
-#define	_H_TMAP
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// THESE FLAGS CONTROL WHAT KIND OF TEXTURE MAPPER TO USE (PICK ONLY ONE!)
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-//#define USE_AFFINE
-//#define USE_EXACT_PERSPECTIVE
-#define USE_SUB_AFFINE_PERSPECTIVE
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Constants
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-extern	const	unsigned int	textureWidth;
-extern	const	unsigned int	textureHeight;
-extern	const	unsigned int	subShift;
-extern	const	unsigned int	subSpan;
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// The vertex structure.  Note that this uses a linked list.  I tend to prefer
-// them for ease of managing polygons with large numbers of dynamic vertices,
-// though lists will work fine, too.
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-typedef	struct	vertex
-{
-	float	u, v, w;
-	float	x, y, z;
-	int	iy;
-	struct	vertex *next;
-} sVERT;
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// The edge structure.  This is used to keep track of each left & right edge
-// during scan conversion.  The algorithm does not pre-build an edge list
-// prior to rendering, rather it renders edges as it builds them.  This
-// structure is used only to keep the variables together.
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-typedef	struct	edge
-{
-	float	u, du;
-	float	v, dv;
-	float	w, dw;
-	float	x, dx;
-	int	height;
-} sEDGE;
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// This is handy
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-template<class T>
-inline	T &_min(T &a, T &b)
-{
-	return a < b ? a : b;
-}
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Prototypes
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-void	drawTexture();
-void	drawAffineTexturedPolygon(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch);
-void	drawPerspectiveTexturedPolygon(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch);
-void	drawSubPerspectiveTexturedPolygon(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch);
-
-#endif
-// ---------------------------------------------------------------------------------------------------------------------------------
-// TMap.cpp - End of file
-// ---------------------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _______ __  __                 _     
+// |__   __|  \/  |               | |    
+//    | |  | \  / | __ _ _ __     | |__  
+//    | |  | |\/| |/ _` | '_ \    | '_ \ 
+//    | |  | |  | | (_| | |_) | _ | | | |
+//    |_|  |_|  |_|\__,_| .__/ (_)|_| |_|
+//                      | |              
+//                      |_|              
+//
+// Generic texture mappers
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Originally created on 12/22/2000 by Paul Nettle
+//
+// Copyright 2000, Fluid Studios, Inc., all rights reserved.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_TMAP
+#define	_H_TMAP
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// THESE FLAGS CONTROL WHAT KIND OF TEXTURE MAPPER TO USE (PICK ONLY ONE!)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_AFFINE
+//#define USE_EXACT_PERSPECTIVE
+#define USE_SUB_AFFINE_PERSPECTIVE
+//#define USE_VIRTUAL_TEXTURE
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// THESE FLAGS CONTROL THE TEXTURE FORMAT USED BY THE SUB-AFFINE MAPPER (PICK ONLY ONE!)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#define USE_TEXTURE_ARGB32
+//#define USE_TEXTURE_PAL8
+//#define USE_TEXTURE_BC1
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// THESE FLAGS CONTROL HOW THE MAPPERS BLEND INTO THE FRAME BUFFER (PICK ONLY ONE!)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#define USE_BLEND_ADD
+//#define USE_BLEND_REPLACE
+//#define USE_BLEND_ADD_SATURATE
+//#define USE_BLEND_ALPHA
+//#define USE_BLEND_MULTIPLY
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to use the SSE2 blend routines (requires a Pentium 4 or later, and the VC6 processor pack to compile)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#define USE_SSE2
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to put frame buffers on large pages, when the OS (and the user's privileges) allow it (see BufferPool.cpp)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_LARGE_PAGES
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to clear the frame buffer a tile at a time, right before each tile is first drawn into (see Clear.cpp)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#define USE_TILED_CLEAR
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to track the screen rectangles that are drawn into, clearing & presenting only those (overrides USE_TILED_CLEAR)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_DIRTY_RECTS
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to draw the scene into a render target every few frames, and texture the main scene with it.  Only the sub-affine
+// mapper reads bound textures, so this requires USE_SUB_AFFINE_PERSPECTIVE.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_RENDER_TARGET
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define these to walk per-vertex color (Gouraud shading) and a specular term along with the texture coordinates.  Each texel is
+// modulated by the interpolated color, then the specular is added (saturated.)  USE_SPECULAR requires USE_GOURAUD.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_GOURAUD
+//#define USE_SPECULAR
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to present at a depth other than 32 bits (8, 15, 16 or 24.)  Rendering is still done at 32 bits; the frame is
+// converted right before it's presented (see Convert.cpp.)  Define USE_DITHER to ordered-dither the 8, 15 & 16-bit conversions.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_OUTPUT_DEPTH 16
+//#define USE_DITHER
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to render straight into a 16-bit (5-6-5) frame buffer, which halves the frame buffer traffic of the blends.  The
+// texture is converted to TF_RGB565 up front.  Requires USE_SUB_AFFINE_PERSPECTIVE, and doesn't mix with USE_GOURAUD,
+// USE_RENDER_TARGET or USE_OUTPUT_DEPTH.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_RENDER_565
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define one of these to choose how frames are presented (see Presenter.cpp.)  The default copies the frame buffer to the display
+// with SetDIBitsToDevice.  A DIB section shares the frame buffer with GDI (no copy), and the null presenter presents nothing.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_PRESENT_DIB_SECTION
+//#define USE_PRESENT_NULL
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to present from a separate thread while the next frame is drawn (see SwapChain.cpp.)  The value is the number of
+// frame buffers: 2 for double buffering, 3 for triple.  Doesn't mix with USE_DIRTY_RECTS or USE_PRESENT_DIB_SECTION.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_SWAP_CHAIN 2
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to draw into a ring of buffers in shared memory under the given name, so other processes can read the frames in
+// place (see FrameExport.cpp.)  Doesn't mix with USE_SWAP_CHAIN, USE_DIRTY_RECTS or USE_PRESENT_DIB_SECTION.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_FRAME_EXPORT "TMapViewerFrames"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to record every frame to the given file on a background thread (see FrameCapture.cpp.)  The extension picks the
+// format: .y4m (YUV 4:2:0, for encoders), .ppm (a numbered file per frame) or anything else for raw pixels.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_CAPTURE "capture.y4m"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to draw at whatever resolution fits the frame time budget (in milliseconds), scaling up to the window as the
+// frame is presented (see DynamicResolution.cpp.)  Doesn't mix with USE_DIRTY_RECTS or USE_RENDER_565.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_DYNAMIC_RESOLUTION 16.667
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define one of these to pace the frame loop (see FrameLoop.cpp): USE_VSYNC waits for the display's vertical blank (where the
+// desktop compositor provides one), and USE_FRAME_LIMIT caps the frame rate (in frames per second), sleeping between frames.
+// Without either, frames are drawn as fast as they can be.  The animation runs at the same speed regardless.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_VSYNC
+//#define USE_FRAME_LIMIT 60
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to time the hot paths and count what each frame draws (see Profile.cpp.)  Without it, the instrumentation isn't
+// compiled at all.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_PROFILE
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to record a timeline of the last few frames (the profile timers, plus the present and capture threads' work) and
+// write it to the given file as Chrome trace-event JSON when the viewer exits (see Trace.cpp.)  Requires USE_PROFILE.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_TRACE "trace.json"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to draw frame times (with a graph), the mapper and, with USE_PROFILE, what was drawn, over the top of every frame
+// (see Hud.cpp.)  Doesn't mix with USE_RENDER_565.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_HUD
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to record the polygons of the first few hundred frames, as they're handed to the mappers, to the given file (see
+// PolyStream.cpp.)  The Replay tool plays a recording back through the mappers, without the window, for benchmarking.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_POLY_RECORD "frames.tmps"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Define this to draw a mesh instead of the four quads: a Wavefront OBJ file (converted to a binary .tmsh next to it the first
+// time through) or a .tmsh (see Mesh.cpp.)  If it can't be loaded, the quads are drawn.  The mesh is culled a chunk at a time
+// (see MeshScene.cpp); define USE_MESH_ZOOM to narrow the view so that only part of it is on the screen at once (the polygons that
+// cross the edges are clipped; see clipPolygon.)  With USE_MESH_REORDER, the conversion reorders the polygons & vertices so the ones
+// used together are together in memory (see Mesh.cpp; a .tmsh that's already been converted is used as it is, so delete it to
+// convert again.)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+//#define USE_MESH "scene.obj"
+//#define USE_MESH_ZOOM 4.0f
+#define USE_MESH_REORDER
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+extern	const	unsigned int	textureWidth;
+extern	const	unsigned int	textureHeight;
+extern	const	unsigned int	subShift;
+extern	const	unsigned int	subSpan;
+
+const	unsigned int	clipMaxVerts = 32;		// In a polygon, once it's clipped (see clipPolygon)
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The vertex structure.  Note that this uses a linked list.  I tend to prefer
+// them for ease of managing polygons with large numbers of dynamic vertices,
+// though lists will work fine, too.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	vertex
+{
+	float	u, v, w;
+	float	x, y, z;
+	float	r, g, b;		// Color (0-255)
+	float	i;			// Intensity (scales the color, 1.0 = unchanged)
+	float	s;			// Specular (0-255)
+	int	iy;
+	struct	vertex *next;
+} sVERT;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The edge structure.  This is used to keep track of each left & right edge
+// during scan conversion.  The algorithm does not pre-build an edge list
+// prior to rendering, rather it renders edges as it builds them.  This
+// structure is used only to keep the variables together.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	edge
+{
+	float	u, du;
+	float	v, dv;
+	float	w, dw;
+	float	x, dx;
+	float	r, dr;			// Lit color (color * intensity)
+	float	g, dg;
+	float	b, db;
+	float	s, ds;			// Specular
+	int	height;
+} sEDGE;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// This is handy
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+template<class T>
+inline	T &_min(T &a, T &b)
+{
+	return a < b ? a : b;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	drawTexture();
+void	bindTexture(const sTEXTURE *texture);
+const	sTEXTURE &defaultTexture();
+const	sTEXTURE &boundTexture();
+void	setBlendMode(const BlendMode mode);
+BlendMode	blendMode();
+void	bindClearTiles(sCLEARTILES *tiles);
+sVERT	*clipPolygon(sVERT *verts, sVERT clipped[clipMaxVerts], const unsigned int width, const unsigned int height);
+void	drawAffineTexturedPolygon(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch);
+void	drawPerspectiveTexturedPolygon(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch);
+void	drawSubPerspectiveTexturedPolygon(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch);
+void	drawSubPerspectiveTexturedPolygon16(sVERT *verts, unsigned short *frameBuffer, const unsigned int pitch);
+void	drawVirtualTexturedPolygon(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch, VirtualTexture &texture);
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// TMap.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,413 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _______         _                                       
+// |__   __|       | |                                      
+//    | |  _____  _| |_ _   _ _ __ ___      ___ _ __  _ __  
+//    | | / _ \ \/ / __| | | | '__/ _ \    / __| '_ \| '_ \ 
+//    | ||  __/>  <| |_| |_| | | |  __/ _ | (__| |_) | |_) |
+//    |_| \___/_/\_\\__|\__,_|_|  \___|(_) \___| .__/| .__/ 
+//                                             | |   | |    
+//                                             |_|   |_|    
+//
+// Texture formats (32-bit, 8-bit palettized & 4bpp block-compressed)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// At high resolutions, the mappers spend much of their time waiting on texels.  The smaller formats trade a little quality (and a
+// little decode work) for a much smaller footprint:
+//
+//   TF_ARGB32  32bpp  (64x64 = 16K)
+//   TF_PAL8     8bpp  (64x64 =  4K + 1K palette)
+//   TF_BC1      4bpp  (64x64 =  2K + the decoded-block cache)
+//   TF_RGB565  16bpp  (64x64 =  8K)
+//
+// Palettes are built with a median cut: the texture's colors are split along their widest channel at the median, over and over,
+// until there are 256 boxes.  Each box becomes one palette entry (the average of its colors.)
+//
+// BC1 blocks are encoded the quick way: the darkest & brightest texels of the block become the endpoints, and each texel takes the
+// closest of the four colors they describe.  Texels under 50% alpha become transparent (BC1's 1-bit alpha.)  This is not the best
+// encoder in the world, but it's simple and it's fast enough to run at load time.
+//
+// TF_RGB565 is for the 16-bit render path.  There's no alpha, so texels under 50% alpha become 0 (which the 16-bit alpha blend
+// treats as transparent) and opaque texels that would have been 0 are nudged up to the darkest green.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <stdlib.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	int	log2i(unsigned int n)
+{
+	if (!n || (n & (n - 1))) return -1;
+	int	result = 0;
+	while(n >>= 1) result++;
+	return result;
+}
+
+static	inline	unsigned int	channel(const unsigned int c, const int shift)
+{
+	return (c >> shift) & 0xff;
+}
+
+static	inline	unsigned int	colorDistance(const unsigned int a, const unsigned int b)
+{
+	int	da = (int) channel(a, 24) - (int) channel(b, 24);
+	int	dr = (int) channel(a, 16) - (int) channel(b, 16);
+	int	dg = (int) channel(a,  8) - (int) channel(b,  8);
+	int	db = (int) channel(a,  0) - (int) channel(b,  0);
+	return da*da + dr*dr + dg*dg + db*db;
+}
+
+static	inline	unsigned int	lerpColor(const unsigned int a, const unsigned int b, const unsigned int wa, const unsigned int wb, const unsigned int div)
+{
+	unsigned int	al = (channel(a, 24) * wa + channel(b, 24) * wb) / div;
+	unsigned int	r = (channel(a, 16) * wa + channel(b, 16) * wb) / div;
+	unsigned int	g = (channel(a,  8) * wa + channel(b,  8) * wb) / div;
+	unsigned int	bl = (channel(a,  0) * wa + channel(b,  0) * wb) / div;
+	return (al << 24) | (r << 16) | (g << 8) | bl;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Expands a BC1 block into 16 ARGB texels
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	decodeBC1Block(const sBC1BLOCK &block, unsigned int *texels)
+{
+	unsigned int	colors[4];
+	colors[0] = argbFrom565(block.c0);
+	colors[1] = argbFrom565(block.c1);
+
+	if (block.c0 > block.c1)
+	{
+		colors[2] = lerpColor(colors[0], colors[1], 2, 1, 3);
+		colors[3] = lerpColor(colors[0], colors[1], 1, 2, 3);
+	}
+	else
+	{
+		colors[2] = lerpColor(colors[0], colors[1], 1, 1, 2);
+		colors[3] = 0;				// Transparent black
+	}
+
+	unsigned int	indices = block.indices;
+	for (int i = 0; i < 16; i++, indices >>= 2)
+	{
+		texels[i] = colors[indices & 3];
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Encodes one 4x4 block of ARGB texels (read with the given pitch)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	encodeBC1Block(const unsigned int *src, const unsigned int pitch, sBC1BLOCK &block)
+{
+	// Endpoints are the darkest & brightest opaque texels
+
+	unsigned int	lo = 0, hi = 0;
+	unsigned int	loLum = 0xffffffff, hiLum = 0;
+	bool		transparent = false;
+
+	for (unsigned int y = 0; y < 4; y++)
+	{
+		for (unsigned int x = 0; x < 4; x++)
+		{
+			unsigned int	c = src[y*pitch+x];
+			if (channel(c, 24) < 0x80)
+			{
+				transparent = true;
+				continue;
+			}
+
+			unsigned int	lum = channel(c, 16) * 77 + channel(c, 8) * 150 + channel(c, 0) * 29;
+			if (lum < loLum) {loLum = lum; lo = c;}
+			if (lum >= hiLum) {hiLum = lum; hi = c;}
+		}
+	}
+
+	// Four-color mode requires c0 > c1; blocks with transparent texels use three-color mode (c0 <= c1) so that index 3 is
+	// transparent.  An opaque block that quantizes to c0 == c1 ends up in three-color mode too, so it only uses the first three.
+
+	block.c0 = argbTo565(hi);
+	block.c1 = argbTo565(lo);
+	if ((block.c0 < block.c1) != transparent)
+	{
+		unsigned short	t = block.c0; block.c0 = block.c1; block.c1 = t;
+	}
+
+	// With indices of 0, 1, 2 & 3, the first four decoded texels are the block's four colors
+
+	unsigned int	colors[16];
+	block.indices = 0xE4;
+	decodeBC1Block(block, colors);
+
+	unsigned int	colorCount = block.c0 > block.c1 ? 4 : 3;
+
+	block.indices = 0;
+	for (int i = 15; i >= 0; i--)
+	{
+		unsigned int	c = src[(i>>2)*pitch+(i&3)];
+		unsigned int	best = 3, bestDist = 0xffffffff;
+
+		if (channel(c, 24) >= 0x80)
+		{
+			for (unsigned int j = 0; j < colorCount; j++)
+			{
+				unsigned int	d = colorDistance(c, colors[j]);
+				if (d < bestDist) {bestDist = d; best = j;}
+			}
+		}
+
+		block.indices = (block.indices << 2) | best;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Median cut palette generation
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	int	sortShift;
+
+static	int	compareChannel(const void *a, const void *b)
+{
+	return (int) channel(*(const unsigned int *) a, sortShift) - (int) channel(*(const unsigned int *) b, sortShift);
+}
+
+static	void	medianCut(const unsigned int *argb, const unsigned int count, unsigned int *palette)
+{
+	unsigned int	*colors = new unsigned int[count];
+	memcpy(colors, argb, count * sizeof(unsigned int));
+
+	// Each box is a range of the colors array
+
+	unsigned int	boxStart[256], boxEnd[256];
+	unsigned int	boxes = 1;
+	boxStart[0] = 0;
+	boxEnd[0] = count;
+
+	while(boxes < 256)
+	{
+		// Find the box with the widest channel
+
+		int		widest = -1, widestShift = 0, widestRange = 0;
+
+		for (unsigned int i = 0; i < boxes; i++)
+		{
+			if (boxEnd[i] - boxStart[i] < 2) continue;
+
+			for (int shift = 0; shift <= 24; shift += 8)
+			{
+				unsigned int	lo = 0xff, hi = 0;
+				for (unsigned int j = boxStart[i]; j < boxEnd[i]; j++)
+				{
+					unsigned int	c = channel(colors[j], shift);
+					if (c < lo) lo = c;
+					if (c > hi) hi = c;
+				}
+
+				if ((int) (hi - lo) > widestRange)
+				{
+					widest = i;
+					widestShift = shift;
+					widestRange = hi - lo;
+				}
+			}
+		}
+
+		// Nothing left to split (fewer than 256 distinct colors)
+
+		if (widest < 0) break;
+
+		// Split it at the median
+
+		sortShift = widestShift;
+		qsort(&colors[boxStart[widest]], boxEnd[widest] - boxStart[widest], sizeof(unsigned int), compareChannel);
+
+		unsigned int	median = (boxStart[widest] + boxEnd[widest]) / 2;
+		boxStart[boxes] = median;
+		boxEnd[boxes] = boxEnd[widest];
+		boxEnd[widest] = median;
+		boxes++;
+	}
+
+	// Each palette entry is the average of its box
+
+	for (unsigned int i = 0; i < 256; i++)
+	{
+		if (i >= boxes)
+		{
+			palette[i] = 0;
+			continue;
+		}
+
+		unsigned int	a = 0, r = 0, g = 0, b = 0, n = boxEnd[i] - boxStart[i];
+		for (unsigned int j = boxStart[i]; j < boxEnd[i]; j++)
+		{
+			a += channel(colors[j], 24);
+			r += channel(colors[j], 16);
+			g += channel(colors[j],  8);
+			b += channel(colors[j],  0);
+		}
+
+		palette[i] = ((a / n) << 24) | ((r / n) << 16) | ((g / n) << 8) | (b / n);
+	}
+
+	delete[] colors;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Wraps an existing ARGB texel buffer (the texture does not own it)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool	wrapTexture(sTEXTURE &tex, unsigned int *argb, const unsigned int width, const unsigned int height)
+{
+	memset(&tex, 0, sizeof(tex));
+	if (log2i(width) < 0 || log2i(height) < 0) return false;
+
+	tex.format = TF_ARGB32;
+	tex.width = width;
+	tex.height = height;
+	tex.widthShift = log2i(width);
+	tex.argb = argb;
+	tex.owner = false;
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Creates a texture of the given format from ARGB texels
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool	createTexture(sTEXTURE &tex, const TextureFormat format, const unsigned int *argb, const unsigned int width, const unsigned int height)
+{
+	memset(&tex, 0, sizeof(tex));
+	if (log2i(width) < 0 || log2i(height) < 0) return false;
+
+	tex.format = format;
+	tex.width = width;
+	tex.height = height;
+	tex.widthShift = log2i(width);
+	tex.owner = true;
+
+	unsigned int	count = width * height;
+
+	switch(format)
+	{
+		case TF_ARGB32:
+			tex.argb = new unsigned int[count];
+			memcpy(tex.argb, argb, count * sizeof(unsigned int));
+			break;
+
+		case TF_PAL8:
+		{
+			tex.palette = new unsigned int[256];
+			tex.indices = new unsigned char[count];
+			medianCut(argb, count, tex.palette);
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+				unsigned int	best = 0, bestDist = 0xffffffff;
+				for (unsigned int j = 0; j < 256 && bestDist; j++)
+				{
+					unsigned int	d = colorDistance(argb[i], tex.palette[j]);
+					if (d < bestDist) {bestDist = d; best = j;}
+				}
+				tex.indices[i] = (unsigned char) best;
+			}
+			break;
+		}
+
+		case TF_RGB565:
+			tex.rgb565 = new unsigned short[count];
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+				unsigned short	c = argbTo565(argb[i]);
+				if (c == rgb565Transparent) c = 0x0020;
+				tex.rgb565[i] = channel(argb[i], 24) < 0x80 ? rgb565Transparent : c;
+			}
+			break;
+
+		case TF_BC1:
+		{
+			if (width < 4 || height < 4) return false;
+
+			tex.blocks = new sBC1BLOCK[count / 16];
+			tex.cache = new sBC1CACHE[bc1CacheSize];
+			memset(tex.cache, 0, bc1CacheSize * sizeof(sBC1CACHE));
+
+			sBC1BLOCK	*block = tex.blocks;
+			for (unsigned int y = 0; y < height; y += 4)
+			{
+				for (unsigned int x = 0; x < width; x += 4)
+				{
+					encodeBC1Block(&argb[y*width+x], width, *(block++));
+				}
+			}
+			break;
+		}
+
+		default:
+			return false;
+	}
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	destroyTexture(sTEXTURE &tex)
+{
+	if (tex.owner)
+	{
+		delete[] tex.argb;
+		delete[] tex.indices;
+		delete[] tex.palette;
+		delete[] tex.blocks;
+		delete[] tex.rgb565;
+	}
+
+	delete[] tex.cache;
+	memset(&tex, 0, sizeof(tex));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns the memory footprint of the texels (not counting the decoded-block cache)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int	textureBytes(const sTEXTURE &tex)
+{
+	switch(tex.format)
+	{
+		case TF_ARGB32:	return tex.width * tex.height * sizeof(unsigned int);
+		case TF_PAL8:	return tex.width * tex.height + 256 * sizeof(unsigned int);
+		case TF_BC1:	return tex.width * tex.height / 16 * sizeof(sBC1BLOCK);
+		case TF_RGB565:	return tex.width * tex.height * sizeof(unsigned short);
+	}
+	return 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Texture.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
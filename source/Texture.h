@@ -0,0 +1,132 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _______         _                      _     
+// |__   __|       | |                    | |    
+//    | |  _____  _| |_ _   _ _ __ ___    | |__  
+//    | | / _ \ \/ / __| | | | '__/ _ \   | '_ \ 
+//    | ||  __/>  <| |_| |_| | | |  __/ _ | | | |
+//    |_| \___/_/\_\\__|\__,_|_|  \___|(_)|_| |_|
+//                                               
+//                                               
+//
+// Texture formats (32-bit, 8-bit palettized & 4bpp block-compressed)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_TEXTURE
+#define	_H_TEXTURE
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Texture formats
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+enum	TextureFormat
+{
+	TF_ARGB32,				// 32 bits per texel (0xAARRGGBB)
+	TF_PAL8,				// 8 bits per texel, indexing a 256-entry ARGB palette
+	TF_BC1,					// 4 bits per texel, as 4x4 blocks of two 5-6-5 endpoints and 2-bit indices
+	TF_RGB565				// 16 bits per texel (5-6-5, with 0 reserved for transparent)
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// A BC1 block.  The block describes four colors: the two endpoints and two more interpolated between them (at 1/3 & 2/3).  If c0
+// is not greater than c1, the block has only three colors (the third is halfway) and index 3 is transparent black.  Indices are
+// row-major, two bits each, starting at the low bits.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	bc1block
+{
+	unsigned short	c0, c1;
+	unsigned int	indices;
+} sBC1BLOCK;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The decoded-block cache.  BC1 textures keep a small, direct-mapped cache of decoded blocks so that runs of texels from the same
+// block (the common case in a span) decode once.  At 32 entries, it fits comfortably alongside the blocks in L1.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned int	bc1CacheSize = 32;
+
+typedef	struct	bc1cache
+{
+	unsigned int	tag;			// Block index + 1 (0 == empty)
+	unsigned int	texels[16];
+} sBC1CACHE;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The texture.  Dimensions are powers of two.  Only the members for the texture's format are used.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	texture
+{
+	TextureFormat	format;
+	unsigned int	width, height;
+	unsigned int	widthShift;		// log2(width)
+	unsigned int	*argb;			// TF_ARGB32
+	unsigned char	*indices;		// TF_PAL8
+	unsigned int	*palette;		// TF_PAL8
+	sBC1BLOCK	*blocks;		// TF_BC1 (width/4 x height/4 blocks)
+	sBC1CACHE	*cache;			// TF_BC1
+	unsigned short	*rgb565;		// TF_RGB565
+	bool		owner;			// If true, destroyTexture() frees the texels
+	unsigned int	generation;		// Bumped when the texels are redrawn (see RenderTarget::updated)
+} sTEXTURE;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// 5-6-5 conversion.  Expanding replicates the top bits into the bottom, so full intensity stays full intensity.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+const	unsigned short	rgb565Transparent = 0;
+
+inline	unsigned short	argbTo565(const unsigned int c)
+{
+	return (unsigned short) (((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F));
+}
+
+inline	unsigned int	argbFrom565(const unsigned short c)
+{
+	unsigned int	r = (c >> 11) & 0x1f;
+	unsigned int	g = (c >>  5) & 0x3f;
+	unsigned int	b = (c      ) & 0x1f;
+	return 0xff000000 | ((r << 3 | r >> 2) << 16) | ((g << 2 | g >> 4) << 8) | (b << 3 | b >> 2);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns the decoded texels of a BC1 block through the texture's cache
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	decodeBC1Block(const sBC1BLOCK &block, unsigned int *texels);
+
+inline	const	unsigned int	*bc1CachedBlock(const sTEXTURE &tex, const unsigned int index)
+{
+	sBC1CACHE	&entry = tex.cache[index & (bc1CacheSize - 1)];
+	if (entry.tag != index + 1)
+	{
+		decodeBC1Block(tex.blocks[index], entry.texels);
+		entry.tag = index + 1;
+	}
+	return entry.texels;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		wrapTexture(sTEXTURE &tex, unsigned int *argb, const unsigned int width, const unsigned int height);
+bool		createTexture(sTEXTURE &tex, const TextureFormat format, const unsigned int *argb, const unsigned int width, const unsigned int height);
+void		destroyTexture(sTEXTURE &tex);
+unsigned int	textureBytes(const sTEXTURE &tex);
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Texture.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
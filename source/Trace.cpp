@@ -0,0 +1,228 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _______                                        
+// |__   __|                                       
+//    | | _ __ __ _  ___  ___      ___ _ __  _ __  
+//    | || '__/ _` |/ __|/ _ \    / __| '_ \| '_ \ 
+//    | || | | (_| | (__|  __/ _ | (__| |_) | |_) |
+//    |_||_|  \__,_|\___|\___|(_) \___| .__/| .__/ 
+//                                    | |   | |    
+//                                    |_|   |_|    
+//
+// Frame timelines (Chrome trace-event export)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// Every profile timer (or, while the scene is drawn, a summary of them; see Profile.cpp) and every TRACE_SCOPE adds an event to a
+// ring that's allocated (and touched) when the trace starts, so recording an event is a handful of stores: a slot is claimed with
+// an interlocked increment, and nothing is allocated or locked, so any thread can add events.  The ring holds enough events for
+// the last few frames (a frame adds a few dozen, so 256 each leaves plenty of room); when it's written, only the events of the last
+// 'frames' frames are kept (the frame starts are in a small ring of their own.)
+//
+// The output is Chrome's trace-event JSON (load it in chrome://tracing or ui.perfetto.dev.)  Each event is a complete ("X") event
+// on its thread's track, and each frame is an event of its own, so the stages of a frame show up nested under it.  Threads are
+// named by traceThreadName() when they start.  Times are converted from ticks to microseconds when the trace is written, against
+// the performance counter over the life of the trace.
+//
+// Nothing stops the other threads while the trace is written or freed, so it must be written (and stopped) once every thread that
+// adds events has stopped.  The renderer does this when it shuts down, after it's stopped the swap chain's present thread and the
+// capture thread.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <stdio.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+#ifdef	USE_TRACE
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The ring
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	sTRACEEVENT		*events = NULL;
+static	unsigned int		eventMask;		// Capacity - 1 (the capacity is a power of two)
+static	volatile LONG		eventCount = 0;		// Ever recorded
+
+static	unsigned __int64	*frameStarts = NULL;
+static	unsigned int		frameCapacity;
+static	unsigned int		frameCount;
+
+static	unsigned __int64	startTicks;
+static	double			startSeconds;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Thread names
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+enum	{MAX_THREADS = 16};
+
+static	struct
+{
+	unsigned int	id;
+	const	char	*name;
+} threads[MAX_THREADS];
+
+static	volatile LONG		threadCount = 0;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Allocates a ring big enough for the last 'frames' frames, at up to 'eventsPerFrame' events each
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool	traceStart(const unsigned int frames, const unsigned int eventsPerFrame)
+{
+	traceStop();
+
+	unsigned int	capacity = 1;
+	while (capacity < frames * eventsPerFrame) capacity <<= 1;
+
+	events = new sTRACEEVENT[capacity];
+	frameStarts = new unsigned __int64[frames];
+	if (!events || !frameStarts)
+	{
+		traceStop();
+		return false;
+	}
+
+	// Touch it all now, rather than on the first trip around
+
+	memset(events, 0, capacity * sizeof(sTRACEEVENT));
+	memset(frameStarts, 0, frames * sizeof(unsigned __int64));
+
+	eventMask = capacity - 1;
+	eventCount = 0;
+	frameCapacity = frames;
+	frameCount = 0;
+
+	startSeconds = seconds();
+	startTicks = readTicks();
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	traceStop()
+{
+	delete[] events;
+	events = NULL;
+	delete[] frameStarts;
+	frameStarts = NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Names the calling thread's track
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	traceThreadName(const char *name)
+{
+	unsigned int	index = (unsigned int) InterlockedIncrement((LONG *) &threadCount) - 1;
+	if (index >= MAX_THREADS) return;
+
+	threads[index].id = GetCurrentThreadId();
+	threads[index].name = name;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Marks the start of a frame (on the render thread)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	traceFrame(const unsigned __int64 start)
+{
+	if (!frameStarts) return;
+
+	frameStarts[frameCount % frameCapacity] = start;
+	frameCount++;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void	traceEvent(const char *name, const unsigned __int64 begin, const unsigned __int64 end)
+{
+	if (!events) return;
+
+	unsigned int	index = (unsigned int) InterlockedIncrement((LONG *) &eventCount) - 1;
+	sTRACEEVENT	&event = events[index & eventMask];
+
+	event.name = name;
+	event.thread = GetCurrentThreadId();
+	event.begin = begin;
+	event.end = end;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Writes the last frames' events as trace-event JSON
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool	traceWrite(const char *filename)
+{
+	if (!events) return false;
+
+	FILE	*fp = fopen(filename, "w");
+	if (!fp) return false;
+
+	// Microseconds per tick
+
+	unsigned __int64	ticks = readTicks() - startTicks;
+	double			scale = ticks ? (seconds() - startSeconds) * 1000000.0 / (double) (__int64) ticks : 0;
+
+	// Events that started before the oldest frame we still have the start of are dropped
+
+	unsigned __int64	cutoff = 0;
+	if (frameCount > frameCapacity) cutoff = frameStarts[frameCount % frameCapacity];
+
+	unsigned int	last = (unsigned int) eventCount;
+	unsigned int	first = last > eventMask + 1 ? last - (eventMask + 1) : 0;
+
+	// The tracks
+
+	fprintf(fp, "{\"traceEvents\":[\n");
+	fprintf(fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"TMapViewer\"}}");
+
+	unsigned int	threadTotal = (unsigned int) threadCount;
+	if (threadTotal > MAX_THREADS) threadTotal = MAX_THREADS;
+
+	for (unsigned int t = 0; t < threadTotal; t++)
+	{
+		fprintf(fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+			threads[t].id, threads[t].name);
+	}
+
+	// The events
+
+	for (unsigned int i = first; i != last; i++)
+	{
+		const	sTRACEEVENT	&event = events[i & eventMask];
+		if (!event.name || event.begin < cutoff || event.begin < startTicks || event.end < event.begin) continue;
+
+		fprintf(fp, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", event.name, event.thread,
+			(double) (__int64) (event.begin - startTicks) * scale, (double) (__int64) (event.end - event.begin) * scale);
+	}
+
+	fprintf(fp, "\n],\"displayTimeUnit\":\"ms\"}\n");
+	fclose(fp);
+	return true;
+}
+
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Trace.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
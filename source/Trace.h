@@ -0,0 +1,83 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _______                       _     
+// |__   __|                     | |    
+//    | | _ __ __ _  ___  ___    | |__  
+//    | || '__/ _` |/ __|/ _ \   | '_ \ 
+//    | || | | (_| | (__|  __/ _ | | | |
+//    |_||_|  \__,_|\___|\___|(_)|_| |_|
+//                                      
+//                                      
+//
+// Frame timelines (Chrome trace-event export)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_TRACE
+#define	_H_TRACE
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// An event: a named span of time on a thread (in time stamp counter ticks; see readTicks)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	traceevent
+{
+	const	char		*name;		// Must outlive the trace (a string literal, in practice)
+	unsigned int		thread;
+	unsigned __int64	begin;
+	unsigned __int64	end;
+} sTRACEEVENT;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Without USE_TRACE, the macros expand to nothing
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef	USE_TRACE
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Prototypes
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool	traceStart(const unsigned int frames = 120, const unsigned int eventsPerFrame = 256);
+void	traceStop();
+void	traceThreadName(const char *name);
+void	traceFrame(const unsigned __int64 start);
+void	traceEvent(const char *name, const unsigned __int64 begin, const unsigned __int64 end);
+bool	traceWrite(const char *filename);
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Adds the time from construction to destruction to the trace
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	TraceScope
+{
+public:
+inline				TraceScope(const char *name) :_name(name), _start(readTicks()) {}
+inline				~TraceScope() {traceEvent(_name, _start, readTicks());}
+
+private:
+	const	char		*_name;
+		unsigned __int64 _start;
+};
+
+#define	TRACE_SCOPE(name)		TraceScope traceScope(name)
+
+#else
+
+#define	TRACE_SCOPE(name)
+
+#endif
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Trace.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
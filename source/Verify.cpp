@@ -0,0 +1,1380 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _     _          _  __                            
+// | |   | |        (_)/ _|                           
+// | |   | |___ _ __ _| |_ _   _      ___ _ __  _ __  
+//  \ \ / // _ \ '__| |  _| | | |    / __| '_ \| '_ \ 
+//   \ V /|  __/ |  | | | | |_| | _ | (__| |_) | |_) |
+//    \_/  \___|_|  |_|_|  \__, |(_) \___| .__/| .__/ 
+//                          __/ |        | |   | |    
+//                         |___/         |_|   |_|    
+//
+// Differential tests of the mappers and their kernels
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// Usage: Verify [polygons] [seed] [tolerance]
+//
+// Draws random polygons (2000 by default) through every mapper this build has, and checks them against each other and against
+// the plain routines they were optimized from.  Each check prints one line; anything that fails prints the first few cases it
+// failed on (with the seed and polygon number, so they can be drawn again), and the exit code is the number of checks that failed.
+//
+// The checks:
+//
+//   blend   - blendSpan and blendSpan16 over whole spans (the SSE2 path, where it's built) against the same spans one pixel at a
+//             time (the scalar path), for every mode.  These must be bit-exact.
+//   clear   - clearBuffer (streaming stores) against fillBuffer at every alignment.  Bit-exact, and nothing past the end written.
+//   bounds  - no mapper writes a pixel outside the polygon's bounding box (top-left fill: the rows from ceil(top) up to
+//             ceil(bottom), and the columns from floor(left) through ceil(right), to allow for the edges' accumulated error.)
+//   coverage- every mapper draws exactly the same pixels as the reference (the exact perspective mapper, or the affine mapper in an
+//             affine build.)  They share their edge setup, so this is bit-exact.
+//   texels  - the sub-affine mapper's texel coordinates against the exact perspective mapper's, pixel for pixel.  This is the one
+//             approximation in the mappers, so it's checked against a tolerance (in texels; 1 by default), and the worst error
+//             and the number of pixels that were off at all are printed.
+//   formats - the PAL8, BC1 and 5-6-5 kernels against the ARGB kernel: each must fetch exactly the texel the ARGB kernel did (as
+//             decoded from its own format), so they're bit-exact.  The 16-bit mapper is checked the same way.
+//   clip    - polygons that cross the edges of the buffer, clipped with clipPolygon.  Nothing may be drawn off the screen, and the
+//             pixels on it must be the ones the whole polygon draws (bar those exactly on an edge, which may round either way.)
+//   overlap - grids and fans of polygons that share their edges, added into a buffer with a texture of 1s.  No pixel may be drawn
+//             twice, and none inside the shape may be missed.
+//   bvh     - trees over random boxes: each node holds what's under it, and culling against random planes finds exactly the boxes
+//             that testing them one at a time does.  Checked again after moving some of the boxes (refit.)
+//
+// To tell which texel a mapper fetched, the texture is filled with its own coordinates (red is a marker, green is u, blue is v.)
+// The shading is set to white with no specular, so a Gouraud build draws the same texels as any other.
+//
+// The polygons are convex and clockwise, as the mappers require, and they're kept inside the buffer (the mappers don't clip; the
+// clip check's are clipped first.)
+// Every eighth one is ordinary; the rest are the cases that break rasterizers: slivers, collinear and duplicate vertices, polygons
+// with no height or no width (edge-on), sub-pixel polygons and rectangles on exact pixel boundaries.  The texture coordinates stay
+// at least a texel inside the texture, so the mappers never have a reason to fetch outside it.
+//
+// The virtual texture mapper isn't covered; it needs a virtual texture file.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	int		verifyWidth = 256;		// The buffer the polygons are drawn into
+static	const	int		verifyHeight = 256;		//
+static	const	int		verifyPitch = 264;		// Not a multiple of 16 bytes, so the rows start at every alignment
+static	const	unsigned int	verifyMaxVerts = 9;
+static	const	unsigned int	verifyMaxFan = 16;		// Triangles around a fan
+static	const	unsigned int	verifyMaxReports = 4;		// Failures printed per check
+static	const	unsigned int	coordMarker = 0xff800000;	// The coordinate texture (red is a marker, green is u, blue is v)
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The mappers under test (the first is the reference)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	void	(*Mapper)(sVERT *verts, unsigned int *frameBuffer, const unsigned int pitch);
+
+static	const	struct
+{
+	const	char		*name;
+	Mapper			draw;
+} mappers[] =
+{
+	#ifdef USE_AFFINE
+	{"affine",		drawAffineTexturedPolygon}
+	#else
+	{"perspective",		drawPerspectiveTexturedPolygon},
+	{"sub-affine",		drawSubPerspectiveTexturedPolygon},
+	{"affine",		drawAffineTexturedPolygon}	// Coverage only (its UVs aren't divided by w)
+	#endif
+};
+
+static	const	unsigned int	mapperCount = sizeof(mappers) / sizeof(mappers[0]);
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The kinds of polygon generated (in turn)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+enum	PolygonKind
+{
+	POLYGON_CONVEX,				// 3 to 8 vertices on an ellipse
+	POLYGON_SLIVER,				// A long triangle less than a pixel wide
+	POLYGON_COLLINEAR,			// A vertex in the middle of an edge
+	POLYGON_DUPLICATE,			// The same vertex twice in a row
+	POLYGON_FLAT,				// No height (edge-on, horizontally)
+	POLYGON_VERTICAL,			// No width (edge-on, vertically)
+	POLYGON_TINY,				// Smaller than a pixel
+	POLYGON_RECTANGLE,			// Axis-aligned, half of them on exact pixel boundaries
+	POLYGON_KINDS
+};
+
+static	const	char	*polygonKindNames[POLYGON_KINDS] =
+{
+	"convex", "sliver", "collinear", "duplicate", "flat", "vertical", "tiny", "rectangle"
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// A check's results
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	verifycheck
+{
+	const	char	*name;
+	unsigned int	tested;			// Pixels (or spans, or polygons)
+	unsigned int	failed;
+} sVERIFYCHECK;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Random numbers (a plain LCG, so a seed means the same polygons on every compiler)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	unsigned int	randomState = 1;
+
+static	unsigned int	randomInt(const unsigned int range)
+{
+	randomState = randomState * 1664525 + 1013904223;
+	return (randomState >> 8) % range;
+}
+
+static	float	randomFloat(const float lo, const float hi)
+{
+	randomState = randomState * 1664525 + 1013904223;
+	return lo + (hi - lo) * (float) (randomState >> 8) / (float) 0x1000000;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Counts a failure, and prints it if it's one of the first few
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	bool	report(sVERIFYCHECK &check)
+{
+	return ++check.failed <= verifyMaxReports;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	summary(const sVERIFYCHECK &check, const char *units, const char *extra = "")
+{
+	printf("%-9s %-6s %10u %-8s %s\n", check.name, check.failed ? "FAILED" : "ok", check.tested, units, extra);
+	if (check.failed) printf("          %u failed\n", check.failed);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// blendSpan & blendSpan16: a whole span against the same span a pixel at a time (which never reaches the SSE2 code)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	verifyBlend(sVERIFYCHECK &check, const unsigned int trials)
+{
+	const	unsigned int	maxLen = blendChunk + 7;
+	unsigned int		src[maxLen], dst[maxLen], ref[maxLen];
+	unsigned short		src16[maxLen], dst16[maxLen], ref16[maxLen];
+
+	for (unsigned int trial = 0; trial < trials; trial++)
+	{
+		BlendMode	mode = (BlendMode) (trial % 5);
+		int		len = randomInt(maxLen + 1);
+		int		i;
+
+		// Random pixels, with plenty of the edge cases (black, white, transparent, opaque)
+
+		for (i = 0; i < len; i++)
+		{
+			switch(randomInt(4))
+			{
+				case 0:	src[i] = 0; break;
+				case 1:	src[i] = 0xffffffff; break;
+				case 2:	src[i] = (randomInt(2) ? 0xff000000 : 0) | (randomInt(0x10000) << 8) | randomInt(0x100); break;
+				default: src[i] = (randomInt(0x10000) << 16) | randomInt(0x10000); break;
+			}
+
+			dst[i] = ref[i] = (randomInt(0x10000) << 16) | randomInt(0x10000);
+			src16[i] = (unsigned short) (randomInt(4) ? randomInt(0x10000) : 0);
+			dst16[i] = ref16[i] = (unsigned short) randomInt(0x10000);
+		}
+
+		blendSpan(dst, src, len, mode);
+		blendSpan16(dst16, src16, len, mode);
+
+		for (i = 0; i < len; i++)
+		{
+			blendSpan(&ref[i], &src[i], 1, mode);
+			blendSpan16(&ref16[i], &src16[i], 1, mode);
+		}
+
+		for (i = 0; i < len; i++)
+		{
+			if (dst[i] != ref[i] && report(check))
+			{
+				printf("  blend (mode %d): pixel %d of %d: %08X over %08X gave %08X, a pixel at a time gave %08X\n", mode, i, len,
+					src[i], ref[i], dst[i], ref[i]);
+			}
+
+			if (dst16[i] != ref16[i] && report(check))
+			{
+				printf("  blend16 (mode %d): pixel %d of %d: %04X gave %04X, a pixel at a time gave %04X\n", mode, i, len,
+					src16[i], dst16[i], ref16[i]);
+			}
+		}
+
+		check.tested += len * 2;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// clearBuffer against fillBuffer, at every alignment
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	verifyClear(sVERIFYCHECK &check, const unsigned int trials)
+{
+	const	unsigned int	maxCount = 300;
+	const	unsigned int	guard = 0xdeadbeef;
+	unsigned int		*buffer = new unsigned int[maxCount + 32];
+	unsigned int		*expected = new unsigned int[maxCount + 32];
+
+	for (unsigned int trial = 0; trial < trials; trial++)
+	{
+		unsigned int	offset = randomInt(16);
+		unsigned int	count = randomInt(maxCount + 1);
+		unsigned int	color = randomInt(4) ? (randomInt(0x10000) << 16) | randomInt(0x10000) : 0;
+		unsigned int	i;
+
+		for (i = 0; i < maxCount + 32; i++) buffer[i] = expected[i] = guard;
+
+		clearBuffer(buffer + offset, count, color);
+		fillBuffer(expected + offset, count, color);
+
+		for (i = 0; i < maxCount + 32; i++)
+		{
+			if (buffer[i] != expected[i])
+			{
+				if (report(check))
+				{
+					printf("  clear: %u pixels of %08X at offset %u: word %u is %08X, should be %08X\n", count, color, offset, i,
+						buffer[i], expected[i]);
+				}
+				break;
+			}
+		}
+
+		check.tested++;
+	}
+
+	delete[] buffer;
+	delete[] expected;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Polygons
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	float	signedArea(const sVERT *verts, const unsigned int count)
+{
+	float	area = 0;
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		const	sVERT	&a = verts[i];
+		const	sVERT	&b = verts[(i + 1) % count];
+		area += a.x * b.y - b.x * a.y;
+	}
+
+	return area * 0.5f;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Vertices on an ellipse, in clockwise order (on screen, with y pointing down, that's increasing angle)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	ellipse(sVERT *verts, const unsigned int count, const float cx, const float cy, const float rx, const float ry)
+{
+	float		angles[verifyMaxFan];
+	unsigned int	i;
+
+	for (i = 0; i < count; i++)
+	{
+		float		a = randomFloat(0, 6.2831853f);
+		unsigned int	j = i;
+
+		for (; j > 0 && angles[j-1] > a; j--) angles[j] = angles[j-1];
+		angles[j] = a;
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		verts[i].x = cx + rx * (float) cos(angles[i]);
+		verts[i].y = cy + ry * (float) sin(angles[i]);
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Links the vertices and gives them their texture coordinates and shading.  'reach' is how far (in buffers) from the middle of the
+// buffer the polygon may be, so the plane never gets edge-on (or behind the eye) inside it.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	finishPolygon(sVERT *verts, const unsigned int count, const float reach = 1.0f)
+{
+	// Clockwise (anything with no area is left as it is)
+
+	if (signedArea(verts, count) < 0)
+	{
+		for (unsigned int i = 0; i < count / 2; i++)
+		{
+			sVERT	temp = verts[i];
+			verts[i] = verts[count - 1 - i];
+			verts[count - 1 - i] = temp;
+		}
+	}
+
+	// A plane in perspective (1/z, u/z and v/z are linear on screen, as they are for any flat polygon), at depths like the viewer's
+	// and no more than about a texel per pixel
+
+	float		centerX = verifyWidth / 2.0f, centerY = verifyHeight / 2.0f;
+	float		plane[3][3];
+	unsigned int	i, j;
+
+	#ifdef USE_AFFINE
+	plane[2][0] = 1;
+	plane[2][1] = plane[2][2] = 0;
+	#else
+	plane[2][0] = 1.0f / randomFloat(10.0f, 30.0f);
+	plane[2][1] = randomFloat(-0.4f, 0.4f) * plane[2][0] / (centerX * reach);
+	plane[2][2] = randomFloat(-0.4f, 0.4f) * plane[2][0] / (centerY * reach);
+	#endif
+
+	for (j = 0; j < 2; j++)
+	{
+		plane[j][0] = 0;
+		plane[j][1] = randomFloat(-1.0f, 1.0f) * plane[2][0];
+		plane[j][2] = randomFloat(-1.0f, 1.0f) * plane[2][0];
+	}
+
+	float	uv[verifyMaxFan][2];
+
+	for (i = 0; i < count; i++)
+	{
+		sVERT	&v = verts[i];
+		float	x = v.x - centerX, y = v.y - centerY;
+
+		v.w = plane[2][0] + plane[2][1] * x + plane[2][2] * y;
+		v.z = 1.0f / v.w;
+		for (j = 0; j < 2; j++) uv[i][j] = (plane[j][0] + plane[j][1] * x + plane[j][2] * y) * v.z;
+	}
+
+	// Moved (and shrunk, if need be) to at least a texel inside the texture.  That's an affine change to u & v, so it keeps them on
+	// the plane.
+
+	for (j = 0; j < 2; j++)
+	{
+		float	lo = uv[0][j], hi = uv[0][j];
+
+		for (i = 1; i < count; i++)
+		{
+			if (uv[i][j] < lo) lo = uv[i][j];
+			if (uv[i][j] > hi) hi = uv[i][j];
+		}
+
+		float	room = (float) (j ? textureHeight : textureWidth) - 2.0f;
+		float	scale = hi - lo > room ? room / (hi - lo) : 1.0f;
+		float	offset = 1.0f + randomFloat(0, room - (hi - lo) * scale);
+
+		for (i = 0; i < count; i++) uv[i][j] = offset + (uv[i][j] - lo) * scale;
+	}
+
+	for (i = 0; i < count; i++)
+	{
+		sVERT	&v = verts[i];
+		v.u = uv[i][0] * v.w;
+		v.v = uv[i][1] * v.w;
+
+		// White, so the shading leaves the texels as they are
+
+		v.r = v.g = v.b = 255;
+		v.i = 1;
+		v.s = 0;
+		v.next = i + 1 < count ? &verts[i + 1] : NULL;
+	}
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Generates a polygon of the given kind (kept two pixels inside the buffer.)  Returns the vertex count.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	unsigned int	makePolygon(sVERT *verts, const PolygonKind kind)
+{
+	const	float	lo = 2.0f;
+	const	float	hiX = (float) verifyWidth - 3.0f;
+	const	float	hiY = (float) verifyHeight - 3.0f;
+	unsigned int	count = 0;
+
+	switch(kind)
+	{
+		case POLYGON_CONVEX:
+		case POLYGON_COLLINEAR:
+		case POLYGON_DUPLICATE:
+		{
+			float	rx = randomFloat(1.0f, 100.0f);
+			float	ry = randomInt(4) ? randomFloat(1.0f, 100.0f) : rx;
+			count = 3 + randomInt(kind == POLYGON_CONVEX ? 6 : 5);
+			ellipse(verts, count, randomFloat(lo + rx, hiX - rx), randomFloat(lo + ry, hiY - ry), rx, ry);
+
+			if (kind != POLYGON_CONVEX)
+			{
+				// Make room for the extra vertex after 'at'
+
+				unsigned int	at = randomInt(count);
+				for (unsigned int i = count; i > at + 1; i--) verts[i] = verts[i-1];
+
+				const	sVERT	&a = verts[at];
+				const	sVERT	&b = verts[(at + 2) % (count + 1)];
+				float		t = kind == POLYGON_COLLINEAR ? randomFloat(0.1f, 0.9f) : 0.0f;
+				verts[at + 1].x = a.x + (b.x - a.x) * t;
+				verts[at + 1].y = a.y + (b.y - a.y) * t;
+				count++;
+			}
+			break;
+		}
+
+		case POLYGON_SLIVER:
+		{
+			// A long edge, and a third vertex just off it
+
+			float	x0 = randomFloat(lo, hiX), y0 = randomFloat(lo, hiY);
+			float	x1 = randomFloat(lo, hiX), y1 = randomFloat(lo, hiY);
+			float	dx = x1 - x0, dy = y1 - y0;
+			float	length = (float) sqrt(dx * dx + dy * dy);
+			if (length < 1.0f) {x1 = x0 + 20.0f; dx = 20.0f; dy = 0; length = 20.0f;}
+			if (x1 > hiX) {x1 = x0 - 20.0f; dx = -20.0f;}
+
+			float	t = randomFloat(0.05f, 0.95f);
+			float	off = randomFloat(0.001f, 0.7f) / length;
+			verts[0].x = x0;
+			verts[0].y = y0;
+			verts[1].x = x1;
+			verts[1].y = y1;
+			verts[2].x = x0 + dx * t - dy * off;
+			verts[2].y = y0 + dy * t + dx * off;
+			count = 3;
+			break;
+		}
+
+		case POLYGON_FLAT:
+		case POLYGON_VERTICAL:
+		{
+			// Three or four vertices along a line (in order, so they're "convex")
+
+			float	a = randomFloat(lo, kind == POLYGON_FLAT ? hiY : hiX);
+			float	from = randomFloat(lo, (kind == POLYGON_FLAT ? hiX : hiY) - 20.0f);
+			float	to = from + randomFloat(0.5f, 20.0f);
+			count = 3 + randomInt(2);
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+				float	b = from + (to - from) * i / (count - 1);
+				verts[i].x = kind == POLYGON_FLAT ? b : a;
+				verts[i].y = kind == POLYGON_FLAT ? a : b;
+			}
+			break;
+		}
+
+		case POLYGON_TINY:
+		{
+			float	r = randomFloat(0.05f, 1.5f);
+			count = 3 + randomInt(4);
+			ellipse(verts, count, randomFloat(lo + r, hiX - r), randomFloat(lo + r, hiY - r), r, r * randomFloat(0.3f, 1.0f));
+			break;
+		}
+
+		case POLYGON_RECTANGLE:
+		{
+			float	x0 = randomFloat(lo, hiX - 1.0f), y0 = randomFloat(lo, hiY - 1.0f);
+			float	x1 = x0 + randomFloat(0.5f, hiX - x0), y1 = y0 + randomFloat(0.5f, hiY - y0);
+
+			if (randomInt(2))
+			{
+				x0 = (float) floor(x0); y0 = (float) floor(y0);
+				x1 = (float) floor(x1); y1 = (float) floor(y1);
+				if (x1 == x0) x1 += 1.0f;
+				if (y1 == y0) y1 += 1.0f;
+			}
+
+			verts[0].x = x0; verts[0].y = y0;
+			verts[1].x = x1; verts[1].y = y0;
+			verts[2].x = x1; verts[2].y = y1;
+			verts[3].x = x0; verts[3].y = y1;
+			count = 4;
+			break;
+		}
+
+		default:
+			break;
+	}
+
+	finishPolygon(verts, count);
+	return count;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	printPolygon(const sVERT *verts, const unsigned int count, const unsigned int seed, const unsigned int index)
+{
+	printf("    polygon %u (seed %u, %s):", index, seed, polygonKindNames[index % POLYGON_KINDS]);
+	for (unsigned int i = 0; i < count; i++) printf(" (%.6f, %.6f)", verts[i].x, verts[i].y);
+	printf("\n");
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Draws a polygon with a mapper (into a cleared buffer), from a copy of the vertices (the mappers write to them)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	draw(const Mapper mapper, const sVERT *verts, const unsigned int count, unsigned int *buffer)
+{
+	sVERT	copy[verifyMaxVerts];
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		copy[i] = verts[i];
+		copy[i].next = i + 1 < count ? &copy[i + 1] : NULL;
+	}
+
+	fillBuffer(buffer, verifyPitch * verifyHeight, 0);
+	mapper(copy, buffer, verifyPitch);
+}
+
+static	void	draw16(const sVERT *verts, const unsigned int count, unsigned short *buffer)
+{
+	sVERT	copy[verifyMaxVerts];
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		copy[i] = verts[i];
+		copy[i].next = i + 1 < count ? &copy[i + 1] : NULL;
+	}
+
+	memset(buffer, 0, verifyPitch * verifyHeight * sizeof(unsigned short));
+	drawSubPerspectiveTexturedPolygon16(copy, buffer, verifyPitch);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The random polygons: bounds, coverage, texels and formats
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	verifyPolygons(sVERIFYCHECK &bounds, sVERIFYCHECK &coverage, sVERIFYCHECK &texels, sVERIFYCHECK &formats,
+			       const unsigned int polygons, const unsigned int seed, const unsigned int tolerance,
+			       unsigned int &maxError, unsigned int &pixelsOff)
+{
+	const	unsigned int	pixels = verifyPitch * verifyHeight;
+	unsigned int		*reference = new unsigned int[pixels];
+	unsigned int		*buffer = new unsigned int[pixels];
+	unsigned int		*subAffine = new unsigned int[pixels];
+	unsigned short		*buffer16 = new unsigned short[pixels];
+	unsigned int		x, y;
+
+	// The coordinate texture, in every format
+
+	unsigned int	*coords = defaultTexture().argb;
+
+	for (y = 0; y < textureHeight; y++)
+	{
+		for (x = 0; x < textureWidth; x++) coords[y * textureWidth + x] = coordMarker | (x << 8) | y;
+	}
+
+	#ifndef USE_AFFINE
+	const	TextureFormat	formatList[] = {TF_PAL8, TF_BC1, TF_RGB565};
+	const	unsigned int	formatCount = sizeof(formatList) / sizeof(formatList[0]);
+	const	char		*formatNames[] = {"PAL8", "BC1", "5-6-5"};
+	sTEXTURE		textures[formatCount];
+	unsigned int		f;
+
+	for (f = 0; f < formatCount; f++) createTexture(textures[f], formatList[f], coords, textureWidth, textureHeight);
+	#endif
+
+	setBlendMode(BLEND_REPLACE);
+
+	for (unsigned int p = 0; p < polygons; p++)
+	{
+		sVERT		verts[verifyMaxVerts];
+		unsigned int	count = makePolygon(verts, (PolygonKind) (p % POLYGON_KINDS));
+		unsigned int	i;
+
+		// The box it may draw in
+
+		float	minX = verts[0].x, maxX = verts[0].x, minY = verts[0].y, maxY = verts[0].y;
+
+		for (i = 1; i < count; i++)
+		{
+			if (verts[i].x < minX) minX = verts[i].x;
+			if (verts[i].x > maxX) maxX = verts[i].x;
+			if (verts[i].y < minY) minY = verts[i].y;
+			if (verts[i].y > maxY) maxY = verts[i].y;
+		}
+
+		int	left = (int) floor(minX), right = (int) ceil(maxX);
+		int	top = (int) ceil(minY), bottom = (int) ceil(maxY);
+
+		// The reference
+
+		bindTexture(NULL);
+		draw(mappers[0].draw, verts, count, reference);
+
+		for (unsigned int m = 0; m < mapperCount; m++)
+		{
+			unsigned int	*out = m ? buffer : reference;
+			if (m) draw(mappers[m].draw, verts, count, buffer);
+
+			bool	outside = false, different = false;
+
+			for (y = 0; y < verifyHeight; y++)
+			{
+				for (x = 0; x < verifyPitch; x++)
+				{
+					unsigned int	pixel = y * verifyPitch + x;
+					bool		drawn = out[pixel] != 0;
+
+					if (drawn && ((int) x < left || (int) x > right || (int) y < top || (int) y >= bottom) && !outside)
+					{
+						outside = true;
+						if (report(bounds))
+						{
+							printf("  bounds: %s drew (%u, %u), outside [%d-%d] x [%d-%d)\n", mappers[m].name, x, y, left,
+								right, top, bottom);
+							printPolygon(verts, count, seed, p);
+						}
+					}
+
+					if (m && drawn != (reference[pixel] != 0) && !different)
+					{
+						different = true;
+						if (report(coverage))
+						{
+							printf("  coverage: %s %s (%u, %u), %s didn't\n", mappers[m].name, drawn ? "drew" : "missed",
+								x, y, mappers[0].name);
+							printPolygon(verts, count, seed, p);
+						}
+					}
+
+					if (m) coverage.tested += drawn;
+				}
+			}
+
+			bounds.tested++;
+			if (m == 1) memcpy(subAffine, buffer, pixels * sizeof(unsigned int));
+		}
+
+		#ifndef USE_AFFINE
+
+		// Texels: the sub-affine mapper's against the exact perspective mapper's
+
+		bool	wrong = false;
+
+		for (i = 0; i < pixels; i++)
+		{
+			if (!reference[i] || !subAffine[i]) continue;
+
+			int		du = abs((int) ((reference[i] >> 8) & 0xff) - (int) ((subAffine[i] >> 8) & 0xff));
+			int		dv = abs((int) (reference[i] & 0xff) - (int) (subAffine[i] & 0xff));
+			unsigned int	error = du > dv ? du : dv;
+
+			if ((reference[i] & 0xffff0000) != coordMarker || (subAffine[i] & 0xffff0000) != coordMarker) error = 0xff;
+			if (error) pixelsOff++;
+			if (error > maxError) maxError = error;
+			texels.tested++;
+
+			if (error > tolerance && !wrong)
+			{
+				wrong = true;
+				if (report(texels))
+				{
+					printf("  texels: (%u, %u): sub-affine fetched %08X, perspective fetched %08X\n", i % verifyPitch,
+						i / verifyPitch, subAffine[i], reference[i]);
+					printPolygon(verts, count, seed, p);
+				}
+			}
+		}
+
+		// Formats: each kernel must fetch the texel the ARGB kernel did
+
+		for (f = 0; f < formatCount; f++)
+		{
+			const	sTEXTURE	&tex = textures[f];
+
+			bindTexture(&tex);
+			draw(drawSubPerspectiveTexturedPolygon, verts, count, buffer);
+			if (tex.format == TF_RGB565) draw16(verts, count, buffer16);
+
+			bool	mismatch = false, mismatch16 = false;
+
+			for (i = 0; i < pixels; i++)
+			{
+				unsigned int	expected = 0;
+				unsigned short	expected16 = 0;
+
+				if (subAffine[i])
+				{
+					unsigned int	u = (subAffine[i] >> 8) & 0xff;
+					unsigned int	v = subAffine[i] & 0xff;
+					unsigned int	index = v * textureWidth + u;
+
+					switch(tex.format)
+					{
+						case TF_PAL8:
+							expected = tex.palette[tex.indices[index]];
+							break;
+
+						case TF_BC1:
+						{
+							unsigned int	block[16];
+							decodeBC1Block(tex.blocks[(v >> 2) * (textureWidth >> 2) + (u >> 2)], block);
+							expected = block[(v & 3) * 4 + (u & 3)];
+							break;
+						}
+
+						case TF_RGB565:
+							expected16 = tex.rgb565[index];
+							expected = expected16 == rgb565Transparent ? 0 : argbFrom565(expected16);
+							break;
+
+						default:
+							break;
+					}
+				}
+
+				if (buffer[i] != expected && !mismatch)
+				{
+					mismatch = true;
+					if (report(formats))
+					{
+						printf("  formats: %s: (%u, %u) is %08X, should be %08X\n", formatNames[f], i % verifyPitch,
+							i / verifyPitch, buffer[i], expected);
+						printPolygon(verts, count, seed, p);
+					}
+				}
+
+				if (tex.format == TF_RGB565 && buffer16[i] != expected16 && !mismatch16)
+				{
+					mismatch16 = true;
+					if (report(formats))
+					{
+						printf("  formats: 16-bit mapper: (%u, %u) is %04X, should be %04X\n", i % verifyPitch,
+							i / verifyPitch, buffer16[i], expected16);
+						printPolygon(verts, count, seed, p);
+					}
+				}
+
+				if (subAffine[i]) formats.tested += tex.format == TF_RGB565 ? 2 : 1;
+			}
+		}
+
+		#endif
+	}
+
+	bindTexture(NULL);
+
+	#ifndef USE_AFFINE
+	for (f = 0; f < formatCount; f++) destroyTexture(textures[f]);
+	#endif
+
+	delete[] reference;
+	delete[] buffer;
+	delete[] subAffine;
+	delete[] buffer16;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Polygons that cross the edges of the buffer (or miss it), clipped with clipPolygon.  Each mapper draws the clipped polygon into
+// the buffer (with a guard row above & below it, and the padding at the end of each row, none of which it may write), and the whole
+// polygon into a buffer three times the size, with the screen in the middle.  The screen's pixels must match, except where the
+// pixel lies on one of the polygon's edges (where the clipped edge, set up from a different vertex, may round the other way.)
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	verifyClip(sVERIFYCHECK &check, const unsigned int polygons, const unsigned int seed, const unsigned int tolerance)
+{
+	const	int		bigWidth = verifyWidth * 3;
+	const	int		bigHeight = verifyHeight * 3;
+	const	unsigned int	pixels = verifyPitch * (verifyHeight + 2);
+	unsigned int		*buffer = new unsigned int[pixels];
+	unsigned int		*big = new unsigned int[bigWidth * bigHeight];
+	unsigned int		*screen = buffer + verifyPitch;
+	int			x, y;
+
+	// The coordinate texture (as verifyPolygons has it)
+
+	unsigned int	*coords = defaultTexture().argb;
+
+	for (y = 0; y < (int) textureHeight; y++)
+	{
+		for (x = 0; x < (int) textureWidth; x++) coords[y * textureWidth + x] = coordMarker | (x << 8) | y;
+	}
+
+	setBlendMode(BLEND_REPLACE);
+	bindTexture(NULL);
+
+	for (unsigned int p = 0; p < polygons; p++)
+	{
+		// Somewhere around the buffer, up to a buffer's width from it
+
+		sVERT		verts[verifyMaxFan];
+		float		r = randomFloat(4.0f, 180.0f);
+		unsigned int	count = 3 + randomInt(6);
+		unsigned int	i;
+
+		ellipse(verts, count, randomFloat(-60.0f, verifyWidth + 60.0f), randomFloat(-60.0f, verifyHeight + 60.0f), r,
+			r * randomFloat(0.2f, 1.0f));
+		finishPolygon(verts, count, 3.0f);
+
+		// The edges (as lines, normalized so a*x + b*y + c is the distance from them)
+
+		float	edges[verifyMaxFan][3];
+
+		for (i = 0; i < count; i++)
+		{
+			const	sVERT	&a = verts[i];
+			const	sVERT	&b = verts[(i + 1) % count];
+			float		dx = b.x - a.x, dy = b.y - a.y;
+			float		length = (float) sqrt(dx * dx + dy * dy);
+			if (length == 0) length = 1;
+			edges[i][0] = dy / length;
+			edges[i][1] = -dx / length;
+			edges[i][2] = -(edges[i][0] * a.x + edges[i][1] * a.y);
+		}
+
+		for (unsigned int m = 0; m < mapperCount; m++)
+		{
+			// Clipped (clipPolygon writes 'next', and the mappers write 'iy', so each mapper gets a fresh copy)
+
+			sVERT	copy[verifyMaxFan], clipped[clipMaxVerts];
+
+			for (i = 0; i < count; i++)
+			{
+				copy[i] = verts[i];
+				copy[i].next = i + 1 < count ? &copy[i + 1] : NULL;
+			}
+
+			fillBuffer(buffer, pixels, 0);
+			sVERT	*poly = clipPolygon(copy, clipped, verifyWidth, verifyHeight);
+			if (poly) mappers[m].draw(poly, screen, verifyPitch);
+
+			// Whole, offset into the middle of the big buffer
+
+			for (i = 0; i < count; i++)
+			{
+				copy[i] = verts[i];
+				copy[i].x += (float) verifyWidth;
+				copy[i].y += (float) verifyHeight;
+				copy[i].next = i + 1 < count ? &copy[i + 1] : NULL;
+			}
+
+			fillBuffer(big, bigWidth * bigHeight, 0);
+			mappers[m].draw(copy, big, bigWidth);
+
+			bool	failed = false;
+
+			for (y = -1; y <= verifyHeight && !failed; y++)
+			{
+				for (x = 0; x < verifyPitch && !failed; x++)
+				{
+					unsigned int	drawn = screen[y * verifyPitch + x];
+
+					if (y < 0 || y == verifyHeight || x >= verifyWidth)
+					{
+						if (!drawn) continue;
+
+						failed = true;
+						if (report(check))
+						{
+							printf("  clip: %s drew (%d, %d), off the screen\n", mappers[m].name, x, y);
+							printPolygon(verts, count, seed, p);
+						}
+						continue;
+					}
+
+					unsigned int	whole = big[(y + verifyHeight) * bigWidth + x + verifyWidth];
+					if ((drawn != 0) == (whole != 0))
+					{
+						// The same texel (give or take the tolerance; the sub-affine mapper's spans start in different places)
+
+						int	du = abs((int) ((drawn >> 8) & 0xff) - (int) ((whole >> 8) & 0xff));
+						int	dv = abs((int) (drawn & 0xff) - (int) (whole & 0xff));
+						if (!drawn || (du <= (int) tolerance && dv <= (int) tolerance)) continue;
+					}
+					else
+					{
+						float	nearest = 1.0f;
+
+						for (i = 0; i < count; i++)
+						{
+							float	d = (float) fabs(edges[i][0] * x + edges[i][1] * y + edges[i][2]);
+							if (d < nearest) nearest = d;
+						}
+
+						if (nearest < 0.01f) continue;
+					}
+
+					failed = true;
+					if (report(check))
+					{
+						printf("  clip: %s: (%d, %d) is %08X clipped, %08X whole\n", mappers[m].name, x, y, drawn, whole);
+						printPolygon(verts, count, seed, p);
+					}
+				}
+			}
+
+			check.tested++;
+		}
+	}
+
+	delete[] buffer;
+	delete[] big;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Polygons that share edges: a jittered grid (of quads, or of triangles) or a fan of triangles around a point.  Each one is added
+// into the buffer with a texture of 1s, so a pixel's value is the number of times it was drawn.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	void	verifyOverlap(sVERIFYCHECK &check, const unsigned int shapes, const unsigned int seed)
+{
+	const	unsigned int	pixels = verifyPitch * verifyHeight;
+	const	unsigned int	maxCells = 8;
+	unsigned int		*buffer = new unsigned int[pixels];
+	unsigned short		*buffer16 = new unsigned short[pixels];
+	unsigned int		i;
+
+	unsigned int	*texels = defaultTexture().argb;
+	for (i = 0; i < textureWidth * textureHeight; i++) texels[i] = 1;
+
+	#ifndef USE_AFFINE
+	unsigned int	ones565[textureWidth * textureHeight];
+	for (i = 0; i < textureWidth * textureHeight; i++) ones565[i] = argbFrom565(1);
+
+	sTEXTURE	tex565;
+	createTexture(tex565, TF_RGB565, ones565, textureWidth, textureHeight);
+	#endif
+
+	setBlendMode(BLEND_ADD);
+
+	for (unsigned int shape = 0; shape < shapes; shape++)
+	{
+		// The outline's edges (as inward-facing lines: a*x + b*y + c is the distance inside), and the polygons
+
+		float		edges[verifyMaxFan][3];
+		unsigned int	edgeCount = 0;
+		sVERT		polys[maxCells * maxCells * 2][4];
+		unsigned int	counts[maxCells * maxCells * 2];
+		unsigned int	polyCount = 0;
+		unsigned int	j;
+
+		if (shape & 1)
+		{
+			// A fan
+
+			sVERT		rim[verifyMaxFan];
+			unsigned int	n = 3 + randomInt(verifyMaxFan - 2);
+			float		r = randomFloat(5.0f, 120.0f);
+			float		cx = randomFloat(r + 2.0f, verifyWidth - r - 3.0f), cy = randomFloat(r + 2.0f, verifyHeight - r - 3.0f);
+			ellipse(rim, n, cx, cy, r, r * randomFloat(0.2f, 1.0f));
+
+			// The center, somewhere inside
+
+			float	hubX = 0, hubY = 0;
+			for (i = 0; i < n; i++) {hubX += rim[i].x; hubY += rim[i].y;}
+			hubX /= n;
+			hubY /= n;
+
+			for (i = 0; i < n; i++)
+			{
+				const	sVERT	&a = rim[i];
+				const	sVERT	&b = rim[(i + 1) % n];
+
+				polys[polyCount][0].x = hubX; polys[polyCount][0].y = hubY;
+				polys[polyCount][1].x = a.x; polys[polyCount][1].y = a.y;
+				polys[polyCount][2].x = b.x; polys[polyCount][2].y = b.y;
+				counts[polyCount++] = 3;
+
+				float	ex = b.x - a.x, ey = b.y - a.y;
+				float	length = (float) sqrt(ex * ex + ey * ey);
+				if (length <= 0) continue;
+
+				edges[edgeCount][0] = -ey / length;
+				edges[edgeCount][1] = ex / length;
+				edges[edgeCount][2] = -(edges[edgeCount][0] * a.x + edges[edgeCount][1] * a.y);
+				edgeCount++;
+			}
+		}
+		else
+		{
+			// A grid (the outline stays a rectangle; the vertices inside move by up to a fifth of a cell)
+
+			unsigned int	cols = 1 + randomInt(maxCells), rows = 1 + randomInt(maxCells);
+			float		x0 = randomFloat(2.0f, verifyWidth / 2.0f), y0 = randomFloat(2.0f, verifyHeight / 2.0f);
+			float		x1 = randomFloat(x0 + cols, verifyWidth - 3.0f), y1 = randomFloat(y0 + rows, verifyHeight - 3.0f);
+			float		cellW = (x1 - x0) / cols, cellH = (y1 - y0) / rows;
+			bool		triangles = randomInt(2) != 0;
+			float		gx[maxCells + 1][maxCells + 1], gy[maxCells + 1][maxCells + 1];
+
+			for (j = 0; j <= rows; j++)
+			{
+				for (i = 0; i <= cols; i++)
+				{
+					gx[j][i] = x0 + cellW * i;
+					gy[j][i] = y0 + cellH * j;
+					if (i && i < cols) gx[j][i] += randomFloat(-0.2f, 0.2f) * cellW;
+					if (j && j < rows) gy[j][i] += randomFloat(-0.2f, 0.2f) * cellH;
+				}
+			}
+
+			for (j = 0; j < rows; j++)
+			{
+				for (i = 0; i < cols; i++)
+				{
+					float	qx[4] = {gx[j][i], gx[j][i+1], gx[j+1][i+1], gx[j+1][i]};
+					float	qy[4] = {gy[j][i], gy[j][i+1], gy[j+1][i+1], gy[j+1][i]};
+					unsigned int	k;
+
+					if (!triangles)
+					{
+						for (k = 0; k < 4; k++) {polys[polyCount][k].x = qx[k]; polys[polyCount][k].y = qy[k];}
+						counts[polyCount++] = 4;
+						continue;
+					}
+
+					// Split along either diagonal
+
+					unsigned int	d = randomInt(2);
+					const	unsigned int	split[2][2][3] = {{{0, 1, 2}, {0, 2, 3}}, {{0, 1, 3}, {1, 2, 3}}};
+
+					for (unsigned int t = 0; t < 2; t++)
+					{
+						for (k = 0; k < 3; k++)
+						{
+							polys[polyCount][k].x = qx[split[d][t][k]];
+							polys[polyCount][k].y = qy[split[d][t][k]];
+						}
+						counts[polyCount++] = 3;
+					}
+				}
+			}
+
+			const	float	box[4][3] = {{1, 0, -x0}, {-1, 0, x1}, {0, 1, -y0}, {0, -1, y1}};
+			for (edgeCount = 0; edgeCount < 4; edgeCount++)
+			{
+				edges[edgeCount][0] = box[edgeCount][0];
+				edges[edgeCount][1] = box[edgeCount][1];
+				edges[edgeCount][2] = box[edgeCount][2];
+			}
+		}
+
+		for (i = 0; i < polyCount; i++) finishPolygon(polys[i], counts[i]);
+
+		// Each mapper (and the 16-bit mapper) draws the whole shape
+
+		for (unsigned int m = 0; m <= mapperCount; m++)
+		{
+			#ifdef USE_AFFINE
+			if (m == mapperCount) break;
+			#endif
+
+			const	char	*name = m < mapperCount ? mappers[m].name : "16-bit";
+			bool		failed = false;
+
+			fillBuffer(buffer, pixels, 0);
+			memset(buffer16, 0, pixels * sizeof(unsigned short));
+
+			for (i = 0; i < polyCount; i++)
+			{
+				sVERT	copy[4];
+
+				for (j = 0; j < counts[i]; j++)
+				{
+					copy[j] = polys[i][j];
+					copy[j].next = j + 1 < counts[i] ? &copy[j + 1] : NULL;
+				}
+
+				#ifndef USE_AFFINE
+				if (m == mapperCount)
+				{
+					bindTexture(&tex565);
+					drawSubPerspectiveTexturedPolygon16(copy, buffer16, verifyPitch);
+					bindTexture(NULL);
+					continue;
+				}
+				#endif
+
+				mappers[m].draw(copy, buffer, verifyPitch);
+			}
+
+			for (unsigned int p = 0; p < pixels && !failed; p++)
+			{
+				unsigned int	drawn = m < mapperCount ? buffer[p] : buffer16[p];
+				float		px = (float) (p % verifyPitch), py = (float) (p / verifyPitch);
+
+				// How far inside the outline is the pixel?
+
+				float	inside = 1e30f;
+
+				for (j = 0; j < edgeCount; j++)
+				{
+					float	d = edges[j][0] * px + edges[j][1] * py + edges[j][2];
+					if (d < inside) inside = d;
+				}
+
+				if (drawn > 1 || (!drawn && inside > 1.0f))
+				{
+					failed = true;
+					if (report(check))
+					{
+						printf("  overlap: %s: (%.0f, %.0f) was drawn %u times (shape %u, seed %u, a %s of %u polygons)\n",
+							name, px, py, drawn, shape, seed, shape & 1 ? "fan" : "grid", polyCount);
+					}
+				}
+			}
+
+			check.tested += polyCount;
+		}
+	}
+
+	#ifndef USE_AFFINE
+	destroyTexture(tex565);
+	#endif
+
+	delete[] buffer;
+	delete[] buffer16;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Bvh: every node's box holds its children (or its items), every item is in exactly one leaf, and culling finds exactly the boxes
+// that testing each one against the planes would.  Then some of the items are moved (refit) and it's all checked again.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	bool	bvhBoxOutside(const sBVHBOX &box, const sBVHPLANE &plane)
+{
+	// Every corner, summed in the same order Bvh does, so they round the same way
+
+	for (unsigned int corner = 0; corner < 8; corner++)
+	{
+		float	d = plane.distance;
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			d += plane.normal[axis] * ((corner >> axis) & 1 ? box.maximum[axis] : box.minimum[axis]);
+		}
+
+		if (d >= 0) return false;
+	}
+
+	return true;
+}
+
+static	bool	bvhBoxHolds(const sBVHBOX &outer, const sBVHBOX &inner)
+{
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		if (inner.minimum[axis] < outer.minimum[axis] || inner.maximum[axis] > outer.maximum[axis]) return false;
+	}
+
+	return true;
+}
+
+static	void	randomBox(sBVHBOX &box)
+{
+	for (unsigned int axis = 0; axis < 3; axis++)
+	{
+		float	center = randomFloat(-100.0f, 100.0f);
+		float	size = randomInt(8) ? randomFloat(0, 10.0f) : 0;
+		box.minimum[axis] = center - size;
+		box.maximum[axis] = center + size;
+	}
+}
+
+static	void	verifyBvh(sVERIFYCHECK &check, const unsigned int trees)
+{
+	const	unsigned int	maxItems = 500;
+	const	unsigned int	maxPlanes = 6;
+	sBVHBOX			*boxes = new sBVHBOX[maxItems];
+	unsigned int		*visible = new unsigned int[maxItems];
+	unsigned int		*seen = new unsigned int[maxItems];
+
+	for (unsigned int tree = 0; tree < trees; tree++)
+	{
+		unsigned int	count = 1 + randomInt(maxItems);
+		unsigned int	leafItems = 1 + randomInt(8);
+		unsigned int	i;
+
+		for (i = 0; i < count; i++) randomBox(boxes[i]);
+
+		Bvh	bvh;
+		bvh.build(boxes, count, leafItems);
+
+		for (unsigned int pass = 0; pass < 2; pass++)
+		{
+			// The tree's shape
+
+			memset(seen, 0, count * sizeof(unsigned int));
+			bool	broken = false;
+
+			for (unsigned int n = 0; n < bvh.nodeCount() && !broken; n++)
+			{
+				const	sBVHNODE	&node = bvh.node(n);
+
+				if (node.count)
+				{
+					for (i = node.first; i < node.first + node.count; i++)
+					{
+						seen[bvh.item(i)]++;
+						if (!bvhBoxHolds(node.box, bvh.itemBox(bvh.item(i)))) broken = true;
+					}
+				}
+				else
+				{
+					const	sBVHNODE	&left = bvh.node(node.first);
+					const	sBVHNODE	&right = bvh.node(node.first + 1);
+
+					if (!bvhBoxHolds(node.box, left.box) || !bvhBoxHolds(node.box, right.box)) broken = true;
+					if (left.parent != n || right.parent != n) broken = true;
+				}
+			}
+
+			for (i = 0; i < count; i++) if (seen[i] != 1) broken = true;
+
+			if (broken && report(check))
+			{
+				printf("  bvh (tree %u, pass %u): %u items, %u per leaf: a node doesn't hold what's under it, or an item isn't in "
+					"exactly one leaf\n", tree, pass, count, leafItems);
+			}
+
+			// Culling against random planes (facing anywhere, through the middle of the boxes or near it)
+
+			for (unsigned int trial = 0; trial < 8; trial++)
+			{
+				sBVHPLANE	planes[maxPlanes];
+				unsigned int	planeCount = 1 + randomInt(maxPlanes);
+				unsigned int	p;
+
+				for (p = 0; p < planeCount; p++)
+				{
+					for (unsigned int axis = 0; axis < 3; axis++) planes[p].normal[axis] = randomFloat(-1.0f, 1.0f);
+					planes[p].distance = randomFloat(-50.0f, 100.0f);
+				}
+
+				unsigned int	found = bvh.cull(planes, planeCount, visible);
+				memset(seen, 0, count * sizeof(unsigned int));
+				for (i = 0; i < found; i++) seen[visible[i]]++;
+
+				for (i = 0; i < count; i++)
+				{
+					bool	outside = false;
+					for (p = 0; p < planeCount && !outside; p++) outside = bvhBoxOutside(bvh.itemBox(i), planes[p]);
+
+					if (seen[i] != (outside ? 0u : 1u))
+					{
+						if (report(check))
+						{
+							printf("  bvh (tree %u, pass %u): %u items, %u per leaf, %u planes: item %u found %u times, "
+								"should be %u\n", tree, pass, count, leafItems, planeCount, i, seen[i], outside ? 0 : 1);
+						}
+						break;
+					}
+				}
+
+				check.tested++;
+			}
+
+			// Move some of the items
+
+			for (i = 0; i < count / 4 + 1; i++)
+			{
+				sBVHBOX	box;
+				randomBox(box);
+				bvh.refit(randomInt(count), box);
+			}
+		}
+	}
+
+	delete[] boxes;
+	delete[] visible;
+	delete[] seen;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+int	main(int argc, char *argv[])
+{
+	if (!AfxWinInit(::GetModuleHandle(NULL), NULL, ::GetCommandLine(), 0)) return 1;
+
+	unsigned int	polygons = argc > 1 ? atoi(argv[1]) : 2000;
+	unsigned int	seed = argc > 2 ? atoi(argv[2]) : 1;
+	unsigned int	tolerance = argc > 3 ? atoi(argv[3]) : 1;
+
+	if (!polygons) polygons = 1;
+
+	printf("Verify: %u polygons, seed %u, tolerance %u texel%s\n", polygons, seed, tolerance, tolerance == 1 ? "" : "s");
+	printf("mappers:");
+	for (unsigned int m = 0; m < mapperCount; m++) printf(" %s%s", mappers[m].name, m ? "" : " (reference)");
+	printf("\n\n");
+
+	drawTexture();
+	randomState = seed;
+
+	sVERIFYCHECK	blend = {"blend", 0, 0};
+	sVERIFYCHECK	clear = {"clear", 0, 0};
+	sVERIFYCHECK	bounds = {"bounds", 0, 0};
+	sVERIFYCHECK	coverage = {"coverage", 0, 0};
+	sVERIFYCHECK	texels = {"texels", 0, 0};
+	sVERIFYCHECK	formats = {"formats", 0, 0};
+	sVERIFYCHECK	clip = {"clip", 0, 0};
+	sVERIFYCHECK	overlap = {"overlap", 0, 0};
+	sVERIFYCHECK	bvh = {"bvh", 0, 0};
+	unsigned int	maxError = 0, pixelsOff = 0;
+
+	verifyBlend(blend, polygons);
+	verifyClear(clear, polygons);
+	verifyPolygons(bounds, coverage, texels, formats, polygons, seed, tolerance, maxError, pixelsOff);
+	verifyClip(clip, polygons / 4 + 1, seed, tolerance);
+	verifyOverlap(overlap, polygons / 20 + 2, seed);
+	verifyBvh(bvh, polygons / 20 + 2);
+
+	summary(blend, "pixels");
+	summary(clear, "clears");
+	summary(bounds, "polygons");
+
+	#ifndef USE_AFFINE
+	summary(coverage, "pixels");
+	char	extra[128];
+	sprintf(extra, "(worst error %u texel%s, %u pixels off at all)", maxError, maxError == 1 ? "" : "s", pixelsOff);
+	summary(texels, "pixels", extra);
+	summary(formats, "pixels");
+	#endif
+
+	summary(clip, "polygons");
+	summary(overlap, "polygons");
+	summary(bvh, "culls");
+
+	int	failed = (blend.failed != 0) + (clear.failed != 0) + (bounds.failed != 0) + (coverage.failed != 0) + (texels.failed != 0) +
+			 (formats.failed != 0) + (clip.failed != 0) + (overlap.failed != 0) + (bvh.failed != 0);
+
+	printf("\n%s\n", failed ? "FAILED" : "passed");
+	return failed;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Verify.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
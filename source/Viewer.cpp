@@ -1,67 +1,67 @@
-// ---------------------------------------------------------------------------------------------------------------------------------
-//  _     _ _                                              
-// | |   | (_)                                             
-// | |   | |_  _____      __ ___ _ __      ___ _ __  _ __  
-//  \ \ / /| |/ _ \ \ /\ / // _ \ '__|    / __| '_ \| '_ \ 
-//   \ V / | |  __/\ V  V /|  __/ |    _ | (__| |_) | |_) |
-//    \_/  |_|\___| \_/\_/  \___|_|   (_) \___| .__/| .__/ 
-//                                            | |   | |    
-//                                            |_|   |_|    
-//
-// Best viewed with 8-character tabs and (at least) 132 columns
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-//
-// Originally released under a custom license.
-// This historical re-release is provided under the MIT License.
-// See the LICENSE file in the repo root for details.
-//
-// https://github.com/nettlep
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Originally created on 12/22/2000 by Paul Nettle
-//
-// Copyright 2000, Fluid Studios, Inc., all rights reserved.
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-#include "stdafx.h"
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-#ifdef _DEBUG
-#define new DEBUG_NEW
-#undef THIS_FILE
-static char THIS_FILE[] = __FILE__;
-#endif
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-CViewerApp theApp;
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-BEGIN_MESSAGE_MAP(CViewerApp, CWinApp)
-	//{{AFX_MSG_MAP(CViewerApp)
-	//}}AFX_MSG
-	ON_COMMAND(ID_HELP, CWinApp::OnHelp)
-END_MESSAGE_MAP()
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-	CViewerApp::CViewerApp()
-{
-}
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-BOOL	CViewerApp::InitInstance()
-{
-	Enable3dControlsStatic();
-	CViewerDlg dlg;
-	dlg.DoModal();
-	return FALSE;
-}
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Viewer.cpp - End of file
-// ---------------------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _     _ _                                              
+// | |   | (_)                                             
+// | |   | |_  _____      __ ___ _ __      ___ _ __  _ __  
+//  \ \ / /| |/ _ \ \ /\ / // _ \ '__|    / __| '_ \| '_ \ 
+//   \ V / | |  __/\ V  V /|  __/ |    _ | (__| |_) | |_) |
+//    \_/  |_|\___| \_/\_/  \___|_|   (_) \___| .__/| .__/ 
+//                                            | |   | |    
+//                                            |_|   |_|    
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Originally created on 12/22/2000 by Paul Nettle
+//
+// Copyright 2000, Fluid Studios, Inc., all rights reserved.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+CViewerApp theApp;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+BEGIN_MESSAGE_MAP(CViewerApp, CWinApp)
+	//{{AFX_MSG_MAP(CViewerApp)
+	//}}AFX_MSG
+	ON_COMMAND(ID_HELP, CWinApp::OnHelp)
+END_MESSAGE_MAP()
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+	CViewerApp::CViewerApp()
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+BOOL	CViewerApp::InitInstance()
+{
+	Enable3dControlsStatic();
+	CViewerDlg dlg;
+	dlg.DoModal();
+	return FALSE;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Viewer.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
@@ -1,169 +1,353 @@
-# Microsoft Developer Studio Project File - Name="Viewer" - Package Owner=<4>
-# Microsoft Developer Studio Generated Build File, Format Version 6.00
-# ** DO NOT EDIT **
-
-# TARGTYPE "Win32 (x86) Application" 0x0101
-
-CFG=Viewer - Win32 Debug
-!MESSAGE This is not a valid makefile. To build this project using NMAKE,
-!MESSAGE use the Export Makefile command and run
-!MESSAGE 
-!MESSAGE NMAKE /f "Viewer.mak".
-!MESSAGE 
-!MESSAGE You can specify a configuration when running NMAKE
-!MESSAGE by defining the macro CFG on the command line. For example:
-!MESSAGE 
-!MESSAGE NMAKE /f "Viewer.mak" CFG="Viewer - Win32 Debug"
-!MESSAGE 
-!MESSAGE Possible choices for configuration are:
-!MESSAGE 
-!MESSAGE "Viewer - Win32 Release" (based on "Win32 (x86) Application")
-!MESSAGE "Viewer - Win32 Debug" (based on "Win32 (x86) Application")
-!MESSAGE 
-
-# Begin Project
-# PROP AllowPerConfigDependencies 0
-# PROP Scc_ProjName ""
-# PROP Scc_LocalPath ""
-CPP=cl.exe
-MTL=midl.exe
-RSC=rc.exe
-
-!IF  "$(CFG)" == "Viewer - Win32 Release"
-
-# PROP BASE Use_MFC 5
-# PROP BASE Use_Debug_Libraries 0
-# PROP BASE Output_Dir "Release"
-# PROP BASE Intermediate_Dir "Release"
-# PROP BASE Target_Dir ""
-# PROP Use_MFC 5
-# PROP Use_Debug_Libraries 0
-# PROP Output_Dir "Release"
-# PROP Intermediate_Dir "Release"
-# PROP Ignore_Export_Lib 0
-# PROP Target_Dir ""
-# ADD BASE CPP /nologo /MT /W3 /GX /O2 /D "WIN32" /D "NDEBUG" /D "_WINDOWS" /Yu"stdafx.h" /FD /c
-# ADD CPP /nologo /MT /W3 /GX /O2 /D "WIN32" /D "NDEBUG" /D "_WINDOWS" /D "_MBCS" /Yu"stdafx.h" /FD /c
-# ADD BASE MTL /nologo /D "NDEBUG" /mktyplib203 /win32
-# ADD MTL /nologo /D "NDEBUG" /mktyplib203 /win32
-# ADD BASE RSC /l 0x409 /d "NDEBUG"
-# ADD RSC /l 0x409 /d "NDEBUG"
-BSC32=bscmake.exe
-# ADD BASE BSC32 /nologo
-# ADD BSC32 /nologo
-LINK32=link.exe
-# ADD BASE LINK32 /nologo /subsystem:windows /machine:I386
-# ADD LINK32 /nologo /subsystem:windows /machine:I386 /nodefaultlib:"libc.lib" /OPT:NOREF
-# SUBTRACT LINK32 /pdb:none
-
-!ELSEIF  "$(CFG)" == "Viewer - Win32 Debug"
-
-# PROP BASE Use_MFC 5
-# PROP BASE Use_Debug_Libraries 1
-# PROP BASE Output_Dir "Debug"
-# PROP BASE Intermediate_Dir "Debug"
-# PROP BASE Target_Dir ""
-# PROP Use_MFC 5
-# PROP Use_Debug_Libraries 1
-# PROP Output_Dir "Debug"
-# PROP Intermediate_Dir "Debug"
-# PROP Ignore_Export_Lib 0
-# PROP Target_Dir ""
-# ADD BASE CPP /nologo /MTd /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_WINDOWS" /Yu"stdafx.h" /FD /GZ /c
-# ADD CPP /nologo /MTd /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_WINDOWS" /D "_MBCS" /Yu"stdafx.h" /FD /GZ /c
-# ADD BASE MTL /nologo /D "_DEBUG" /mktyplib203 /win32
-# ADD MTL /nologo /D "_DEBUG" /mktyplib203 /win32
-# ADD BASE RSC /l 0x409 /d "_DEBUG"
-# ADD RSC /l 0x409 /d "_DEBUG"
-BSC32=bscmake.exe
-# ADD BASE BSC32 /nologo
-# ADD BSC32 /nologo
-LINK32=link.exe
-# ADD BASE LINK32 /nologo /subsystem:windows /debug /machine:I386 /pdbtype:sept
-# ADD LINK32 /nologo /subsystem:windows /debug /machine:I386 /nodefaultlib:"libcd.lib" /pdbtype:sept
-
-!ENDIF 
-
-# Begin Target
-
-# Name "Viewer - Win32 Release"
-# Name "Viewer - Win32 Debug"
-# Begin Group "Source Files"
-
-# PROP Default_Filter "cpp;c;cxx;rc;def;r;odl;idl;hpj;bat"
-# Begin Source File
-
-SOURCE=.\Render.cpp
-# End Source File
-# Begin Source File
-
-SOURCE=.\StdAfx.cpp
-# ADD CPP /Yc"stdafx.h"
-# End Source File
-# Begin Source File
-
-SOURCE=.\TMap.cpp
-# End Source File
-# Begin Source File
-
-SOURCE=.\Viewer.cpp
-# End Source File
-# Begin Source File
-
-SOURCE=.\Viewer.rc
-# End Source File
-# Begin Source File
-
-SOURCE=.\ViewerDlg.cpp
-# End Source File
-# Begin Source File
-
-SOURCE=.\winDIB.cpp
-# End Source File
-# End Group
-# Begin Group "Header Files"
-
-# PROP Default_Filter "h;hpp;hxx;hm;inl"
-# Begin Source File
-
-SOURCE=.\Render.h
-# End Source File
-# Begin Source File
-
-SOURCE=.\Resource.h
-# End Source File
-# Begin Source File
-
-SOURCE=.\StdAfx.h
-# End Source File
-# Begin Source File
-
-SOURCE=.\TMap.h
-# End Source File
-# Begin Source File
-
-SOURCE=.\Viewer.h
-# End Source File
-# Begin Source File
-
-SOURCE=.\ViewerDlg.h
-# End Source File
-# Begin Source File
-
-SOURCE=.\winDIB.h
-# End Source File
-# End Group
-# Begin Group "Resource Files"
-
-# PROP Default_Filter "ico;cur;bmp;dlg;rc2;rct;bin;rgs;gif;jpg;jpeg;jpe"
-# Begin Source File
-
-SOURCE=.\res\Viewer.ico
-# End Source File
-# Begin Source File
-
-SOURCE=.\res\Viewer.rc2
-# End Source File
-# End Group
-# End Target
-# End Project
+# Microsoft Developer Studio Project File - Name="Viewer" - Package Owner=<4>
+# Microsoft Developer Studio Generated Build File, Format Version 6.00
+# ** DO NOT EDIT **
+
+# TARGTYPE "Win32 (x86) Application" 0x0101
+
+CFG=Viewer - Win32 Debug
+!MESSAGE This is not a valid makefile. To build this project using NMAKE,
+!MESSAGE use the Export Makefile command and run
+!MESSAGE 
+!MESSAGE NMAKE /f "Viewer.mak".
+!MESSAGE 
+!MESSAGE You can specify a configuration when running NMAKE
+!MESSAGE by defining the macro CFG on the command line. For example:
+!MESSAGE 
+!MESSAGE NMAKE /f "Viewer.mak" CFG="Viewer - Win32 Debug"
+!MESSAGE 
+!MESSAGE Possible choices for configuration are:
+!MESSAGE 
+!MESSAGE "Viewer - Win32 Release" (based on "Win32 (x86) Application")
+!MESSAGE "Viewer - Win32 Debug" (based on "Win32 (x86) Application")
+!MESSAGE 
+
+# Begin Project
+# PROP AllowPerConfigDependencies 0
+# PROP Scc_ProjName ""
+# PROP Scc_LocalPath ""
+CPP=cl.exe
+MTL=midl.exe
+RSC=rc.exe
+
+!IF  "$(CFG)" == "Viewer - Win32 Release"
+
+# PROP BASE Use_MFC 5
+# PROP BASE Use_Debug_Libraries 0
+# PROP BASE Output_Dir "Release"
+# PROP BASE Intermediate_Dir "Release"
+# PROP BASE Target_Dir ""
+# PROP Use_MFC 5
+# PROP Use_Debug_Libraries 0
+# PROP Output_Dir "Release"
+# PROP Intermediate_Dir "Release"
+# PROP Ignore_Export_Lib 0
+# PROP Target_Dir ""
+# ADD BASE CPP /nologo /MT /W3 /GX /O2 /D "WIN32" /D "NDEBUG" /D "_WINDOWS" /Yu"stdafx.h" /FD /c
+# ADD CPP /nologo /MT /W3 /GX /O2 /D "WIN32" /D "NDEBUG" /D "_WINDOWS" /D "_MBCS" /Yu"stdafx.h" /FD /c
+# ADD BASE MTL /nologo /D "NDEBUG" /mktyplib203 /win32
+# ADD MTL /nologo /D "NDEBUG" /mktyplib203 /win32
+# ADD BASE RSC /l 0x409 /d "NDEBUG"
+# ADD RSC /l 0x409 /d "NDEBUG"
+BSC32=bscmake.exe
+# ADD BASE BSC32 /nologo
+# ADD BSC32 /nologo
+LINK32=link.exe
+# ADD BASE LINK32 /nologo /subsystem:windows /machine:I386
+# ADD LINK32 winmm.lib /nologo /subsystem:windows /machine:I386 /nodefaultlib:"libc.lib" /OPT:NOREF
+# SUBTRACT LINK32 /pdb:none
+
+!ELSEIF  "$(CFG)" == "Viewer - Win32 Debug"
+
+# PROP BASE Use_MFC 5
+# PROP BASE Use_Debug_Libraries 1
+# PROP BASE Output_Dir "Debug"
+# PROP BASE Intermediate_Dir "Debug"
+# PROP BASE Target_Dir ""
+# PROP Use_MFC 5
+# PROP Use_Debug_Libraries 1
+# PROP Output_Dir "Debug"
+# PROP Intermediate_Dir "Debug"
+# PROP Ignore_Export_Lib 0
+# PROP Target_Dir ""
+# ADD BASE CPP /nologo /MTd /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_WINDOWS" /Yu"stdafx.h" /FD /GZ /c
+# ADD CPP /nologo /MTd /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_WINDOWS" /D "_MBCS" /Yu"stdafx.h" /FD /GZ /c
+# ADD BASE MTL /nologo /D "_DEBUG" /mktyplib203 /win32
+# ADD MTL /nologo /D "_DEBUG" /mktyplib203 /win32
+# ADD BASE RSC /l 0x409 /d "_DEBUG"
+# ADD RSC /l 0x409 /d "_DEBUG"
+BSC32=bscmake.exe
+# ADD BASE BSC32 /nologo
+# ADD BSC32 /nologo
+LINK32=link.exe
+# ADD BASE LINK32 /nologo /subsystem:windows /debug /machine:I386 /pdbtype:sept
+# ADD LINK32 winmm.lib /nologo /subsystem:windows /debug /machine:I386 /nodefaultlib:"libcd.lib" /pdbtype:sept
+
+!ENDIF 
+
+# Begin Target
+
+# Name "Viewer - Win32 Release"
+# Name "Viewer - Win32 Debug"
+# Begin Group "Source Files"
+
+# PROP Default_Filter "cpp;c;cxx;rc;def;r;odl;idl;hpj;bat"
+# Begin Source File
+
+SOURCE=.\Blend.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\BufferPool.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Bvh.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Clear.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Convert.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\DirtyRects.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\DynamicResolution.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\FrameCapture.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\FrameExport.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\FrameLoop.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Hud.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Mesh.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\MeshScene.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\PolyStream.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Presenter.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Profile.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Render.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\RenderTarget.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Scale.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Scene.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\StdAfx.cpp
+# ADD CPP /Yc"stdafx.h"
+# End Source File
+# Begin Source File
+
+SOURCE=.\SwapChain.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Texture.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\TMap.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Trace.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Viewer.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\Viewer.rc
+# End Source File
+# Begin Source File
+
+SOURCE=.\ViewerDlg.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\VirtualTexture.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\winDIB.cpp
+# End Source File
+# End Group
+# Begin Group "Header Files"
+
+# PROP Default_Filter "h;hpp;hxx;hm;inl"
+# Begin Source File
+
+SOURCE=.\Blend.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\BufferPool.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Bvh.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Clear.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Convert.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\DirtyRects.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\DynamicResolution.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\FrameCapture.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\FrameExport.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\FrameLoop.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Hud.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Mesh.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\MeshScene.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\PolyStream.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Presenter.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Profile.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Render.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\RenderTarget.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Resource.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Scale.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Scene.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\StdAfx.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\SwapChain.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Texture.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\TMap.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Trace.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\Viewer.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\ViewerDlg.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\VirtualTexture.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\winDIB.h
+# End Source File
+# End Group
+# Begin Group "Resource Files"
+
+# PROP Default_Filter "ico;cur;bmp;dlg;rc2;rct;bin;rgs;gif;jpg;jpeg;jpe"
+# Begin Source File
+
+SOURCE=.\res\Viewer.ico
+# End Source File
+# Begin Source File
+
+SOURCE=.\res\Viewer.rc2
+# End Source File
+# End Group
+# End Target
+# End Project
@@ -1,56 +1,56 @@
-// ---------------------------------------------------------------------------------------------------------------------------------
-//  _     _ _                             _     
-// | |   | (_)                           | |    
-// | |   | |_  _____      __ ___ _ __    | |__  
-//  \ \ / /| |/ _ \ \ /\ / // _ \ '__|   | '_ \ 
-//   \ V / | |  __/\ V  V /|  __/ |    _ | | | |
-//    \_/  |_|\___| \_/\_/  \___|_|   (_)|_| |_|
-//                                              
-//                                              
-//
-// Best viewed with 8-character tabs and (at least) 132 columns
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-//
-// Originally released under a custom license.
-// This historical re-release is provided under the MIT License.
-// See the LICENSE file in the repo root for details.
-//
-// https://github.com/nettlep
-//
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Originally created on 12/22/2000 by Paul Nettle
-//
-// Copyright 2000, Fluid Studios, Inc., all rights reserved.
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-#ifndef	_H_VIEWER
-#define _H_VIEWER
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-class	CViewerApp : public CWinApp
-{
-public:
-		CViewerApp();
-
-	//{{AFX_VIRTUAL(CViewerApp)
-	public:
-	virtual BOOL InitInstance();
-	//}}AFX_VIRTUAL
-
-	//{{AFX_MSG(CViewerApp)
-	//}}AFX_MSG
-	DECLARE_MESSAGE_MAP()
-};
-
-// ---------------------------------------------------------------------------------------------------------------------------------
-
-extern	CViewerApp theApp;
-
-//{{AFX_INSERT_LOCATION}}
-
-#endif
-// ---------------------------------------------------------------------------------------------------------------------------------
-// Viewer.h - End of file
-// ---------------------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _     _ _                             _     
+// | |   | (_)                           | |    
+// | |   | |_  _____      __ ___ _ __    | |__  
+//  \ \ / /| |/ _ \ \ /\ / // _ \ '__|   | '_ \ 
+//   \ V / | |  __/\ V  V /|  __/ |    _ | | | |
+//    \_/  |_|\___| \_/\_/  \___|_|   (_)|_| |_|
+//                                              
+//                                              
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Originally created on 12/22/2000 by Paul Nettle
+//
+// Copyright 2000, Fluid Studios, Inc., all rights reserved.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_VIEWER
+#define _H_VIEWER
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	CViewerApp : public CWinApp
+{
+public:
+		CViewerApp();
+
+	//{{AFX_VIRTUAL(CViewerApp)
+	public:
+	virtual BOOL InitInstance();
+	//}}AFX_VIRTUAL
+
+	//{{AFX_MSG(CViewerApp)
+	//}}AFX_MSG
+	DECLARE_MESSAGE_MAP()
+};
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+extern	CViewerApp theApp;
+
+//{{AFX_INSERT_LOCATION}}
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Viewer.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
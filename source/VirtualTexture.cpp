@@ -0,0 +1,434 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _     _ _      _               _ _______         _                                       
+// | |   | (_)    | |             | |__   __|       | |                                      
+// | |   | |_ _ __| |_ _   _  __ _| |  | |  _____  _| |_ _   _ _ __ ___      ___ _ __  _ __  
+//  \ \ / /| | '__| __| | | |/ _` | |  | | / _ \ \/ / __| | | | '__/ _ \    / __| '_ \| '_ \ 
+//   \ V / | | |  | |_| |_| | (_| | |  | ||  __/>  <| |_| |_| | | |  __/ _ | (__| |_) | |_) |
+//    \_/  |_|_|   \__|\__,_|\__,_|_|  |_| \___/_/\_\\__|\__,_|_|  \___|(_) \___| .__/| .__/ 
+//                                                                              | |   | |    
+//                                                                              |_|   |_|    
+//
+// Virtual textures (paged from disk through a resident page cache)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// NOTES:
+//
+// A virtual texture is far too large to keep in memory (a 32k x 32k texture is 4GB), so it lives on disk as a set of square pages.
+// The mapper looks every texel up through a page table, and the first time a page is touched in a frame, it is stamped with the
+// frame number.  Any touched page that is not resident is queued, and the queue is serviced by update() after the frame is drawn.
+//
+// Until a page arrives, its page table entry points at the fallback mip (a small, always-resident, reduced copy of the whole
+// texture) so the mapper never waits on the disk.  The result is a blurry patch for a frame or two, rather than a stall.
+//
+// The cache is a fixed pool of page slots.  When it is full, the least-recently-used page (the one with the oldest frame stamp) is
+// evicted.  Pages used in the current frame are never evicted; if every slot is in use, loading simply stops for that frame.
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifdef _DEBUG
+#undef THIS_FILE
+static char THIS_FILE[]=__FILE__;
+#define new DEBUG_NEW
+#endif
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Constants
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	const	unsigned int	vtMagic = 0x58455456;		// 'VTEX'
+static	const	unsigned int	vtVersion = 2;
+static	const	unsigned int	vtMaxFallback = 1024;		// Largest fallback mip dimension
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns log2(n) for powers of two, or -1 if 'n' is not a power of two
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	int	log2i(unsigned int n)
+{
+	if (!n || (n & (n - 1))) return -1;
+	int	result = 0;
+	while(n >>= 1) result++;
+	return result;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The procedural texture used by build() -- the same checkerboard as drawTexture(), stretched over the whole virtual texture
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+static	unsigned int	proceduralTexel(const unsigned int x, const unsigned int y, const unsigned int width, const unsigned int height)
+{
+	const unsigned int	cellShift = log2i(width) - 4;
+	unsigned int		c = 0xff000000 | (((x << 8) / width) << 16) | (((y << 8) / height) << 8) | 0x40;
+	return (((x >> cellShift) ^ (y >> cellShift)) & 1) ? c:0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		VirtualTexture::VirtualTexture()
+		:_file(INVALID_HANDLE_VALUE), _mapping(NULL), _fallbackView(NULL), _fallback(NULL), _granularity(0),
+		_pages(NULL), _pagesWideShift(0), _pageMask(0), _uMask(0), _vMask(0),
+		_cache(NULL), _slotPage(NULL), _cacheCount(0), _residentCount(0),
+		_requests(NULL), _requestCount(0), _frame(1)
+{
+	memset(&_header, 0, sizeof(_header));
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+		VirtualTexture::~VirtualTexture()
+{
+	close();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		VirtualTexture::open(const char *filename, const unsigned int cachePages)
+{
+	close();
+
+	if (!cachePages) return false;
+
+	// Open the file & map it
+
+	_file = CreateFile(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (_file == INVALID_HANDLE_VALUE) return false;
+
+	_mapping = CreateFileMapping(_file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!_mapping)
+	{
+		close();
+		return false;
+	}
+
+	SYSTEM_INFO	si;
+	GetSystemInfo(&si);
+	_granularity = si.dwAllocationGranularity;
+
+	// The header & fallback mip stay mapped for the life of the texture
+
+	_fallbackView = MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0x10000 > _granularity ? 0x10000 : _granularity);
+	if (!_fallbackView)
+	{
+		close();
+		return false;
+	}
+
+	memcpy(&_header, _fallbackView, sizeof(_header));
+
+	int	wShift = log2i(_header.width);
+	int	hShift = log2i(_header.height);
+
+	if (_header.magic != vtMagic || _header.version != vtVersion || wShift < 0 || hShift < 0 ||
+	    _header.pageShift > (unsigned int) wShift || _header.pageShift > (unsigned int) hShift ||
+	    _header.fallbackShift > _header.pageShift || _header.pageOffset % _granularity)
+	{
+		close();
+		return false;
+	}
+
+	// Remap the full header+fallback area now that we know how big it is
+
+	UnmapViewOfFile(_fallbackView);
+	_fallbackView = MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, _header.pageOffset);
+	if (!_fallbackView)
+	{
+		close();
+		return false;
+	}
+
+	_fallback = (unsigned int *) ((unsigned char *) _fallbackView + sizeof(sVTHEADER));
+
+	// Page table
+
+	_pagesWideShift = wShift - _header.pageShift;
+	_pageMask = (1 << _header.pageShift) - 1;
+	_uMask = _header.width - 1;
+	_vMask = _header.height - 1;
+
+	unsigned int	pageCount = (_header.width >> _header.pageShift) * (_header.height >> _header.pageShift);
+	_pages = new sVTPAGE[pageCount];
+	_requests = new unsigned int[pageCount];
+	_requestCount = 0;
+
+	for (unsigned int i = 0; i < pageCount; i++)
+	{
+		_pages[i].lastUsed = 0;
+		_pages[i].slot = -1;
+		setFallback(i);
+	}
+
+	// The cache
+
+	_cacheCount = cachePages < pageCount ? cachePages:pageCount;
+	_cache = new unsigned int[_cacheCount << (_header.pageShift * 2)];
+	_slotPage = new int[_cacheCount];
+	for (unsigned int j = 0; j < _cacheCount; j++) _slotPage[j] = -1;
+	_residentCount = 0;
+	_frame = 1;
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		VirtualTexture::close()
+{
+	delete[] _pages;
+	_pages = NULL;
+	delete[] _requests;
+	_requests = NULL;
+	_requestCount = 0;
+	delete[] _cache;
+	_cache = NULL;
+	delete[] _slotPage;
+	_slotPage = NULL;
+	_cacheCount = 0;
+	_residentCount = 0;
+
+	if (_fallbackView) UnmapViewOfFile(_fallbackView);
+	_fallbackView = NULL;
+	_fallback = NULL;
+
+	if (_mapping) CloseHandle(_mapping);
+	_mapping = NULL;
+
+	if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+	_file = INVALID_HANDLE_VALUE;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Services the pages requested during the frame, then advances the frame counter.  Call once per frame, after drawing.  Returns the
+// number of pages loaded.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+unsigned int	VirtualTexture::update(const unsigned int maxLoads)
+{
+	unsigned int	loaded = 0;
+
+	for (unsigned int i = 0; i < _requestCount && loaded < maxLoads; i++)
+	{
+		// It may have been loaded on behalf of an earlier request
+
+		if (_pages[_requests[i]].slot >= 0) continue;
+
+		// Find a home for it (bail if the cache is full of pages we're still using)
+
+		int	slot = findSlot();
+		if (slot < 0) break;
+
+		if (!loadPage(_requests[i], slot)) break;
+		loaded++;
+	}
+
+	// Anything we didn't get to will be requested again the next time it is touched
+
+	_requestCount = 0;
+	_frame++;
+
+	return loaded;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// First touch of a page this frame.  Stamp it, and queue it if it isn't resident.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		VirtualTexture::touch(sVTPAGE &page)
+{
+	page.lastUsed = _frame;
+	if (page.slot < 0) _requests[_requestCount++] = &page - _pages;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Points a page table entry at its region of the fallback mip
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+void		VirtualTexture::setFallback(const unsigned int index)
+{
+	sVTPAGE		&p = _pages[index];
+	unsigned int	px = (index & ((1 << _pagesWideShift) - 1)) << _header.pageShift;
+	unsigned int	py = (index >> _pagesWideShift) << _header.pageShift;
+	unsigned int	pitchShift = log2i(_header.width) - _header.fallbackShift;
+
+	p.texels = &_fallback[((py >> _header.fallbackShift) << pitchShift) + (px >> _header.fallbackShift)];
+	p.shift = _header.fallbackShift;
+	p.pitchShift = pitchShift;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Returns a free cache slot, evicting the least-recently-used page if there isn't one.  Returns -1 if every slot holds a page
+// that was used this frame.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+int		VirtualTexture::findSlot()
+{
+	if (_residentCount < _cacheCount)
+	{
+		for (unsigned int i = 0; i < _cacheCount; i++)
+		{
+			if (_slotPage[i] < 0) return i;
+		}
+	}
+
+	int		oldest = -1;
+	unsigned int	oldestFrame = _frame;
+
+	for (unsigned int i = 0; i < _cacheCount; i++)
+	{
+		unsigned int	used = _pages[_slotPage[i]].lastUsed;
+		if (used < oldestFrame)
+		{
+			oldest = i;
+			oldestFrame = used;
+		}
+	}
+
+	// Evict
+
+	if (oldest >= 0)
+	{
+		int	victim = _slotPage[oldest];
+		_pages[victim].slot = -1;
+		setFallback(victim);
+		_slotPage[oldest] = -1;
+		_residentCount--;
+	}
+
+	return oldest;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Copies a page from the file into a cache slot and points its page table entry at it
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		VirtualTexture::loadPage(const unsigned int index, const int slot)
+{
+	unsigned int	pageBytes = sizeof(unsigned int) << (_header.pageShift * 2);
+	DWORDLONG	offset = (DWORDLONG) _header.pageOffset + (DWORDLONG) index * pageBytes;
+
+	// Views must start on an allocation-granularity boundary
+
+	DWORDLONG	base = offset - offset % _granularity;
+	unsigned int	delta = (unsigned int) (offset - base);
+
+	void	*view = MapViewOfFile(_mapping, FILE_MAP_READ, (DWORD) (base >> 32), (DWORD) base, delta + pageBytes);
+	if (!view) return false;
+
+	unsigned int	*dst = &_cache[slot << (_header.pageShift * 2)];
+	memcpy(dst, (unsigned char *) view + delta, pageBytes);
+	UnmapViewOfFile(view);
+
+	sVTPAGE	&p = _pages[index];
+	p.texels = dst;
+	p.shift = 0;
+	p.pitchShift = _header.pageShift;
+	p.slot = slot;
+	_slotPage[slot] = index;
+	_residentCount++;
+
+	return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// Writes a procedural virtual texture file.  Width & height must be powers of two, and at least one page in size.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+bool		VirtualTexture::build(const char *filename, const unsigned int width, const unsigned int height, const unsigned int pageShift)
+{
+	int	wShift = log2i(width);
+	int	hShift = log2i(height);
+	if (wShift < 0 || hShift < 0 || (unsigned int) wShift < pageShift || (unsigned int) hShift < pageShift) return false;
+
+	// Pick a fallback mip small enough to keep resident
+
+	unsigned int	fallbackShift = 0;
+	while(fallbackShift < pageShift && ((width > height ? width:height) >> fallbackShift) > vtMaxFallback) fallbackShift++;
+
+	unsigned int	fw = width >> fallbackShift;
+	unsigned int	fh = height >> fallbackShift;
+
+	// Header
+
+	SYSTEM_INFO	si;
+	GetSystemInfo(&si);
+
+	sVTHEADER	header;
+	memset(&header, 0, sizeof(header));
+	header.magic = vtMagic;
+	header.version = vtVersion;
+	header.width = width;
+	header.height = height;
+	header.pageShift = pageShift;
+	header.fallbackShift = fallbackShift;
+	header.pageOffset = sizeof(header) + fw * fh * sizeof(unsigned int);
+	header.pageOffset = (header.pageOffset + si.dwAllocationGranularity - 1) / si.dwAllocationGranularity * si.dwAllocationGranularity;
+
+	HANDLE	file = CreateFile(filename, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	// The header & fallback mip (point-sampled from the center of each fallback texel) share one buffer, padded out to the pages
+
+	unsigned char	*head = new unsigned char[header.pageOffset];
+	memset(head, 0, header.pageOffset);
+	memcpy(head, &header, sizeof(header));
+
+	unsigned int	*fb = (unsigned int *) (head + sizeof(header));
+	unsigned int	half = (1 << fallbackShift) >> 1;
+	for (unsigned int y = 0; y < fh; y++)
+	{
+		for (unsigned int x = 0; x < fw; x++)
+		{
+			*(fb++) = proceduralTexel((x << fallbackShift) + half, (y << fallbackShift) + half, width, height);
+		}
+	}
+
+	DWORD	written;
+	bool	ok = WriteFile(file, head, header.pageOffset, &written, NULL) && written == header.pageOffset;
+	delete[] head;
+
+	// The pages
+
+	unsigned int	pageSize = 1 << pageShift;
+	unsigned int	*page = new unsigned int[pageSize * pageSize];
+
+	for (unsigned int py = 0; ok && py < height; py += pageSize)
+	{
+		for (unsigned int px = 0; ok && px < width; px += pageSize)
+		{
+			unsigned int	*dst = page;
+			for (unsigned int y = 0; y < pageSize; y++)
+			{
+				for (unsigned int x = 0; x < pageSize; x++)
+				{
+					*(dst++) = proceduralTexel(px + x, py + y, width, height);
+				}
+			}
+
+			DWORD	bytes = pageSize * pageSize * sizeof(unsigned int);
+			ok = WriteFile(file, page, bytes, &written, NULL) && written == bytes;
+		}
+	}
+
+	delete[] page;
+	CloseHandle(file);
+
+	return ok;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// VirtualTexture.cpp - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------
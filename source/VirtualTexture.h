@@ -0,0 +1,130 @@
+// ---------------------------------------------------------------------------------------------------------------------------------
+//  _     _ _      _               _ _______         _                      _     
+// | |   | (_)    | |             | |__   __|       | |                    | |    
+// | |   | |_ _ __| |_ _   _  __ _| |  | |  _____  _| |_ _   _ _ __ ___    | |__  
+//  \ \ / /| | '__| __| | | |/ _` | |  | | / _ \ \/ / __| | | | '__/ _ \   | '_ \ 
+//   \ V / | | |  | |_| |_| | (_| | |  | ||  __/>  <| |_| |_| | | |  __/ _ | | | |
+//    \_/  |_|_|   \__|\__,_|\__,_|_|  |_| \___/_/\_\\__|\__,_|_|  \___|(_)|_| |_|
+//                                                                                
+//                                                                                
+//
+// Virtual textures (paged from disk through a resident page cache)
+//
+// Best viewed with 8-character tabs and (at least) 132 columns
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+//
+// Originally released under a custom license.
+// This historical re-release is provided under the MIT License.
+// See the LICENSE file in the repo root for details.
+//
+// https://github.com/nettlep
+//
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+#ifndef	_H_VIRTUALTEXTURE
+#define	_H_VIRTUALTEXTURE
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// The file header.  A virtual texture file is laid out as:
+//
+//   [header] [fallback mip] [padding up to pageOffset] [page 0] [page 1] ... [page N-1]
+//
+// Pages are stored in row-major order, each one a contiguous square of (1 << pageShift) texels on a side.  The page area starts on
+// an allocation-granularity boundary so that every page can be mapped with its own view.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	vtheader
+{
+	unsigned int	magic;			// 'VTEX'
+	unsigned int	version;
+	unsigned int	width, height;		// Full texture resolution (powers of two)
+	unsigned int	pageShift;		// log2 of the page edge length
+	unsigned int	fallbackShift;		// log2 of the fallback mip's reduction factor
+	unsigned int	pageOffset;		// File offset of the first page
+	unsigned int	reserved;
+} sVTHEADER;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+// A page table entry.  Resident pages point into the cache; everything else points at its own corner of the fallback mip, with
+// 'shift' set so that the same lookup math works for both.
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+typedef	struct	vtpage
+{
+	unsigned int	*texels;		// Resident page, or this page's region of the fallback mip
+	unsigned int	shift;			// Texel coordinate shift (0 when resident)
+	unsigned int	pitchShift;		// log2 of the row pitch of 'texels'
+	unsigned int	lastUsed;		// Frame number this page was last touched
+	int		slot;			// Cache slot, or -1 if not resident
+} sVTPAGE;
+
+// ---------------------------------------------------------------------------------------------------------------------------------
+
+class	VirtualTexture
+{
+public:
+	// Construction/Destruction
+
+				VirtualTexture();
+virtual				~VirtualTexture();
+
+	// Accessors
+
+inline	const	unsigned int	&width() const {return _header.width;}
+inline	const	unsigned int	&height() const {return _header.height;}
+inline	const	unsigned int	&frame() const {return _frame;}
+inline	const	unsigned int	&residentPages() const {return _residentCount;}
+inline	const	unsigned int	&cachePages() const {return _cacheCount;}
+inline	const	bool		isOpen() const {return _pages != NULL;}
+
+	// Texel lookup (u & v are integer texel coordinates, wrapped to the texture)
+
+inline		unsigned int	fetch(unsigned int u, unsigned int v)
+				{
+					u &= _uMask;
+					v &= _vMask;
+					sVTPAGE	&p = _pages[((v >> _header.pageShift) << _pagesWideShift) + (u >> _header.pageShift)];
+					if (p.lastUsed != _frame) touch(p);
+					return p.texels[(((v & _pageMask) >> p.shift) << p.pitchShift) + ((u & _pageMask) >> p.shift)];
+				}
+
+	// Utilitarian
+
+virtual		bool		open(const char *filename, const unsigned int cachePages = 256);
+virtual		void		close();
+virtual		unsigned int	update(const unsigned int maxLoads = 16);
+static		bool		build(const char *filename, const unsigned int width, const unsigned int height, const unsigned int pageShift = 7);
+
+private:
+virtual		void		touch(sVTPAGE &page);
+virtual		void		setFallback(const unsigned int index);
+virtual		int		findSlot();
+virtual		bool		loadPage(const unsigned int index, const int slot);
+
+		sVTHEADER	_header;
+		HANDLE		_file;
+		HANDLE		_mapping;
+		void		*_fallbackView;
+		unsigned int	*_fallback;
+		unsigned int	_granularity;
+
+		sVTPAGE		*_pages;
+		unsigned int	_pagesWideShift;
+		unsigned int	_pageMask;
+		unsigned int	_uMask, _vMask;
+
+		unsigned int	*_cache;
+		int		*_slotPage;
+		unsigned int	_cacheCount;
+		unsigned int	_residentCount;
+
+		unsigned int	*_requests;
+		unsigned int	_requestCount;
+		unsigned int	_frame;
+};
+
+#endif
+// ---------------------------------------------------------------------------------------------------------------------------------
+// VirtualTexture.h - End of file
+// ---------------------------------------------------------------------------------------------------------------------------------